@@ -35,6 +35,12 @@
 #include "Common/Logging/Log.h"
 
 // Wrapper class
+//
+// Reading or writing past the end of the buffer switches to measure mode instead of stopping, so
+// the pointer still ends up advanced by the full size of the data. Callers that save repeatedly
+// (see State::SaveStateToBuffer) use this to write straight into a buffer sized after the
+// previous save, and only need a second pass in the rare case that it turned out too small. That
+// makes a separate measure pass, or caching the size of each section to skip it, unnecessary.
 class PointerWrap
 {
 public:
@@ -73,12 +79,13 @@ public:
     switch (m_mode)
     {
     case Mode::Read:
+      // Elements were saved in order, so each one goes at the end
       for (x.clear(); count != 0; --count)
       {
         std::pair<K, V> pair;
         Do(pair.first);
         Do(pair.second);
-        x.insert(pair);
+        x.insert(x.end(), std::move(pair));
       }
       break;
 
@@ -107,7 +114,7 @@ public:
       {
         V value = {};
         Do(value);
-        x.insert(value);
+        x.insert(x.end(), std::move(value));
       }
       break;
 
@@ -326,6 +333,9 @@ public:
   }
 
 private:
+  // Containers of trivially copyable elements are copied with a single memcpy, like arrays. Maps,
+  // sets, lists and deques go element by element. In a typical state, those only account for a
+  // small fraction of the time spent in DoState, which is dominated by emulated memory.
   template <typename T>
   void DoContiguousContainer(T& container)
   {
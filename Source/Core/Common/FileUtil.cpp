@@ -378,6 +378,15 @@ u64 GetSize(FILE* f)
   return size;
 }
 
+std::optional<s64> GetLastWriteTime(const std::string& path)
+{
+  std::error_code error;
+  const auto time = std::filesystem::last_write_time(StringToPath(path), error);
+  if (error)
+    return std::nullopt;
+  return static_cast<s64>(time.time_since_epoch().count());
+}
+
 // creates an empty file filename, returns true on success
 bool CreateEmptyFile(const std::string& filename)
 {
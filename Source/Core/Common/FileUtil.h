@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <filesystem>
 #include <fstream>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -151,6 +152,10 @@ u64 GetSize(const std::string& path);
 // Overloaded GetSize, accepts FILE*
 u64 GetSize(FILE* f);
 
+// Returns the last write time of a file or directory in an unspecified but consistent epoch, or
+// std::nullopt if the path can't be queried. Only meant to be compared against earlier results.
+std::optional<s64> GetLastWriteTime(const std::string& path);
+
 // Creates a single directory. Returns true if successful or if the path already exists.
 bool CreateDir(const std::string& filename);
 
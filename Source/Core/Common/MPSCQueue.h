@@ -0,0 +1,87 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// a lock-free thread-safe,
+// multiple producer, single consumer queue
+//
+// Producers push onto an atomic singly linked list. The consumer takes the whole list at once and
+// reverses it, so elements are consumed in the order they were pushed. Since the consumer never
+// removes single nodes, there is no ABA problem.
+
+#include <atomic>
+#include <utility>
+
+namespace Common
+{
+template <typename T>
+class MPSCQueue
+{
+public:
+  MPSCQueue() = default;
+  MPSCQueue(const MPSCQueue&) = delete;
+  MPSCQueue& operator=(const MPSCQueue&) = delete;
+  ~MPSCQueue() { Clear(); }
+
+  template <typename Arg>
+  void Push(Arg&& t)
+  {
+    Node* node = new Node{std::forward<Arg>(t), m_head.load(std::memory_order_relaxed)};
+    while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                         std::memory_order_relaxed))
+    {
+    }
+  }
+
+  // Only a hint when called from a producer
+  bool Empty() const { return m_head.load(std::memory_order_relaxed) == nullptr; }
+
+  // Calls func for every element in the queue, in the order they were pushed, and removes them.
+  // Elements that get pushed while this is running are left for the next call.
+  // Must only be called from the consumer thread.
+  template <typename Func>
+  void PopAll(Func func)
+  {
+    if (Empty())
+      return;
+
+    Node* node = Reverse(m_head.exchange(nullptr, std::memory_order_acquire));
+    while (node)
+    {
+      Node* next = node->next;
+      func(std::move(node->value));
+      delete node;
+      node = next;
+    }
+  }
+
+  // Must only be called from the consumer thread
+  void Clear()
+  {
+    PopAll([](T&&) {});
+  }
+
+private:
+  struct Node
+  {
+    T value;
+    Node* next;
+  };
+
+  static Node* Reverse(Node* node)
+  {
+    Node* reversed = nullptr;
+    while (node)
+    {
+      Node* next = node->next;
+      node->next = reversed;
+      reversed = node;
+      node = next;
+    }
+    return reversed;
+  }
+
+  std::atomic<Node*> m_head = nullptr;
+};
+}  // namespace Common
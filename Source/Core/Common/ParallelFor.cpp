@@ -0,0 +1,150 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/ParallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/Event.h"
+#include "Common/Thread.h"
+
+namespace Common
+{
+namespace
+{
+class WorkerPool final
+{
+public:
+  explicit WorkerPool(size_t num_threads)
+  {
+    for (size_t i = 0; i < num_threads; ++i)
+      m_threads.emplace_back(&WorkerPool::WorkerThread, this);
+  }
+
+  ~WorkerPool()
+  {
+    {
+      std::lock_guard lk(m_mutex);
+      m_exit = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& thread : m_threads)
+      thread.join();
+  }
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  static WorkerPool& GetInstance()
+  {
+    // The calling thread takes part in the work too
+    static WorkerPool s_instance(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+    return s_instance;
+  }
+
+  size_t GetThreadCount() const { return m_threads.size(); }
+
+  void Run(size_t count, const std::function<void(size_t)>& func)
+  {
+    auto batch = std::make_shared<Batch>(func, count);
+    {
+      std::lock_guard lk(m_mutex);
+      m_batches.push_back(batch);
+    }
+    if (count > 1)
+      m_wake.notify_all();
+
+    RunBatch(batch.get());
+    RemoveBatch(batch);
+    batch->done.Wait();
+  }
+
+private:
+  struct Batch
+  {
+    Batch(const std::function<void(size_t)>& func_, size_t count_) : func(func_), count(count_) {}
+
+    // Only called for indices below count, which all finish before the caller of Run returns
+    const std::function<void(size_t)>& func;
+    const size_t count;
+    std::atomic<size_t> next_index = 0;
+    std::atomic<size_t> num_done = 0;
+    Event done;
+  };
+
+  static void RunBatch(Batch* batch)
+  {
+    for (size_t i = batch->next_index++; i < batch->count; i = batch->next_index++)
+    {
+      batch->func(i);
+      if (++batch->num_done == batch->count)
+        batch->done.Set();
+    }
+  }
+
+  void RemoveBatch(const std::shared_ptr<Batch>& batch)
+  {
+    std::lock_guard lk(m_mutex);
+    const auto it = std::ranges::find(m_batches, batch);
+    if (it != m_batches.end())
+      m_batches.erase(it);
+  }
+
+  void WorkerThread()
+  {
+    SetCurrentThreadName("Worker Pool");
+
+    std::unique_lock lk(m_mutex);
+    while (true)
+    {
+      m_wake.wait(lk, [this] { return m_exit || !m_batches.empty(); });
+      if (m_exit)
+        return;
+
+      // Keeps the batch alive until this thread is done looking at it, even if the caller has
+      // already returned
+      const std::shared_ptr<Batch> batch = m_batches.front();
+      lk.unlock();
+      RunBatch(batch.get());
+      lk.lock();
+
+      // Every index has been handed out, so nobody needs to find this batch anymore
+      if (!m_batches.empty() && m_batches.front() == batch)
+        m_batches.pop_front();
+    }
+  }
+
+  std::vector<std::thread> m_threads;
+  std::deque<std::shared_ptr<Batch>> m_batches;
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  bool m_exit = false;
+};
+}  // namespace
+
+void ParallelFor(size_t count, const std::function<void(size_t)>& func)
+{
+  if (count == 0)
+    return;
+
+  if (count == 1)
+  {
+    func(0);
+    return;
+  }
+
+  WorkerPool::GetInstance().Run(count, func);
+}
+
+size_t GetParallelForThreadCount()
+{
+  return WorkerPool::GetInstance().GetThreadCount() + 1;
+}
+}  // namespace Common
@@ -0,0 +1,19 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace Common
+{
+// Calls func for every index in [0, count), spread over a pool of worker threads that is shared by
+// the whole process and kept alive between calls. The calling thread does part of the work, and
+// the function returns once func has returned for every index. Calls may be nested and may come
+// from several threads at once.
+void ParallelFor(size_t count, const std::function<void(size_t)>& func);
+
+// Returns how many threads ParallelFor spreads work over, including the calling thread.
+size_t GetParallelForThreadCount();
+}  // namespace Common
@@ -3,6 +3,8 @@
 
 #include "Common/Thread.h"
 
+#include <cstdio>
+
 #ifdef _WIN32
 #include <Windows.h>
 #include <processthreadsapi.h>
@@ -43,6 +45,58 @@ int CurrentThreadId()
 #endif
 }
 
+std::optional<SystemCPUTimes> GetSystemCPUTimes()
+{
+#ifdef _WIN32
+  FILETIME idle_time, kernel_time, user_time;
+  if (!GetSystemTimes(&idle_time, &kernel_time, &user_time))
+    return std::nullopt;
+
+  const auto to_u64 = [](const FILETIME& time) {
+    return (u64(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+  };
+  // The kernel time includes the idle time.
+  return SystemCPUTimes{to_u64(idle_time), to_u64(kernel_time) + to_u64(user_time)};
+#elif defined __APPLE__
+  static const mach_port_t host = mach_host_self();
+  host_cpu_load_info_data_t info;
+  mach_msg_type_number_t count = HOST_CPU_LOAD_INFO_COUNT;
+  if (host_statistics(host, HOST_CPU_LOAD_INFO, reinterpret_cast<host_info_t>(&info), &count) !=
+      KERN_SUCCESS)
+  {
+    return std::nullopt;
+  }
+
+  SystemCPUTimes times;
+  for (const natural_t ticks : info.cpu_ticks)
+    times.total += ticks;
+  times.idle = info.cpu_ticks[CPU_STATE_IDLE];
+  return times;
+#elif defined __linux__
+  // Not readable by apps on newer versions of Android.
+  std::FILE* file = std::fopen("/proc/stat", "r");
+  if (!file)
+    return std::nullopt;
+
+  // user, nice, system, idle, iowait, irq, softirq, steal
+  unsigned long long ticks[8]{};
+  const int fields_read =
+      std::fscanf(file, "cpu %llu %llu %llu %llu %llu %llu %llu %llu", &ticks[0], &ticks[1],
+                  &ticks[2], &ticks[3], &ticks[4], &ticks[5], &ticks[6], &ticks[7]);
+  std::fclose(file);
+  if (fields_read < 4)
+    return std::nullopt;
+
+  SystemCPUTimes times;
+  for (const unsigned long long value : ticks)
+    times.total += value;
+  times.idle = ticks[3] + ticks[4];
+  return times;
+#else
+  return std::nullopt;
+#endif
+}
+
 #ifdef _WIN32
 
 void SetThreadAffinity(std::thread::native_handle_type thread, u32 mask)
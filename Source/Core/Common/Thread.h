@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <optional>
 #include <thread>
 
 #ifndef _WIN32
@@ -39,6 +40,17 @@ inline void YieldCPU()
 
 void SetCurrentThreadName(const char* name);
 
+struct SystemCPUTimes
+{
+  u64 idle = 0;
+  u64 total = 0;
+};
+
+// Returns the time all cores of the host have spent idle, and in total, in unspecified units.
+// Only the ratio between the differences of two samples is meaningful. Returns std::nullopt if
+// the host doesn't provide this information.
+std::optional<SystemCPUTimes> GetSystemCPUTimes();
+
 #ifndef _WIN32
 // Returns the lowest address of the stack and the size of the stack
 std::tuple<void*, size_t> GetCurrentThreadStack();
@@ -151,6 +151,17 @@ extern const Info<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const Info<bool> MAIN_AUTO_DISC_CHANGE;
 extern const Info<bool> MAIN_ALLOW_SD_WRITES;
 extern const Info<bool> MAIN_ENABLE_SAVESTATES;
+extern const Info<bool> MAIN_REWIND_ENABLE;
+// Number of frames between two rewind points
+extern const Info<u32> MAIN_REWIND_INTERVAL;
+// In MiB
+extern const Info<u32> MAIN_REWIND_MEMORY_BUDGET;
+// Save states to slots as only the pages of emulated memory that changed since the last full state
+// saved to a slot, which must be kept to load them
+extern const Info<bool> MAIN_INCREMENTAL_SAVESTATES;
+// Compress savestates with zstd instead of LZ4, which is slower but compresses better
+extern const Info<bool> MAIN_SAVESTATE_ZSTD;
+extern const Info<int> MAIN_SAVESTATE_ZSTD_LEVEL;
 extern const Info<DiscIO::Region> MAIN_FALLBACK_REGION;
 extern const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS;
 extern const Info<s32> MAIN_OVERRIDE_BOOT_IOS;
@@ -317,6 +328,9 @@ extern const Info<bool> MAIN_MOVIE_DUMP_FRAMES_SILENT;
 extern const Info<bool> MAIN_MOVIE_SHOW_INPUT_DISPLAY;
 extern const Info<bool> MAIN_MOVIE_SHOW_RTC;
 extern const Info<bool> MAIN_MOVIE_SHOW_RERECORD;
+extern const Info<int> MAIN_MOVIE_RAM_HASH_INTERVAL;
+extern const Info<bool> MAIN_MOVIE_STOP_AT_END;
+extern const Info<int> MAIN_MOVIE_CHECKPOINT_INTERVAL;
 
 // Main.Input
 
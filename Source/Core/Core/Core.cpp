@@ -168,6 +168,8 @@ void FrameUpdateOnCPUThread()
 
 void OnFrameEnd(Core::System& system)
 {
+  ::State::OnFrameEnd(system);
+
 #ifdef USE_MEMORYWATCHER
   if (s_memory_watcher)
   {
@@ -4,9 +4,11 @@
 #include "Core/CoreTiming.h"
 
 #include <algorithm>
-#include <mutex>
+#include <iterator>
+#include <ranges>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -14,7 +16,7 @@
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
-#include "Common/SPSCQueue.h"
+#include "Common/MPSCQueue.h"
 
 #include "Core/AchievementManager.h"
 #include "Core/CPUThreadConfigCallback.h"
@@ -108,9 +110,9 @@ void CoreTimingManager::Init()
 
 void CoreTimingManager::Shutdown()
 {
-  std::lock_guard lk(m_ts_write_lock);
   MoveEvents();
   ClearPendingEvents();
+  m_after_advance.clear();
   UnregisterAllEvents();
   CPUThreadConfigCallback::RemoveConfigChangedCallback(m_registered_config_callback_id);
 }
@@ -142,7 +144,6 @@ void CoreTimingManager::RefreshConfig()
 
 void CoreTimingManager::DoState(PointerWrap& p)
 {
-  std::lock_guard lk(m_ts_write_lock);
   p.Do(m_globals.slice_length);
   p.Do(m_globals.global_timer);
   p.Do(m_idled_cycles);
@@ -193,9 +194,9 @@ void CoreTimingManager::DoState(PointerWrap& p)
   if (p.IsReadMode())
   {
     // When loading from a save state, we must assume the Event order is random and meaningless.
-    // The exact layout of the heap in memory is implementation defined, therefore it is platform
-    // and library version specific.
-    std::ranges::make_heap(m_event_queue, std::ranges::greater{});
+    // Older save states stored the queue as a heap, whose exact layout in memory is
+    // implementation defined.
+    std::ranges::sort(m_event_queue, std::ranges::greater{});
 
     // The stave state has changed the time, so our previous Throttle targets are invalid.
     // Especially when global_time goes down; So we create a fake throttle update.
@@ -252,8 +253,7 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
     if (!m_is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    m_event_queue.emplace_back(Event{timeout, m_event_fifo_id++, userdata, event_type});
-    std::ranges::push_heap(m_event_queue, std::ranges::greater{});
+    PushEvent(Event{timeout, m_event_fifo_id++, userdata, event_type});
   }
   else
   {
@@ -265,21 +265,22 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
                     *event_type->name);
     }
 
-    std::lock_guard lk(m_ts_write_lock);
     m_ts_queue.Push(Event{m_globals.global_timer + cycles_into_future, 0, userdata, event_type});
   }
 }
 
-void CoreTimingManager::RemoveEvent(EventType* event_type)
+void CoreTimingManager::PushEvent(const Event& event)
 {
-  const size_t erased =
-      std::erase_if(m_event_queue, [&](const Event& e) { return e.type == event_type; });
+  auto it = m_event_queue.end();
+  while (it != m_event_queue.begin() && *std::prev(it) < event)
+    --it;
+  m_event_queue.insert(it, event);
+}
 
-  // Removing random items breaks the invariant so we have to re-establish it.
-  if (erased != 0)
-  {
-    std::ranges::make_heap(m_event_queue, std::ranges::greater{});
-  }
+void CoreTimingManager::RemoveEvent(EventType* event_type)
+{
+  // Erasing keeps the remaining events sorted
+  std::erase_if(m_event_queue, [&](const Event& e) { return e.type == event_type; });
 }
 
 void CoreTimingManager::RemoveAllEvents(EventType* event_type)
@@ -303,12 +304,10 @@ void CoreTimingManager::ForceExceptionCheck(s64 cycles)
 
 void CoreTimingManager::MoveEvents()
 {
-  for (Event ev; m_ts_queue.Pop(ev);)
-  {
+  m_ts_queue.PopAll([this](Event ev) {
     ev.fifo_order = m_event_fifo_id++;
-    m_event_queue.emplace_back(std::move(ev));
-    std::ranges::push_heap(m_event_queue, std::ranges::greater{});
-  }
+    PushEvent(ev);
+  });
 }
 
 void CoreTimingManager::Advance()
@@ -328,10 +327,9 @@ void CoreTimingManager::Advance()
 
   m_is_global_timer_sane = true;
 
-  while (!m_event_queue.empty() && m_event_queue.front().time <= m_globals.global_timer)
+  while (!m_event_queue.empty() && m_event_queue.back().time <= m_globals.global_timer)
   {
-    Event evt = std::move(m_event_queue.front());
-    std::ranges::pop_heap(m_event_queue, std::ranges::greater{});
+    const Event evt = m_event_queue.back();
     m_event_queue.pop_back();
 
     Throttle(evt.time);
@@ -344,7 +342,7 @@ void CoreTimingManager::Advance()
   if (!m_event_queue.empty())
   {
     m_globals.slice_length = static_cast<int>(
-        std::min<s64>(m_event_queue.front().time - m_globals.global_timer, MAX_SLICE_LENGTH));
+        std::min<s64>(m_event_queue.back().time - m_globals.global_timer, MAX_SLICE_LENGTH));
   }
 
   ppc_state.downcount = CyclesToDowncount(m_globals.slice_length);
@@ -354,6 +352,17 @@ void CoreTimingManager::Advance()
   // until the next slice:
   //        Pokemon Box refuses to boot if the first exception from the audio DMA is received late
   power_pc.CheckExternalExceptions();
+
+  if (!m_after_advance.empty())
+  {
+    for (const std::function<void()>& function : std::exchange(m_after_advance, {}))
+      function();
+  }
+}
+
+void CoreTimingManager::RunAfterAdvance(std::function<void()> function)
+{
+  m_after_advance.push_back(std::move(function));
 }
 
 void CoreTimingManager::Throttle(const s64 target_cycle)
@@ -429,9 +438,7 @@ bool CoreTimingManager::UseSyncOnSkipIdle() const
 
 void CoreTimingManager::LogPendingEvents() const
 {
-  auto clone = m_event_queue;
-  std::ranges::sort(clone);
-  for (const Event& ev : clone)
+  for (const Event& ev : m_event_queue | std::views::reverse)
   {
     INFO_LOG_FMT(POWERPC, "PENDING: Now: {} Pending: {} Type: {}", m_globals.global_timer, ev.time,
                  *ev.type->name);
@@ -449,6 +456,10 @@ void CoreTimingManager::AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clo
     const s64 ticks = (ev.time - m_globals.global_timer) * new_ppc_clock / old_ppc_clock;
     ev.time = m_globals.global_timer + ticks;
   }
+
+  // Rounding can give events the same time that didn't have it before, in which case the order
+  // they were scheduled in decides which one comes first
+  std::ranges::sort(m_event_queue, std::ranges::greater{});
 }
 
 void CoreTimingManager::Idle()
@@ -472,9 +483,7 @@ std::string CoreTimingManager::GetScheduledEventsSummary() const
   std::string text = "Scheduled events\n";
   text.reserve(1000);
 
-  auto clone = m_event_queue;
-  std::ranges::sort(clone);
-  for (const Event& ev : clone)
+  for (const Event& ev : m_event_queue | std::views::reverse)
   {
     text += fmt::format("{} : {} {:016x}\n", *ev.type->name, ev.time, ev.userdata);
   }
@@ -17,14 +17,14 @@
 //   ScheduleEvent(periodInCycles - cyclesLate, callback, "whatever")
 
 #include <compare>
-#include <mutex>
+#include <functional>
 #include <string>
 #include <tuple>
 #include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
-#include "Common/SPSCQueue.h"
+#include "Common/MPSCQueue.h"
 #include "Core/CPUThreadConfigCallback.h"
 
 class PointerWrap;
@@ -129,6 +129,12 @@ public:
   void Advance();
   void MoveEvents();
 
+  // Runs the function at the end of the current or next Advance(), after the events that are due
+  // have run and the next slice has been set up. Unlike inside an event callback, the emulated
+  // system is in a consistent state there, so it can be saved. Must be called from the CPU thread.
+  // Functions that haven't run yet are dropped on shutdown.
+  void RunAfterAdvance(std::function<void()> function);
+
   // Pretend that the main CPU has executed enough cycles to reach the next event.
   void Idle();
 
@@ -175,14 +181,14 @@ private:
   std::unordered_map<std::string, EventType> m_event_types;
 
   // STATE_TO_SAVE
-  // The queue is a min-heap using std::ranges::make_heap/push_heap/pop_heap.
-  // We don't use std::priority_queue because we need to be able to serialize, unserialize and
-  // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accomodated
-  // by the standard adaptor class.
+  // The queue is sorted from the latest to the earliest event, so that the next event is at the
+  // back. Most events are scheduled for the near future, so inserting them only has to look at and
+  // move the few events that come before them, and popping the next event is O(1). The queue
+  // rarely holds more than a few dozen events, which makes this faster than a heap in practice.
   std::vector<Event> m_event_queue;
   u64 m_event_fifo_id = 0;
-  std::mutex m_ts_write_lock;
-  Common::SPSCQueue<Event, false> m_ts_queue;
+  // Events scheduled from other threads, which are moved to m_event_queue on the CPU thread
+  Common::MPSCQueue<Event> m_ts_queue;
 
   float m_last_oc_factor = 0.0f;
 
@@ -193,6 +199,8 @@ private:
   // Are we in a function that has been called from Advance()
   bool m_is_global_timer_sane = false;
 
+  std::vector<std::function<void()>> m_after_advance;
+
   EventType* m_ev_lost = nullptr;
 
   CPUThreadConfigCallback::ConfigChangedCallbackID m_registered_config_callback_id;
@@ -210,6 +218,7 @@ private:
   DT m_max_variance = {};
   double m_emulation_speed = 1.0;
 
+  void PushEvent(const Event& event);
   void ResetThrottle(s64 cycle);
 
   int DowncountToCycles(int downcount) const;
@@ -3,6 +3,7 @@
 
 #include "Core/HW/DVD/DVDThread.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -31,6 +32,7 @@
 #include "Core/IOS/ES/Formats.h"
 #include "Core/System.h"
 
+#include "DiscIO/Blob.h"
 #include "DiscIO/Enums.h"
 #include "DiscIO/Volume.h"
 
@@ -50,12 +52,14 @@ void DVDThread::Start()
   m_result_queue_expanded.Reset();
   m_request_queue.Clear();
   m_result_queue.Clear();
+  m_free_buffers.Clear();
 
   // This is reset on every launch for determinism, but it doesn't matter
   // much, because this will never get exposed to the emulated game.
   m_next_id = 0;
 
   StartDVDThread();
+  StartPrefetchThread();
 }
 
 void DVDThread::StartDVDThread()
@@ -68,7 +72,11 @@ void DVDThread::StartDVDThread()
 void DVDThread::Stop()
 {
   StopDVDThread();
+  StopPrefetchThread();
   m_disc.reset();
+
+  std::lock_guard lk(m_prefetch_disc_lock);
+  m_prefetch_disc.reset();
 }
 
 void DVDThread::StopDVDThread()
@@ -84,6 +92,26 @@ void DVDThread::StopDVDThread()
   m_dvd_thread.join();
 }
 
+void DVDThread::StartPrefetchThread()
+{
+  ASSERT(!m_prefetch_thread.joinable());
+  m_prefetch_thread_exiting.Clear();
+  m_prefetch_thread = std::thread(&DVDThread::PrefetchThreadMain, this);
+}
+
+void DVDThread::StopPrefetchThread()
+{
+  ASSERT(m_prefetch_thread.joinable());
+
+  m_prefetch_thread_exiting.Set();
+  m_prefetch_requested.Set();
+
+  m_prefetch_thread.join();
+
+  std::lock_guard lk(m_prefetch_request_lock);
+  m_prefetch_request.reset();
+}
+
 void DVDThread::DoState(PointerWrap& p)
 {
   // By waiting for the DVD thread to be done working, we ensure
@@ -132,6 +160,24 @@ void DVDThread::SetDisc(std::unique_ptr<DiscIO::Volume> disc)
 {
   WaitUntilIdle();
   m_disc = std::move(disc);
+
+  // Only formats that use DiscIO::ChunkCache benefit from prefetching
+  std::unique_ptr<DiscIO::Volume> prefetch_disc;
+  if (m_disc)
+  {
+    const DiscIO::BlobReader& blob_reader = m_disc->GetBlobReader();
+    const DiscIO::BlobType blob_type = blob_reader.GetBlobType();
+    if (blob_type == DiscIO::BlobType::WIA || blob_type == DiscIO::BlobType::RVZ)
+      prefetch_disc = DiscIO::CreateVolume(blob_reader.CopyReader());
+  }
+
+  {
+    std::lock_guard lk(m_prefetch_request_lock);
+    m_prefetch_request.reset();
+  }
+
+  std::lock_guard lk(m_prefetch_disc_lock);
+  m_prefetch_disc = std::move(prefetch_disc);
 }
 
 bool DVDThread::HasDisc() const
@@ -326,6 +372,9 @@ void DVDThread::FinishRead(u64 id, s64 cycles_late)
 
   // Notify the emulated software that the command has been executed
   dvd_interface.FinishExecutingCommand(request.reply_type, interrupt, cycles_late, buffer);
+
+  if (m_free_buffers.Size() < MAX_FREE_BUFFERS)
+    m_free_buffers.Push(std::move(result.second));
 }
 
 void DVDThread::DVDThreadMain()
@@ -344,12 +393,16 @@ void DVDThread::DVDThreadMain()
     {
       m_file_logger.Log(*m_disc, request.partition, request.dvd_offset);
 
-      std::vector<u8> buffer(request.length);
+      std::vector<u8> buffer;
+      m_free_buffers.Pop(buffer);
+      buffer.resize(request.length);
       if (!m_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
         buffer.resize(0);
 
       request.realtime_done_us = Common::Timer::NowUs();
 
+      UpdateReadAhead(request);
+
       m_result_queue.Push(ReadResult(std::move(request), std::move(buffer)));
       m_result_queue_expanded.Set();
 
@@ -358,4 +411,93 @@ void DVDThread::DVDThreadMain()
     }
   }
 }
+
+void DVDThread::UpdateReadAhead(const ReadRequest& request)
+{
+  const bool sequential = request.partition == m_last_read_partition &&
+                          request.dvd_offset >= m_last_read_end &&
+                          request.dvd_offset - m_last_read_end <= SEQUENTIAL_READ_MAX_GAP;
+
+  m_last_read_partition = request.partition;
+  m_last_read_end = request.dvd_offset + request.length;
+
+  if (!sequential)
+  {
+    m_sequential_reads = 0;
+    m_prefetched_until = 0;
+    return;
+  }
+
+  if (++m_sequential_reads < SEQUENTIAL_READS_BEFORE_PREFETCH)
+    return;
+
+  // Top up the window once half of it has been consumed
+  if (m_prefetched_until >= m_last_read_end + PREFETCH_WINDOW_SIZE / 2)
+    return;
+
+  const u64 prefetch_start = std::max(m_prefetched_until, m_last_read_end);
+  const u64 prefetch_end = m_last_read_end + PREFETCH_WINDOW_SIZE;
+  m_prefetched_until = prefetch_end;
+
+  {
+    std::lock_guard lk(m_prefetch_request_lock);
+
+    // If the previous request hasn't been started yet and we're continuing where it ends,
+    // extend it instead of replacing it, so that no gap is left behind
+    if (m_prefetch_request && m_prefetch_request->partition == request.partition &&
+        m_prefetch_request->offset + m_prefetch_request->length == prefetch_start)
+    {
+      m_prefetch_request->length = prefetch_end - m_prefetch_request->offset;
+    }
+    else
+    {
+      m_prefetch_request = PrefetchRequest{prefetch_start, prefetch_end - prefetch_start,
+                                           request.partition};
+    }
+  }
+
+  m_prefetch_requested.Set();
+}
+
+void DVDThread::PrefetchThreadMain()
+{
+  Common::SetCurrentThreadName("DVD prefetch thread");
+
+  std::vector<u8> buffer(PREFETCH_READ_SIZE);
+
+  while (true)
+  {
+    m_prefetch_requested.Wait();
+
+    while (true)
+    {
+      if (m_prefetch_thread_exiting.IsSet())
+        return;
+
+      std::optional<PrefetchRequest> request;
+      {
+        std::lock_guard lk(m_prefetch_request_lock);
+        request = std::exchange(m_prefetch_request, std::nullopt);
+      }
+      if (!request)
+        break;
+
+      u64 offset = request->offset;
+      const u64 end = request->offset + request->length;
+      while (offset < end && !m_prefetch_thread_exiting.IsSet())
+      {
+        const u64 size = std::min(end - offset, PREFETCH_READ_SIZE);
+
+        std::lock_guard lk(m_prefetch_disc_lock);
+        if (!m_prefetch_disc ||
+            !m_prefetch_disc->Read(offset, size, buffer.data(), request->partition))
+        {
+          break;
+        }
+
+        offset += size;
+      }
+    }
+  }
+}
 }  // namespace DVD
@@ -5,6 +5,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <thread>
 #include <utility>
@@ -126,6 +127,18 @@ private:
 
   using ReadResult = std::pair<ReadRequest, std::vector<u8>>;
 
+  struct PrefetchRequest
+  {
+    u64 offset = 0;
+    u64 length = 0;
+    DiscIO::Partition partition{};
+  };
+
+  void StartPrefetchThread();
+  void StopPrefetchThread();
+  void PrefetchThreadMain();
+  void UpdateReadAhead(const ReadRequest& request);
+
   CoreTiming::EventType* m_finish_read = nullptr;
 
   u64 m_next_id = 0;
@@ -139,8 +152,38 @@ private:
   Common::SPSCQueue<ReadResult, false> m_result_queue;
   std::map<u64, ReadResult> m_result_map;
 
+  // Buffers of finished reads are handed back to the DVD thread, so that it doesn't have to
+  // allocate (and fault in) a new buffer for every read
+  static constexpr u32 MAX_FREE_BUFFERS = 4;
+  Common::SPSCQueue<std::vector<u8>> m_free_buffers;  // Is pushed by CPU thread
+
   std::unique_ptr<DiscIO::Volume> m_disc;
 
+  // Read-ahead for compressed disc formats. When the DVD thread notices that the emulated
+  // software is reading sequentially, the prefetch thread reads ahead through its own copy of
+  // the disc. The data itself is thrown away; the point is to fill DiscIO::ChunkCache so that
+  // the DVD thread doesn't have to wait for decompression once it gets there.
+  static constexpr u32 SEQUENTIAL_READS_BEFORE_PREFETCH = 2;
+  static constexpr u64 SEQUENTIAL_READ_MAX_GAP = 0x10000;
+  static constexpr u64 PREFETCH_WINDOW_SIZE = 0x400000;
+  static constexpr u64 PREFETCH_READ_SIZE = 0x40000;
+
+  // Only used by the DVD thread
+  DiscIO::Partition m_last_read_partition{};
+  u64 m_last_read_end = 0;
+  u32 m_sequential_reads = 0;
+  u64 m_prefetched_until = 0;
+
+  std::thread m_prefetch_thread;
+  Common::Event m_prefetch_requested;
+  Common::Flag m_prefetch_thread_exiting = Common::Flag(false);
+
+  std::mutex m_prefetch_request_lock;
+  std::optional<PrefetchRequest> m_prefetch_request;
+
+  std::mutex m_prefetch_disc_lock;
+  std::unique_ptr<DiscIO::Volume> m_prefetch_disc;
+
   FileMonitor::FileLogger m_file_logger;
 
   Core::System& m_system;
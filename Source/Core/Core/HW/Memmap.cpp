@@ -14,6 +14,14 @@
 #include <memory>
 #include <span>
 #include <tuple>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include <xxhash.h>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -230,6 +238,23 @@ bool MemoryManager::InitFastmemArena()
 
   m_is_fastmem_arena_initialized = true;
   m_fastmem_arena_size = memory_size;
+
+#ifdef _WIN32
+  // Views of file mappings have to be aligned to the 64 KiB allocation granularity.
+  m_can_map_logical_pages = false;
+#else
+  // Pages that are translated through the page table are mapped one emulated page at a time, which
+  // needs host pages that are no larger. Hosts with 16 KiB pages, like macOS on Apple silicon, keep
+  // accessing such pages through MMU.cpp.
+  const long host_page_size = sysconf(_SC_PAGESIZE);
+  m_can_map_logical_pages = host_page_size <= static_cast<long>(PowerPC::HW_PAGE_SIZE);
+  if (!m_can_map_logical_pages)
+  {
+    INFO_LOG_FMT(MEMMAP, "Host page size is {} bytes, so page table mappings can't use fastmem.",
+                 host_page_size);
+  }
+#endif
+
   return true;
 }
 
@@ -290,6 +315,41 @@ void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
   }
 }
 
+bool MemoryManager::MapLogicalPage(u32 logical_address, u32 translated_address)
+{
+  if (!m_can_map_logical_pages)
+    return false;
+
+  for (const auto& physical_region : m_physical_regions)
+  {
+    if (!physical_region.active || translated_address < physical_region.physical_address ||
+        translated_address - physical_region.physical_address >= physical_region.size)
+    {
+      continue;
+    }
+
+    const u32 position =
+        physical_region.shm_position + translated_address - physical_region.physical_address;
+    u8* base = m_logical_base + logical_address;
+    if (m_arena.MapInMemoryRegion(position, PowerPC::HW_PAGE_SIZE, base) != base)
+    {
+      WARN_LOG_FMT(MEMMAP,
+                   "Failed to map page at 0x{:08X} into logical fastmem region at 0x{:08X}.",
+                   translated_address, logical_address);
+      return false;
+    }
+    return true;
+  }
+
+  return false;
+}
+
+void MemoryManager::UnmapLogicalPage(u32 logical_address)
+{
+  if (m_can_map_logical_pages)
+    m_arena.UnmapFromMemoryRegion(m_logical_base + logical_address, PowerPC::HW_PAGE_SIZE);
+}
+
 void MemoryManager::DoState(PointerWrap& p)
 {
   const u32 current_ram_size = GetRamSize();
@@ -328,6 +388,14 @@ void MemoryManager::DoState(PointerWrap& p)
     return;
   }
 
+  bool incremental = m_incremental_saving && HasDirtyPageBase();
+  p.Do(incremental);
+  if (incremental)
+  {
+    DoDirtyPagesState(p);
+    return;
+  }
+
   p.DoArray(m_ram, current_ram_size);
   p.DoArray(m_l1_cache, current_l1_cache_size);
   p.DoMarker("Memory RAM");
@@ -339,9 +407,97 @@ void MemoryManager::DoState(PointerWrap& p)
   p.DoMarker("Memory EXRAM");
 }
 
+void MemoryManager::DoDirtyPagesState(PointerWrap& p)
+{
+  std::vector<u32> pages;
+  if (p.IsMeasureMode())
+  {
+    m_measured_dirty_pages = GetDirtyPages();
+    pages = *m_measured_dirty_pages;
+  }
+  else if (p.IsWriteMode())
+  {
+    // Nothing can have changed since the measuring pass, so don't hash everything again
+    pages = m_measured_dirty_pages ? std::move(*m_measured_dirty_pages) : GetDirtyPages();
+    m_measured_dirty_pages.reset();
+  }
+
+  p.Do(pages);
+
+  for (const u32 page : pages)
+  {
+    u8* ptr = GetDirtyPagePointer(page);
+    if (!ptr)
+    {
+      Core::DisplayMessage("State contains an invalid memory page. Aborting load state.", 3000);
+      p.SetVerifyMode();
+      return;
+    }
+    p.DoArray(ptr, DIRTY_PAGE_SIZE);
+  }
+  p.DoMarker("Memory dirty pages");
+}
+
+std::array<std::span<u8>, 4> MemoryManager::GetStateRegions() const
+{
+  return {std::span<u8>(m_ram, m_ram ? GetRamSize() : 0),
+          std::span<u8>(m_l1_cache, m_l1_cache ? GetL1CacheSize() : 0),
+          std::span<u8>(m_fake_vmem, m_fake_vmem ? GetFakeVMemSize() : 0),
+          std::span<u8>(m_exram, m_exram ? GetExRamSize() : 0)};
+}
+
+u8* MemoryManager::GetDirtyPagePointer(u32 page) const
+{
+  size_t offset = static_cast<size_t>(page) * DIRTY_PAGE_SIZE;
+  for (const std::span<u8>& region : GetStateRegions())
+  {
+    if (offset < region.size())
+      return region.data() + offset;
+    offset -= region.size();
+  }
+  return nullptr;
+}
+
+void MemoryManager::SetDirtyPageBase()
+{
+  m_base_page_hashes.clear();
+  for (const std::span<u8>& region : GetStateRegions())
+  {
+    for (size_t offset = 0; offset < region.size(); offset += DIRTY_PAGE_SIZE)
+      m_base_page_hashes.push_back(XXH64(region.data() + offset, DIRTY_PAGE_SIZE, 0));
+  }
+}
+
+void MemoryManager::ClearDirtyPageBase()
+{
+  m_base_page_hashes = {};
+  m_measured_dirty_pages.reset();
+}
+
+std::vector<u32> MemoryManager::GetDirtyPages() const
+{
+  std::vector<u32> dirty_pages;
+
+  u32 page = 0;
+  for (const std::span<u8>& region : GetStateRegions())
+  {
+    for (size_t offset = 0; offset < region.size(); offset += DIRTY_PAGE_SIZE, ++page)
+    {
+      if (page >= m_base_page_hashes.size() ||
+          XXH64(region.data() + offset, DIRTY_PAGE_SIZE, 0) != m_base_page_hashes[page])
+      {
+        dirty_pages.push_back(page);
+      }
+    }
+  }
+
+  return dirty_pages;
+}
+
 void MemoryManager::Shutdown()
 {
   ShutdownFastmemArena();
+  ClearDirtyPageBase();
 
   m_is_initialized = false;
   for (const PhysicalMemoryRegion& region : m_physical_regions)
@@ -385,6 +541,7 @@ void MemoryManager::ShutdownFastmemArena()
   m_logical_base = nullptr;
 
   m_is_fastmem_arena_initialized = false;
+  m_can_map_logical_pages = false;
 }
 
 void MemoryManager::Clear()
@@ -5,6 +5,7 @@
 
 #include <array>
 #include <memory>
+#include <optional>
 #include <span>
 #include <string>
 #include <vector>
@@ -99,8 +100,33 @@ public:
   void ShutdownFastmemArena();
   void DoState(PointerWrap& p);
 
+  // Dirty page tracking for incremental savestates. SetDirtyPageBase stores a hash of each page of
+  // emulated memory, and GetDirtyPages returns the pages whose current hash differs from the stored
+  // one. Comparing contents instead of trapping writes catches writes from every source (JIT,
+  // interpreter, DMA, the GPU thread and HLE) and also works without fastmem.
+  static constexpr u32 DIRTY_PAGE_SIZE = 0x1000;
+  void SetDirtyPageBase();
+  void ClearDirtyPageBase();
+  bool HasDirtyPageBase() const { return !m_base_page_hashes.empty(); }
+  std::vector<u32> GetDirtyPages() const;
+
+  // While enabled, DoState only saves the pages that are dirty, if a base has been set. Such states
+  // must be loaded on top of the state that the base was set for.
+  void SetIncrementalSaving(bool incremental)
+  {
+    m_incremental_saving = incremental;
+    m_measured_dirty_pages.reset();
+  }
+
   void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
+  // Maps single pages that are translated through the page table rather than the BATs into the
+  // logical fastmem region. This is only possible if the fastmem arena is initialized and the host
+  // doesn't use pages larger than the emulated ones.
+  bool CanMapLogicalPages() const { return m_can_map_logical_pages; }
+  bool MapLogicalPage(u32 logical_address, u32 translated_address);
+  void UnmapLogicalPage(u32 logical_address);
+
   void Clear();
 
   // Routines to access physically addressed memory, designed for use by
@@ -195,6 +221,7 @@ private:
   u32 m_exram_mask = 0;
 
   bool m_is_fastmem_arena_initialized = false;
+  bool m_can_map_logical_pages = false;
 
   // STATE_TO_SAVE
   // Save the Init(), Shutdown() state
@@ -254,6 +281,18 @@ private:
 
   Core::System& m_system;
 
+  // Hashes of every page of the regions returned by GetStateRegions() at the time of the last
+  // SetDirtyPageBase() call
+  std::vector<u64> m_base_page_hashes;
+  bool m_incremental_saving = false;
+  // The dirty pages found while measuring an incremental state, reused when writing it
+  std::optional<std::vector<u32>> m_measured_dirty_pages;
+
   void InitMMIO(bool is_wii);
+
+  // The regions saved in states, in the order they are saved in. Inactive regions are empty.
+  std::array<std::span<u8>, 4> GetStateRegions() const;
+  u8* GetDirtyPagePointer(u32 page) const;
+  void DoDirtyPagesState(PointerWrap& p);
 };
 }  // namespace Memory
@@ -20,6 +20,7 @@
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
+#include <xxhash.h>
 
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
@@ -30,6 +31,7 @@
 #include "Common/IOFile.h"
 #include "Common/MsgHandler.h"
 #include "Common/NandPaths.h"
+#include "Common/Random.h"
 #include "Common/StringUtil.h"
 #include "Common/Timer.h"
 #include "Common/Version.h"
@@ -50,6 +52,7 @@
 #include "Core/HW/EXI/EXI.h"
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
 #include "Core/HW/EXI/EXI_DeviceMemoryCard.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/HW/SI/SI.h"
 #include "Core/HW/SI/SI_Device.h"
@@ -62,6 +65,7 @@
 #include "Core/HW/WiimoteEmu/Extension/Nunchuk.h"
 #include "Core/HW/WiimoteEmu/ExtensionPort.h"
 
+#include "Core/Host.h"
 #include "Core/IOS/USB/Bluetooth/BTEmu.h"
 #include "Core/IOS/USB/Bluetooth/WiimoteDevice.h"
 #include "Core/NetPlayProto.h"
@@ -89,6 +93,13 @@ static bool IsMovieHeader(const std::array<u8, 4>& magic)
   return magic[0] == 'D' && magic[1] == 'T' && magic[2] == 'M' && magic[3] == 0x1A;
 }
 
+// The RAM hashes are stored after the input data
+static u64 GetInputDataSize(const DTMHeader& header, u64 file_size)
+{
+  const u64 data_size = file_size - sizeof(DTMHeader);
+  return data_size - std::min<u64>(u64{header.ramHashCount} * sizeof(DTMRAMHash), data_size);
+}
+
 static std::array<u8, 20> ConvertGitRevisionToBytes(const std::string& revision)
 {
   std::array<u8, 20> revision_bytes{};
@@ -118,8 +129,26 @@ static std::array<u8, 20> ConvertGitRevisionToBytes(const std::string& revision)
   return revision_bytes;
 }
 
+static std::string GetRecordingCheckpointsPath()
+{
+  return File::GetUserPath(D_STATESAVES_IDX) + "dtm.idx";
+}
+
+static u64 GenerateMovieID()
+{
+  u64 movie_id = 0;
+  while (movie_id == 0)
+    movie_id = Common::Random::GenerateValue<u64>();
+  return movie_id;
+}
+
 MovieManager::MovieManager(Core::System& system) : m_system(system)
 {
+  m_checkpoint_saver.Reset(
+      "Movie Checkpoints", [this](const std::vector<u8>& state, u64 frame, u64 generation) {
+        if (generation == m_checkpoint_saver.GetGeneration())
+          m_checkpoints.Add(frame, state);
+      });
 }
 
 MovieManager::~MovieManager() = default;
@@ -194,8 +223,187 @@ void MovieManager::FrameUpdate()
     m_total_frames = m_current_frame;
     m_total_lag_count = m_current_lag_count;
   }
+  else if (IsPlayingInput())
+  {
+    m_playback_verification.frames_played = m_current_frame;
+  }
 
   m_polled = false;
+
+  UpdateRAMHashes();
+  UpdateCheckpoints();
+}
+
+// NOTE: CPU Thread
+void MovieManager::UpdateRAMHashes()
+{
+  if (IsRecordingInput())
+  {
+    const int interval = Config::Get(Config::MAIN_MOVIE_RAM_HASH_INTERVAL);
+    if (interval > 0 && m_current_frame % interval == 0)
+      m_ram_hashes.push_back({m_current_frame, HashRAM()});
+  }
+  else if (IsPlayingInput())
+  {
+    const auto it =
+        std::ranges::lower_bound(m_ram_hashes, m_current_frame, {}, &DTMRAMHash::frame);
+    if (it == m_ram_hashes.end() || it->frame != m_current_frame)
+      return;
+
+    ++m_playback_verification.checked_ram_hashes;
+    if (HashRAM() != it->hash && !m_playback_verification.first_mismatch_frame)
+    {
+      m_playback_verification.first_mismatch_frame = m_current_frame;
+      Core::DisplayMessage(
+          fmt::format("Desync detected: RAM doesn't match the recording on frame {}",
+                      m_current_frame),
+          5000);
+    }
+  }
+}
+
+u64 MovieManager::HashRAM() const
+{
+  auto& memory = m_system.GetMemory();
+  u64 hash = XXH64(memory.GetRAM(), memory.GetRamSizeReal(), 0);
+  if (m_system.IsWii())
+    hash = XXH64(memory.GetEXRAM(), memory.GetExRamSizeReal(), hash);
+  return hash;
+}
+
+void MovieManager::ReadRAMHashes(File::IOFile& file)
+{
+  m_ram_hashes.resize(m_temp_header.ramHashCount);
+  if (!file.ReadArray(m_ram_hashes.data(), m_ram_hashes.size()))
+    m_ram_hashes.clear();
+}
+
+const PlaybackVerification& MovieManager::GetPlaybackVerification() const
+{
+  return m_playback_verification;
+}
+
+// NOTE: CPU Thread
+void MovieManager::UpdateCheckpoints()
+{
+  if (m_seek_target_frame && m_current_frame >= *m_seek_target_frame)
+  {
+    StopSeeking();
+    m_system.GetCPU().Break();
+    Core::DisplayMessage(fmt::format("Reached frame {}", m_current_frame), 2000);
+  }
+
+  const int interval = Config::Get(Config::MAIN_MOVIE_CHECKPOINT_INTERVAL);
+  if (interval <= 0 || !IsMovieActive() || !m_checkpoints.IsOpen())
+    return;
+
+  // Frames that already have checkpoints were played or recorded with the same inputs before.
+  // If the previous checkpoint hasn't been written yet, this is tried again on the next frame.
+  if (m_current_frame >= m_checkpoints.GetLastFrame().value_or(0) + interval)
+    m_checkpoint_saver.Request(m_system);
+}
+
+// NOTE: Host / EmuThread / CPU Thread
+void MovieManager::CloseCheckpoints()
+{
+  m_checkpoint_saver.Invalidate();
+  m_checkpoint_saver.WaitForCompletion();
+  m_checkpoints.Close();
+}
+
+// Called when the frames after the current one are about to be recorded again. The checkpoints
+// up to the current frame still match the new recording, so they are kept.
+// NOTE: Host Thread / CPU Thread
+void MovieManager::DiscardCheckpointsAfterCurrentFrame()
+{
+  m_checkpoint_saver.Invalidate();
+  m_checkpoint_saver.WaitForCompletion();
+
+  const std::string recording_path = GetRecordingCheckpointsPath();
+  if (m_checkpoints.IsOpen() && m_checkpoints.GetPath() != recording_path)
+  {
+    // Don't modify the checkpoints of the movie that was being played back
+    const std::string playback_path = m_checkpoints.GetPath();
+    m_checkpoints.Close();
+    if (!File::CopyRegularFile(playback_path, recording_path) ||
+        !m_checkpoints.Open(recording_path, m_movie_id, true))
+    {
+      m_checkpoints.Create(recording_path, m_movie_id);
+    }
+  }
+  else if (!m_checkpoints.IsOpen() && Config::Get(Config::MAIN_MOVIE_CHECKPOINT_INTERVAL) > 0)
+  {
+    m_checkpoints.Create(recording_path, m_movie_id);
+  }
+
+  m_checkpoints.DiscardAfter(m_current_frame);
+}
+
+// NOTE: Host Thread / CPU Thread
+void MovieManager::StopSeeking()
+{
+  if (!m_seek_target_frame)
+    return;
+
+  m_seek_target_frame.reset();
+  Core::QueueHostJob([speed = m_speed_before_seek](Core::System&) {
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, speed);
+  });
+}
+
+// NOTE: Host Thread
+bool MovieManager::SeekToFrame(u64 frame)
+{
+  const Core::State core_state = Core::GetState(m_system);
+  if (!IsPlayingInput() ||
+      (core_state != Core::State::Running && core_state != Core::State::Paused))
+  {
+    return false;
+  }
+
+  if (frame > m_total_frames)
+  {
+    Core::DisplayMessage(fmt::format("The movie only has {} frames", m_total_frames), 3000);
+    return false;
+  }
+
+  bool seeking = false;
+  Core::RunOnCPUThread(
+      m_system,
+      [&] {
+        // Only load a checkpoint if that gets closer to the frame than playing on from here
+        const auto checkpoint = m_checkpoints.FindLatestAtOrBefore(frame);
+        if (checkpoint && (frame < m_current_frame || checkpoint->frame > m_current_frame))
+        {
+          std::vector<u8> state;
+          if (!m_checkpoints.Load(*checkpoint, &state) || !State::LoadFromBuffer(m_system, state))
+            Core::DisplayMessage("Failed to load the movie checkpoint", 3000);
+        }
+
+        if (frame < m_current_frame)
+        {
+          Core::DisplayMessage(fmt::format("No checkpoint before frame {}", frame), 3000);
+          return;
+        }
+
+        if (frame == m_current_frame)
+          return;
+
+        if (!m_seek_target_frame)
+          m_speed_before_seek = Config::Get(Config::MAIN_EMULATION_SPEED);
+        m_seek_target_frame = frame;
+        seeking = true;
+      },
+      true);
+
+  if (!seeking)
+    return frame == m_current_frame;
+
+  Core::DisplayMessage(fmt::format("Seeking to frame {}...", frame), 2000);
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  if (core_state == Core::State::Paused)
+    Core::SetState(m_system, Core::State::Running);
+  return true;
 }
 
 // called when game is booting up, even if no movie is active,
@@ -240,6 +448,7 @@ void MovieManager::Init(const BootParameters& boot)
   {
     m_recording_from_save_state = false;
     m_rerecords = 0;
+    m_movie_id = GenerateMovieID();
     m_current_byte = 0;
     m_current_frame = 0;
     m_current_lag_count = 0;
@@ -560,6 +769,11 @@ bool MovieManager::BeginRecordingInput(const ControllerTypeArray& controllers,
     m_play_mode = PlayMode::Recording;
     m_author = Config::Get(Config::MAIN_MOVIE_MOVIE_AUTHOR);
     m_temp_input.clear();
+    m_ram_hashes.clear();
+
+    CloseCheckpoints();
+    if (Config::Get(Config::MAIN_MOVIE_CHECKPOINT_INTERVAL) > 0)
+      m_checkpoints.Create(GetRecordingCheckpointsPath(), m_movie_id);
 
     m_current_byte = 0;
 
@@ -897,6 +1111,8 @@ void MovieManager::ReadHeader()
     m_wiimotes[i] = (m_temp_header.controllers & (1 << (i + 4))) != 0;
   }
   m_recording_start_time = m_temp_header.recordingStartTime;
+  if (m_temp_header.uniqueID != 0)
+    m_movie_id = m_temp_header.uniqueID;
   if (m_rerecords < m_temp_header.numRerecords)
     m_rerecords = m_temp_header.numRerecords;
 
@@ -959,11 +1175,27 @@ bool MovieManager::PlayInput(const std::string& movie_path,
 
   Core::UpdateWantDeterminism(m_system);
 
-  m_temp_input.resize(recording_file.GetSize() - 256);
+  m_temp_input.resize(GetInputDataSize(m_temp_header, recording_file.GetSize()));
   recording_file.ReadBytes(m_temp_input.data(), m_temp_input.size());
+  ReadRAMHashes(recording_file);
   m_current_byte = 0;
   recording_file.Close();
 
+  // Movies recorded before movie IDs were stored are identified by their inputs instead
+  if (m_temp_header.uniqueID == 0)
+  {
+    m_movie_id = XXH64(m_temp_input.data(), m_temp_input.size(),
+                       m_temp_header.recordingStartTime);
+  }
+
+  m_playback_verification = {.total_frames = m_total_frames,
+                             .total_ram_hashes = m_ram_hashes.size()};
+
+  // Checkpoints taken during this playback are added to the movie's own ones
+  CloseCheckpoints();
+  m_checkpoints.Open(movie_path + ".idx", m_movie_id,
+                     Config::Get(Config::MAIN_MOVIE_CHECKPOINT_INTERVAL) > 0);
+
   // Load savestate (and skip to frame data)
   if (m_temp_header.bFromSaveState && savestate_path)
   {
@@ -1037,7 +1269,7 @@ void MovieManager::LoadInput(const std::string& movie_path)
   if (m_system.IsWii())
     ChangeWiiPads(true);
 
-  u64 totalSavedBytes = t_record.GetSize() - 256;
+  u64 totalSavedBytes = GetInputDataSize(m_temp_header, t_record.GetSize());
 
   bool afterEnd = false;
   // This can only happen if the user manually deletes data from the dtm.
@@ -1059,6 +1291,16 @@ void MovieManager::LoadInput(const std::string& movie_path)
 
     m_temp_input.resize(static_cast<size_t>(totalSavedBytes));
     t_record.ReadBytes(m_temp_input.data(), m_temp_input.size());
+    ReadRAMHashes(t_record);
+
+    // The frames after this one are going to be recorded again
+    if (!m_read_only)
+    {
+      m_ram_hashes.erase(
+          std::ranges::upper_bound(m_ram_hashes, m_current_frame, {}, &DTMRAMHash::frame),
+          m_ram_hashes.end());
+      DiscardCheckpointsAfterCurrentFrame();
+    }
   }
   else if (m_current_byte > 0)
   {
@@ -1178,6 +1420,7 @@ void MovieManager::CheckInputEnd()
       (m_system.GetCoreTiming().GetTicks() > m_total_tick_count &&
        !IsRecordingInputFromSaveState()))
   {
+    m_playback_verification.reached_end = true;
     EndPlayInput(!m_read_only);
   }
 }
@@ -1333,6 +1576,7 @@ void MovieManager::EndPlayInput(bool cont)
     ASSERT(IsMovieActive());
 
     m_play_mode = PlayMode::Recording;
+    DiscardCheckpointsAfterCurrentFrame();
     Core::DisplayMessage("Reached movie end. Resuming recording.", 2000);
   }
   else if (m_play_mode != PlayMode::None)
@@ -1342,12 +1586,17 @@ void MovieManager::EndPlayInput(bool cont)
     const bool was_running = Core::IsRunning(m_system) && !cpu.IsStepping();
     if (was_running && Config::Get(Config::MAIN_MOVIE_PAUSE_MOVIE))
       cpu.Break();
+    const bool was_playing = m_play_mode == PlayMode::Playing;
     m_rerecords = 0;
     m_current_byte = 0;
     m_play_mode = PlayMode::None;
     Core::DisplayMessage("Movie End.", 2000);
     m_recording_from_save_state = false;
     Config::RemoveLayer(Config::LayerType::Movie);
+    StopSeeking();
+    CloseCheckpoints();
+    if (was_playing && Config::Get(Config::MAIN_MOVIE_STOP_AT_END))
+      Host_Message(HostMessageID::WMUserStop);
     // we don't clear these things because otherwise we can't resume playback if we load a movie
     // state later
     // m_total_frames = s_totalBytes = 0;
@@ -1390,6 +1639,7 @@ void MovieManager::SaveRecording(const std::string& filename)
   header.inputCount = m_total_input_count;
   header.numRerecords = m_rerecords;
   header.recordingStartTime = m_recording_start_time;
+  header.uniqueID = m_movie_id;
 
   header.bSaveConfig = true;
   ConfigLoaders::SaveToDTM(&header);
@@ -1404,14 +1654,15 @@ void MovieManager::SaveRecording(const std::string& filename)
   header.DSPiromHash = m_dsp_irom_hash;
   header.DSPcoefHash = m_dsp_coef_hash;
   header.tickCount = m_total_tick_count;
+  header.ramHashCount = static_cast<u32>(m_ram_hashes.size());
 
   // TODO
-  header.uniqueID = 0;
   // header.audioEmulator;
 
   save_record.WriteArray(&header, 1);
 
-  bool success = save_record.WriteBytes(m_temp_input.data(), m_temp_input.size());
+  bool success = save_record.WriteBytes(m_temp_input.data(), m_temp_input.size()) &&
+                 save_record.WriteArray(m_ram_hashes.data(), m_ram_hashes.size());
 
   if (success && m_recording_from_save_state)
   {
@@ -1425,6 +1676,27 @@ void MovieManager::SaveRecording(const std::string& filename)
     Core::DisplayMessage(fmt::format("Failed to save {}", filename), 2000);
 }
 
+// NOTE: Host Thread
+void MovieManager::SaveCheckpoints(const std::string& movie_path)
+{
+  const std::string path = movie_path + ".idx";
+  const std::string source_path = m_checkpoints.GetPath();
+  if (source_path == path)
+    return;
+
+  if (source_path.empty())
+  {
+    // Checkpoints from an older movie at the same path would make seeking load the wrong states
+    if (File::Exists(path))
+      File::Delete(path);
+    return;
+  }
+
+  m_checkpoint_saver.WaitForCompletion();
+  if (!File::CopyRegularFile(source_path, path))
+    Core::DisplayMessage(fmt::format("Failed to save checkpoints to {}", path), 2000);
+}
+
 // NOTE: GPU Thread
 void MovieManager::SetGraphicsConfig()
 {
@@ -1550,6 +1822,8 @@ void MovieManager::GetMD5()
 // NOTE: EmuThread
 void MovieManager::Shutdown()
 {
+  StopSeeking();
+  CloseCheckpoints();
   m_current_input_count = m_total_input_count = m_total_frames = m_tick_count_at_last_input = 0;
   m_temp_input.clear();
 }
@@ -12,6 +12,8 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Core/MovieCheckpoints.h"
+#include "Core/State.h"
 
 struct BootParameters;
 
@@ -23,6 +25,11 @@ namespace Core
 class System;
 }
 
+namespace File
+{
+class IOFile;
+}
+
 namespace ExpansionInterface
 {
 enum class Slot : int;
@@ -96,7 +103,7 @@ struct DTMHeader
   u64 frameCount;      // Number of frames in the recording
   u64 inputCount;      // Number of input frames in recording
   u64 lagCount;        // Number of lag frames in the recording
-  u64 uniqueID;        // (not implemented) A Unique ID comprised of: md5(time + Game ID)
+  u64 uniqueID;        // Random ID of the recording, used to match it with its checkpoint file
   u32 numRerecords;    // Number of rerecords/'cuts' of this TAS
   std::array<char, 32> author;  // Author's name (encoded in UTF-8)
 
@@ -137,13 +144,34 @@ struct DTMHeader
   std::array<u8, 20> revision;      // Git hash
   u32 DSPiromHash;
   u32 DSPcoefHash;
-  u64 tickCount;                 // Number of ticks in the recording
-  std::array<u8, 11> reserved2;  // Make heading 256 bytes, just because we can
+  u64 tickCount;                // Number of ticks in the recording
+  u32 ramHashCount;             // Number of DTMRAMHash entries stored after the input data
+  std::array<u8, 7> reserved2;  // Make heading 256 bytes, just because we can
 };
 static_assert(sizeof(DTMHeader) == 256, "DTMHeader should be 256 bytes");
 
+// Hash of the emulated RAM at the start of a frame, for detecting desyncs during playback
+struct DTMRAMHash
+{
+  u64 frame;
+  u64 hash;
+};
+static_assert(sizeof(DTMRAMHash) == 16, "DTMRAMHash should be 16 bytes");
+
 #pragma pack(pop)
 
+// How a playback went, for checking recordings without watching them
+struct PlaybackVerification
+{
+  u64 frames_played = 0;
+  u64 total_frames = 0;
+  u64 checked_ram_hashes = 0;
+  u64 total_ram_hashes = 0;
+  // The first frame whose RAM hash didn't match the one in the recording
+  std::optional<u64> first_mismatch_frame;
+  bool reached_end = false;
+};
+
 enum class PlayMode
 {
   None = 0,
@@ -215,6 +243,12 @@ public:
                    WiimoteEmu::ExtensionNumber ext, const WiimoteEmu::EncryptionKey& key);
   void EndPlayInput(bool cont);
   void SaveRecording(const std::string& filename);
+  // Stores the checkpoints that were taken while recording next to an exported movie
+  void SaveCheckpoints(const std::string& movie_path);
+  // Jumps to a frame of the movie that is being played back by loading the closest checkpoint
+  // before it and fast-forwarding from there, then pauses. Returns false if the frame can't be
+  // reached.
+  bool SeekToFrame(u64 frame);
   void DoState(PointerWrap& p);
   void Shutdown();
   void CheckPadStatus(const GCPadStatus* PadStatus, int controllerID);
@@ -225,9 +259,19 @@ public:
   std::string GetRTCDisplay() const;
   std::string GetRerecords() const;
 
+  // Describes the most recent playback. Remains valid after emulation has been shut down.
+  const PlaybackVerification& GetPlaybackVerification() const;
+
 private:
   void GetSettings();
   void CheckInputEnd();
+  void UpdateRAMHashes();
+  u64 HashRAM() const;
+  void ReadRAMHashes(File::IOFile& file);
+  void UpdateCheckpoints();
+  void CloseCheckpoints();
+  void DiscardCheckpointsAfterCurrentFrame();
+  void StopSeeking();
 
   void CheckMD5();
   void GetMD5();
@@ -241,6 +285,18 @@ private:
   ControllerState m_pad_state{};
   DTMHeader m_temp_header{};
   std::vector<u8> m_temp_input;
+  // Sorted by frame
+  std::vector<DTMRAMHash> m_ram_hashes;
+  PlaybackVerification m_playback_verification;
+
+  CheckpointFile m_checkpoints;
+  // Invalidated whenever the checkpoints that haven't been written yet stop matching the file
+  State::BackgroundStateSaver m_checkpoint_saver;
+  // Identifies the movie in its checkpoint file, stored in DTMHeader::uniqueID
+  u64 m_movie_id = 0;
+  std::optional<u64> m_seek_target_frame;
+  float m_speed_before_seek = 1.0f;
+
   u64 m_current_byte = 0;
   u64 m_current_frame = 0;
   u64 m_total_frames = 0;  // VI
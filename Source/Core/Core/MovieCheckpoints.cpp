@@ -0,0 +1,240 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/MovieCheckpoints.h"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <mutex>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Core/State.h"
+
+namespace Movie
+{
+namespace
+{
+constexpr std::array<u8, 4> FILE_MAGIC = {'D', 'C', 'P', 0x1A};
+constexpr u32 FILE_VERSION = 2;
+
+#pragma pack(push, 1)
+struct FileHeader
+{
+  std::array<u8, 4> magic;
+  u32 version;
+  // The movie that the checkpoints were taken from, see CheckpointFile::Open
+  u64 movie_id;
+};
+
+struct CheckpointHeader
+{
+  u64 frame;
+  u32 size;
+  u32 compressed_size;
+};
+#pragma pack(pop)
+}  // namespace
+
+bool CheckpointFile::Open(const std::string& path, u64 movie_id, bool create)
+{
+  std::lock_guard lk(m_mutex);
+
+  m_path = path;
+  if (m_file.Open(path, "r+b") && ReadCheckpoints(movie_id))
+    return true;
+
+  if (create && CreateInternal(path, movie_id))
+    return true;
+
+  m_file.Close();
+  m_path.clear();
+  m_checkpoints.clear();
+  return false;
+}
+
+bool CheckpointFile::Create(const std::string& path, u64 movie_id)
+{
+  std::lock_guard lk(m_mutex);
+
+  if (CreateInternal(path, movie_id))
+    return true;
+
+  m_file.Close();
+  m_path.clear();
+  m_checkpoints.clear();
+  return false;
+}
+
+bool CheckpointFile::CreateInternal(const std::string& path, u64 movie_id)
+{
+  m_path = path;
+  m_checkpoints.clear();
+  m_end_offset = sizeof(FileHeader);
+
+  const FileHeader header{FILE_MAGIC, FILE_VERSION, movie_id};
+  return m_file.Open(path, "w+b") && m_file.WriteArray(&header, 1) && m_file.Flush();
+}
+
+bool CheckpointFile::ReadCheckpoints(u64 movie_id)
+{
+  m_checkpoints.clear();
+
+  FileHeader header;
+  if (!m_file.ReadArray(&header, 1) || header.magic != FILE_MAGIC ||
+      header.version != FILE_VERSION)
+  {
+    return false;
+  }
+
+  if (header.movie_id != movie_id)
+  {
+    WARN_LOG_FMT(CORE, "{} contains checkpoints of a different movie", m_path);
+    return false;
+  }
+
+  const u64 file_size = m_file.GetSize();
+  u64 offset = sizeof(FileHeader);
+
+  CheckpointHeader checkpoint_header;
+  while (m_file.Seek(offset, File::SeekOrigin::Begin) && m_file.ReadArray(&checkpoint_header, 1))
+  {
+    const u64 data_offset = offset + sizeof(CheckpointHeader);
+    if (file_size - data_offset < checkpoint_header.compressed_size)
+      break;
+
+    if (!m_checkpoints.empty() && checkpoint_header.frame <= m_checkpoints.back().frame)
+      break;
+
+    m_checkpoints.push_back({checkpoint_header.frame, data_offset, checkpoint_header.size,
+                             checkpoint_header.compressed_size});
+    offset = data_offset + checkpoint_header.compressed_size;
+  }
+
+  // Cut off whatever follows the last complete checkpoint, so that new checkpoints are appended
+  // right after it
+  m_file.ClearError();
+  m_end_offset = offset;
+  if (offset != file_size && !m_file.Resize(offset))
+    return false;
+
+  return true;
+}
+
+void CheckpointFile::Close()
+{
+  std::lock_guard lk(m_mutex);
+
+  m_file.Close();
+  m_path.clear();
+  m_checkpoints.clear();
+}
+
+bool CheckpointFile::IsOpen() const
+{
+  std::lock_guard lk(m_mutex);
+  return m_file.IsOpen();
+}
+
+std::string CheckpointFile::GetPath() const
+{
+  std::lock_guard lk(m_mutex);
+  return m_path;
+}
+
+size_t CheckpointFile::GetCount() const
+{
+  std::lock_guard lk(m_mutex);
+  return m_checkpoints.size();
+}
+
+std::optional<u64> CheckpointFile::GetLastFrame() const
+{
+  std::lock_guard lk(m_mutex);
+
+  if (m_checkpoints.empty())
+    return std::nullopt;
+  return m_checkpoints.back().frame;
+}
+
+bool CheckpointFile::Add(u64 frame, const std::vector<u8>& state)
+{
+  // Compress before locking, so that seeking doesn't have to wait for it
+  const std::vector<u8> compressed = State::CompressLZ4Block(state);
+  if (compressed.empty())
+  {
+    ERROR_LOG_FMT(CORE, "Failed to compress a movie checkpoint ({} bytes)", state.size());
+    return false;
+  }
+
+  const CheckpointHeader header{frame, static_cast<u32>(state.size()),
+                                static_cast<u32>(compressed.size())};
+
+  std::lock_guard lk(m_mutex);
+
+  if (!m_file.IsOpen() || (!m_checkpoints.empty() && m_checkpoints.back().frame >= frame))
+    return false;
+
+  if (!m_file.Seek(m_end_offset, File::SeekOrigin::Begin) || !m_file.WriteArray(&header, 1) ||
+      !m_file.WriteBytes(compressed.data(), compressed.size()) || !m_file.Flush())
+  {
+    ERROR_LOG_FMT(CORE, "Failed to write a movie checkpoint to {}", m_path);
+    m_file.ClearError();
+    return false;
+  }
+
+  m_checkpoints.push_back({frame, m_end_offset + sizeof(CheckpointHeader), header.size,
+                           header.compressed_size});
+  m_end_offset += sizeof(CheckpointHeader) + compressed.size();
+  return true;
+}
+
+void CheckpointFile::DiscardAfter(u64 frame)
+{
+  std::lock_guard lk(m_mutex);
+
+  const auto it = std::ranges::upper_bound(m_checkpoints, frame, {}, &Checkpoint::frame);
+  if (it == m_checkpoints.end())
+    return;
+
+  m_end_offset = it->offset - sizeof(CheckpointHeader);
+  m_checkpoints.erase(it, m_checkpoints.end());
+
+  if (!m_file.Resize(m_end_offset))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to truncate movie checkpoints in {}", m_path);
+    m_file.ClearError();
+  }
+}
+
+std::optional<CheckpointFile::Checkpoint> CheckpointFile::FindLatestAtOrBefore(u64 frame) const
+{
+  std::lock_guard lk(m_mutex);
+
+  const auto it = std::ranges::upper_bound(m_checkpoints, frame, {}, &Checkpoint::frame);
+  if (it == m_checkpoints.begin())
+    return std::nullopt;
+  return *std::prev(it);
+}
+
+bool CheckpointFile::Load(const Checkpoint& checkpoint, std::vector<u8>* state_out)
+{
+  std::vector<u8> compressed(checkpoint.compressed_size);
+  {
+    std::lock_guard lk(m_mutex);
+
+    if (!m_file.Seek(checkpoint.offset, File::SeekOrigin::Begin) ||
+        !m_file.ReadBytes(compressed.data(), compressed.size()))
+    {
+      ERROR_LOG_FMT(CORE, "Failed to read a movie checkpoint from {}", m_path);
+      m_file.ClearError();
+      return false;
+    }
+  }
+
+  return State::DecompressLZ4Block(compressed, checkpoint.size, state_out);
+}
+
+}  // namespace Movie
@@ -0,0 +1,75 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+
+namespace Movie
+{
+// A file stored next to a movie that contains LZ4-compressed savestates taken every few frames
+// during the movie, so that playback can seek to any frame by loading the closest earlier
+// checkpoint and fast-forwarding from there.
+//
+// The file is a header followed by the checkpoints in order of increasing frame. Checkpoints are
+// only ever appended or cut off at the end, so if writing a checkpoint gets interrupted, only that
+// checkpoint is lost.
+//
+// This class is thread-safe.
+class CheckpointFile
+{
+public:
+  struct Checkpoint
+  {
+    u64 frame = 0;
+    // Offset of the compressed state in the file
+    u64 offset = 0;
+    // Uncompressed size of the state
+    u32 size = 0;
+    u32 compressed_size = 0;
+  };
+
+  // Opens an existing checkpoint file. movie_id identifies the movie that the checkpoints belong
+  // to. If the file doesn't exist, isn't a checkpoint file or belongs to a different movie, an
+  // empty one is created in its place if create is true.
+  bool Open(const std::string& path, u64 movie_id, bool create);
+  // Creates an empty checkpoint file, replacing the file if it exists
+  bool Create(const std::string& path, u64 movie_id);
+  void Close();
+
+  bool IsOpen() const;
+  std::string GetPath() const;
+  size_t GetCount() const;
+  std::optional<u64> GetLastFrame() const;
+
+  // Appends a checkpoint. Does nothing and returns false if the file already has a checkpoint for
+  // this frame or a later one, since those were taken from the same inputs.
+  bool Add(u64 frame, const std::vector<u8>& state);
+
+  // Removes the checkpoints after the given frame, e.g. when those frames get recorded again
+  void DiscardAfter(u64 frame);
+
+  std::optional<Checkpoint> FindLatestAtOrBefore(u64 frame) const;
+  bool Load(const Checkpoint& checkpoint, std::vector<u8>* state_out);
+
+private:
+  bool CreateInternal(const std::string& path, u64 movie_id);
+  bool ReadCheckpoints(u64 movie_id);
+
+  mutable std::mutex m_mutex;
+  File::IOFile m_file;
+  std::string m_path;
+  // Sorted by frame
+  std::vector<Checkpoint> m_checkpoints;
+  // Where the next checkpoint gets written
+  u64 m_end_offset = 0;
+};
+
+}  // namespace Movie
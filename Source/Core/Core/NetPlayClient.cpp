@@ -10,6 +10,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <thread>
 #include <tuple>
@@ -25,6 +26,7 @@
 #include "Common/Crypto/SHA1.h"
 #include "Common/ENet.h"
 #include "Common/FileUtil.h"
+#include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/NandPaths.h"
@@ -1033,6 +1035,10 @@ void NetPlayClient::OnSyncSaveData(sf::Packet& packet)
     OnSyncSaveDataGBA(packet);
     break;
 
+  case SyncSaveDataID::BlockData:
+    OnSyncSaveDataBlocks(packet);
+    break;
+
   default:
     PanicAlertFmtT("Unknown SYNC_SAVE_DATA message received with id: {0}", static_cast<u8>(sub_id));
     break;
@@ -1043,6 +1049,7 @@ void NetPlayClient::OnSyncSaveDataNotify(sf::Packet& packet)
 {
   packet >> m_sync_save_data_count;
   m_sync_save_data_success_count = 0;
+  m_pending_block_syncs.clear();
 
   INFO_LOG_FMT(NETPLAY, "Initializing wait for {} savegame chunks.", m_sync_save_data_count);
 
@@ -1079,15 +1086,7 @@ void NetPlayClient::OnSyncSaveDataRaw(sf::Packet& packet)
 
   const std::string path = File::GetUserPath(D_GCUSER_IDX) + GC_MEMCARD_NETPLAY +
                            (is_slot_a ? "A." : "B.") + region + size_suffix + ".raw";
-  if (File::Exists(path) && !File::Delete(path))
-  {
-    PanicAlertFmtT("Failed to delete NetPlay memory card. Verify your write permissions.");
-    SyncSaveDataResponse(false);
-    return;
-  }
-
-  const bool success = DecompressPacketIntoFile(packet, path);
-  SyncSaveDataResponse(success);
+  RequestSaveDataBlocks(packet, path);
 }
 
 void NetPlayClient::OnSyncSaveDataGCI(sf::Packet& packet)
@@ -1289,18 +1288,103 @@ void NetPlayClient::OnSyncSaveDataGBA(sf::Packet& packet)
 
   const std::string path =
       fmt::format("{}{}{}.sav", File::GetUserPath(D_GBAUSER_IDX), GBA_SAVE_NETPLAY, slot + 1);
-  if (File::Exists(path) && !File::Delete(path))
+  RequestSaveDataBlocks(packet, path);
+}
+
+// The copy of the file from the previous synchronization is reused, so only the blocks that
+// changed since then need to be sent
+void NetPlayClient::RequestSaveDataBlocks(sf::Packet& packet, const std::string& path)
+{
+  u8 sync_id;
+  packet >> sync_id;
+
+  std::optional<BlockManifest> manifest = ReadBlockManifestFromPacket(packet);
+  if (!manifest)
+  {
+    WARN_LOG_FMT(NETPLAY, "Received an invalid save data manifest.");
+    SyncSaveDataResponse(false);
+    return;
+  }
+
+  std::vector<u8> data;
+  File::IOFile file(path, "rb");
+  if (file)
+  {
+    data.resize(std::min(file.GetSize(), manifest->size));
+    if (!file.ReadBytes(data.data(), data.size()))
+      data.clear();
+  }
+  file.Close();
+
+  const std::vector<u32> blocks = GetMismatchedBlocks(*manifest, data);
+  INFO_LOG_FMT(NETPLAY, "Requesting {} of {} blocks of {}.", blocks.size(),
+               manifest->block_hashes.size(), path);
+
+  if (blocks.empty())
+  {
+    data.resize(manifest->size);
+    SyncSaveDataResponse(WriteSyncedSaveData(path, data));
+    return;
+  }
+
+  m_pending_block_syncs[sync_id] = {path, std::move(*manifest), std::move(data)};
+
+  sf::Packet response_packet;
+  response_packet << MessageID::SyncSaveData;
+  response_packet << SyncSaveDataID::BlockRequest;
+  response_packet << sync_id << static_cast<u32>(blocks.size());
+  for (const u32 block : blocks)
+    response_packet << block;
+
+  Send(response_packet);
+}
+
+void NetPlayClient::OnSyncSaveDataBlocks(sf::Packet& packet)
+{
+  u8 sync_id;
+  packet >> sync_id;
+
+  const auto it = m_pending_block_syncs.find(sync_id);
+  if (it == m_pending_block_syncs.end())
   {
-    PanicAlertFmtT("Failed to delete NetPlay GBA{0} save file. Verify your write permissions.",
-                   slot + 1);
+    WARN_LOG_FMT(NETPLAY, "Received save data blocks that weren't requested.");
     SyncSaveDataResponse(false);
     return;
   }
 
-  const bool success = DecompressPacketIntoFile(packet, path);
+  PendingBlockSync sync = std::move(it->second);
+  m_pending_block_syncs.erase(it);
+
+  INFO_LOG_FMT(NETPLAY, "Received save data blocks for {}.", sync.path);
+
+  const bool success = DecompressBlocksFromPacket(packet, sync.manifest, sync.data) &&
+                       WriteSyncedSaveData(sync.path, sync.data);
   SyncSaveDataResponse(success);
 }
 
+bool NetPlayClient::WriteSyncedSaveData(const std::string& path, const std::vector<u8>& data)
+{
+  // The host had no save file
+  if (data.empty())
+  {
+    if (File::Exists(path) && !File::Delete(path))
+    {
+      PanicAlertFmtT("Failed to delete \"{0}\". Verify your write permissions.", path);
+      return false;
+    }
+    return true;
+  }
+
+  File::IOFile file(path, "wb");
+  if (!file || !file.WriteBytes(data.data(), data.size()))
+  {
+    PanicAlertFmtT("Failed to write file \"{0}\". Verify your write permissions.", path);
+    return false;
+  }
+
+  return true;
+}
+
 void NetPlayClient::OnSyncCodes(sf::Packet& packet)
 {
   // Recieve Data Packet
@@ -20,6 +20,7 @@
 #include "Common/Event.h"
 #include "Common/SPSCQueue.h"
 #include "Common/TraversalClient.h"
+#include "Core/NetPlayCommon.h"
 #include "Core/NetPlayProto.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
@@ -306,6 +307,9 @@ private:
   void OnSyncSaveDataGCI(sf::Packet& packet);
   void OnSyncSaveDataWii(sf::Packet& packet);
   void OnSyncSaveDataGBA(sf::Packet& packet);
+  void OnSyncSaveDataBlocks(sf::Packet& packet);
+  void RequestSaveDataBlocks(sf::Packet& packet, const std::string& path);
+  bool WriteSyncedSaveData(const std::string& path, const std::vector<u8>& data);
   void OnSyncCodes(sf::Packet& packet);
   void OnSyncCodesNotify();
   void OnSyncCodesNotifyGecko(sf::Packet& packet);
@@ -344,6 +348,15 @@ private:
   bool m_sync_ar_codes_complete = false;
   std::unordered_map<u32, sf::Packet> m_chunked_data_receive_queue;
 
+  // Save data whose manifest has been received, waiting for the blocks that were requested
+  struct PendingBlockSync
+  {
+    std::string path;
+    BlockManifest manifest;
+    std::vector<u8> data;
+  };
+  std::map<u8, PendingBlockSync> m_pending_block_syncs;
+
   u64 m_initial_rtc = 0;
   u32 m_timebase_frame = 0;
 
@@ -4,13 +4,17 @@
 #include "Core/NetPlayCommon.h"
 
 #include <algorithm>
+#include <atomic>
 
 #include <fmt/format.h>
 #include <lzo/lzo1x.h>
+#include <xxhash.h>
 
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/ParallelFor.h"
 #include "Common/SFMLHelper.h"
 
 namespace NetPlay
@@ -18,6 +22,8 @@ namespace NetPlay
 constexpr u32 LZO_IN_LEN = 1024 * 64;
 constexpr u32 LZO_OUT_LEN = LZO_IN_LEN + (LZO_IN_LEN / 16) + 64 + 3;
 
+static_assert(SYNC_BLOCK_SIZE <= LZO_IN_LEN);
+
 bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet)
 {
   File::IOFile file(file_path, "rb");
@@ -297,4 +303,162 @@ std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet)
 
   return out_buffer;
 }
+
+static size_t GetBlockCount(u64 size)
+{
+  return static_cast<size_t>((size + SYNC_BLOCK_SIZE - 1) / SYNC_BLOCK_SIZE);
+}
+
+static size_t GetBlockSize(u64 size, size_t block)
+{
+  return static_cast<size_t>(std::min<u64>(SYNC_BLOCK_SIZE, size - u64{block} * SYNC_BLOCK_SIZE));
+}
+
+static u64 HashBlock(const u8* data, u64 size, size_t block)
+{
+  return XXH64(data + block * SYNC_BLOCK_SIZE, GetBlockSize(size, block), 0);
+}
+
+BlockManifest CreateBlockManifest(const std::vector<u8>& data)
+{
+  BlockManifest manifest;
+  manifest.size = data.size();
+  manifest.block_hashes.resize(GetBlockCount(data.size()));
+  for (size_t i = 0; i < manifest.block_hashes.size(); ++i)
+    manifest.block_hashes[i] = HashBlock(data.data(), data.size(), i);
+
+  return manifest;
+}
+
+void WriteBlockManifestIntoPacket(const BlockManifest& manifest, sf::Packet& packet)
+{
+  packet << sf::Uint64{manifest.size};
+  for (const u64 hash : manifest.block_hashes)
+    packet << sf::Uint64{hash};
+}
+
+std::optional<BlockManifest> ReadBlockManifestFromPacket(sf::Packet& packet)
+{
+  BlockManifest manifest;
+  manifest.size = Common::PacketReadU64(packet);
+  if (!packet || manifest.size > MAX_BLOCK_SYNC_DATA_SIZE)
+    return std::nullopt;
+
+  manifest.block_hashes.resize(GetBlockCount(manifest.size));
+  for (u64& hash : manifest.block_hashes)
+    hash = Common::PacketReadU64(packet);
+
+  if (!packet)
+    return std::nullopt;
+
+  return manifest;
+}
+
+std::vector<u32> GetMismatchedBlocks(const BlockManifest& manifest, const std::vector<u8>& data)
+{
+  std::vector<u32> blocks;
+  for (size_t i = 0; i < manifest.block_hashes.size(); ++i)
+  {
+    // Blocks that are only partially present in data always mismatch
+    const u64 block_end = u64{i} * SYNC_BLOCK_SIZE + GetBlockSize(manifest.size, i);
+    if (block_end > data.size() ||
+        HashBlock(data.data(), manifest.size, i) != manifest.block_hashes[i])
+    {
+      blocks.push_back(static_cast<u32>(i));
+    }
+  }
+
+  return blocks;
+}
+
+bool CompressBlocksIntoPacket(const std::vector<u8>& data, const std::vector<u32>& blocks,
+                              sf::Packet& packet)
+{
+  const size_t block_count = GetBlockCount(data.size());
+  if (std::any_of(blocks.begin(), blocks.end(), [&](u32 block) { return block >= block_count; }))
+  {
+    ERROR_LOG_FMT(NETPLAY, "Requested save data block is out of range.");
+    return false;
+  }
+
+  std::vector<std::vector<u8>> compressed_blocks(blocks.size());
+  std::atomic<bool> success = true;
+
+  Common::ParallelFor(blocks.size(), [&](size_t i) {
+    const size_t offset = static_cast<size_t>(blocks[i]) * SYNC_BLOCK_SIZE;
+    const size_t size = GetBlockSize(data.size(), blocks[i]);
+    std::vector<u8>& compressed = compressed_blocks[i];
+    std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
+
+    compressed.resize(LZO_OUT_LEN);
+    lzo_uint out_len = 0;
+    if (lzo1x_1_compress(&data[offset], static_cast<lzo_uint>(size), compressed.data(), &out_len,
+                         wrkmem.data()) != LZO_E_OK)
+    {
+      success = false;
+    }
+    compressed.resize(out_len);
+  });
+
+  if (!success)
+  {
+    PanicAlertFmtT("Internal LZO Error - compression failed");
+    return false;
+  }
+
+  packet << static_cast<u32>(blocks.size());
+  for (size_t i = 0; i < blocks.size(); ++i)
+  {
+    packet << blocks[i] << static_cast<u32>(compressed_blocks[i].size());
+    packet.append(compressed_blocks[i].data(), compressed_blocks[i].size());
+  }
+
+  return true;
+}
+
+bool DecompressBlocksFromPacket(sf::Packet& packet, const BlockManifest& manifest,
+                                std::vector<u8>& data)
+{
+  data.resize(manifest.size);
+
+  u32 count = 0;
+  packet >> count;
+
+  std::vector<u8> in_buffer(LZO_OUT_LEN);
+  for (u32 i = 0; i < count; ++i)
+  {
+    u32 block = 0;
+    u32 cur_len = 0;
+    packet >> block >> cur_len;
+    if (!packet || block >= manifest.block_hashes.size() || cur_len > LZO_OUT_LEN)
+    {
+      ERROR_LOG_FMT(NETPLAY, "Received an invalid save data block.");
+      return false;
+    }
+
+    for (size_t j = 0; j < cur_len; j++)
+    {
+      packet >> in_buffer[j];
+    }
+
+    const size_t offset = static_cast<size_t>(block) * SYNC_BLOCK_SIZE;
+    const size_t size = GetBlockSize(data.size(), block);
+    lzo_uint new_len = static_cast<lzo_uint>(size);
+    if (lzo1x_decompress_safe(in_buffer.data(), cur_len, &data[offset], &new_len, nullptr) !=
+            LZO_E_OK ||
+        new_len != size)
+    {
+      PanicAlertFmtT("Internal LZO Error - decompression failed");
+      return false;
+    }
+  }
+
+  if (!GetMismatchedBlocks(manifest, data).empty())
+  {
+    ERROR_LOG_FMT(NETPLAY, "Synchronized save data doesn't match its manifest.");
+    return false;
+  }
+
+  return true;
+}
 }  // namespace NetPlay
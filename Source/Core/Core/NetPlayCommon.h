@@ -20,10 +20,34 @@ using namespace std::chrono_literals;
 // connection is disconnected
 constexpr std::chrono::milliseconds PEER_TIMEOUT = 30s;
 
+// Save data that is synchronized as a block manifest is split into blocks of this size,
+// so that clients only need to receive the blocks that differ from the data they already have
+constexpr u32 SYNC_BLOCK_SIZE = 1024 * 64;
+constexpr u64 MAX_BLOCK_SYNC_DATA_SIZE = 0x10000000;
+
+struct BlockManifest
+{
+  u64 size = 0;
+  std::vector<u64> block_hashes;
+};
+
 bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet);
 bool CompressFolderIntoPacket(const std::string& folder_path, sf::Packet& packet);
 bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& packet);
 bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path);
 bool DecompressPacketIntoFolder(sf::Packet& packet, const std::string& folder_path);
 std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet);
+
+BlockManifest CreateBlockManifest(const std::vector<u8>& data);
+void WriteBlockManifestIntoPacket(const BlockManifest& manifest, sf::Packet& packet);
+std::optional<BlockManifest> ReadBlockManifestFromPacket(sf::Packet& packet);
+// Returns the indices of the blocks in the manifest which data doesn't match
+std::vector<u32> GetMismatchedBlocks(const BlockManifest& manifest, const std::vector<u8>& data);
+// Compresses the given blocks of data in parallel
+bool CompressBlocksIntoPacket(const std::vector<u8>& data, const std::vector<u32>& blocks,
+                              sf::Packet& packet);
+// Overwrites the received blocks in data, which gets resized to the size in the manifest.
+// Fails if the resulting data doesn't match the manifest.
+bool DecompressBlocksFromPacket(sf::Packet& packet, const BlockManifest& manifest,
+                                std::vector<u8>& data);
 }  // namespace NetPlay
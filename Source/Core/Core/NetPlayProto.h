@@ -207,7 +207,9 @@ enum class SyncSaveDataID : u8
   RawData = 3,
   GCIData = 4,
   WiiData = 5,
-  GBAData = 6
+  GBAData = 6,
+  BlockRequest = 7,
+  BlockData = 8
 };
 
 enum class SyncCodeID : u8
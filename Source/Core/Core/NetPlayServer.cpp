@@ -24,6 +24,7 @@
 #include "Common/ENet.h"
 #include "Common/FileUtil.h"
 #include "Common/HttpRequest.h"
+#include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/SFMLHelper.h"
@@ -1170,6 +1171,18 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     }
     break;
 
+    case SyncSaveDataID::BlockRequest:
+    {
+      if (!SendRequestedBlocks(packet, player))
+      {
+        m_dialog->AppendChat(Common::FmtFormatT("{0} failed to synchronize.", player.name));
+        m_dialog->OnGameStartAborted();
+        ChunkedDataAbort();
+        m_start_pending = false;
+      }
+    }
+    break;
+
     case SyncSaveDataID::Failure:
     {
       m_dialog->AppendChat(Common::FmtFormatT("{0} failed to synchronize.", player.name));
@@ -1802,6 +1815,11 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
 
   m_save_data_synced_players = 0;
 
+  {
+    std::lock_guard lkbs(m_crit.block_sync_data);
+    m_block_sync_data.clear();
+  }
+
   {
     sf::Packet pac;
     pac << MessageID::SyncSaveData;
@@ -1832,28 +1850,20 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
               Memcard::MBIT_SIZE_MEMORY_CARD_2043;
       const std::string path = Config::GetMemcardPath(slot, game_region, card_size_mbits);
 
+      const std::string title =
+          fmt::format("Memory Card {} Synchronization", is_slot_a ? 'A' : 'B');
+
       sf::Packet pac;
       pac << MessageID::SyncSaveData;
       pac << SyncSaveDataID::RawData;
       pac << is_slot_a << region << size_override;
 
-      if (File::Exists(path))
-      {
-        INFO_LOG_FMT(NETPLAY, "Sending data of raw memcard {} in slot {}.", path,
-                     is_slot_a ? 'A' : 'B');
-        if (!CompressFileIntoPacket(path, pac))
-          return false;
-      }
-      else
-      {
-        // No file, so we'll say the size is 0
-        INFO_LOG_FMT(NETPLAY, "Sending empty marker for raw memcard {} in slot {}.", path,
-                     is_slot_a ? 'A' : 'B');
-        pac << sf::Uint64{0};
-      }
+      INFO_LOG_FMT(NETPLAY, "Sending manifest of raw memcard {} in slot {}.", path,
+                   is_slot_a ? 'A' : 'B');
+      if (!AddBlockSyncData(path, title, pac))
+        return false;
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("Memory Card {} Synchronization", is_slot_a ? 'A' : 'B'));
+      SendChunkedToClients(std::move(pac), 1, title);
     }
     else if (Config::Get(Config::GetInfoForEXIDevice(slot)) ==
              ExpansionInterface::EXIDeviceType::MemoryCardFolder)
@@ -2012,27 +2022,87 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
       path = HW::GBA::Core::GetSavePath(Config::Get(Config::MAIN_GBA_ROM_PATHS[i]),
                                         static_cast<int>(i));
 #endif
-      if (File::Exists(path))
-      {
-        INFO_LOG_FMT(NETPLAY, "Sending data of GBA save at {} for slot {}.", path, i);
-        if (!CompressFileIntoPacket(path, pac))
-          return false;
-      }
-      else
-      {
-        // No file, so we'll say the size is 0
-        INFO_LOG_FMT(NETPLAY, "Sending empty marker for GBA save at {} for slot {}.", path, i);
-        pac << sf::Uint64{0};
-      }
+      const std::string title = fmt::format("GBA{} Save File Synchronization", i + 1);
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("GBA{} Save File Synchronization", i + 1));
+      INFO_LOG_FMT(NETPLAY, "Sending manifest of GBA save at {} for slot {}.", path, i);
+      if (!AddBlockSyncData(path, title, pac))
+        return false;
+
+      SendChunkedToClients(std::move(pac), 1, title);
     }
   }
 
   return true;
 }
 
+// Raw save files are only sent as a manifest of block hashes at first. Clients then request the
+// blocks that differ from their copy of the file from the previous synchronization, which usually
+// is most of a memory card.
+bool NetPlayServer::AddBlockSyncData(const std::string& path, std::string title,
+                                     sf::Packet& packet)
+{
+  BlockSyncData sync_data;
+  sync_data.title = std::move(title);
+
+  // No file is synchronized the same way as an empty one
+  if (File::Exists(path))
+  {
+    File::IOFile file(path, "rb");
+    if (!file || file.GetSize() > MAX_BLOCK_SYNC_DATA_SIZE)
+    {
+      PanicAlertFmtT("Failed to open file \"{0}\".", path);
+      return false;
+    }
+
+    sync_data.data.resize(file.GetSize());
+    if (!file.ReadBytes(sync_data.data.data(), sync_data.data.size()))
+    {
+      PanicAlertFmtT("Error reading file: {0}", path);
+      return false;
+    }
+  }
+
+  std::lock_guard lkbs(m_crit.block_sync_data);
+  packet << static_cast<u8>(m_block_sync_data.size());
+  WriteBlockManifestIntoPacket(CreateBlockManifest(sync_data.data), packet);
+  m_block_sync_data.push_back(std::move(sync_data));
+
+  return true;
+}
+
+bool NetPlayServer::SendRequestedBlocks(sf::Packet& packet, const Client& player)
+{
+  u8 sync_id;
+  u32 count;
+  packet >> sync_id >> count;
+
+  std::lock_guard lkbs(m_crit.block_sync_data);
+  if (!packet || sync_id >= m_block_sync_data.size() ||
+      count > m_block_sync_data[sync_id].data.size() / SYNC_BLOCK_SIZE + 1)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Invalid save data block request from player {}.", player.pid);
+    return false;
+  }
+
+  std::vector<u32> blocks(count);
+  for (u32& block : blocks)
+    packet >> block;
+
+  const BlockSyncData& sync_data = m_block_sync_data[sync_id];
+  INFO_LOG_FMT(NETPLAY, "Sending {} save data blocks of sync ID {} to player {}.", blocks.size(),
+               sync_id, player.pid);
+
+  sf::Packet pac;
+  pac << MessageID::SyncSaveData;
+  pac << SyncSaveDataID::BlockData;
+  pac << sync_id;
+  if (!packet || !CompressBlocksIntoPacket(sync_data.data, blocks, pac))
+    return false;
+
+  SendChunked(std::move(pac), player.pid, sync_data.title);
+  return true;
+}
+
 bool NetPlayServer::SyncCodes()
 {
   INFO_LOG_FMT(NETPLAY, "Sending codes to clients.");
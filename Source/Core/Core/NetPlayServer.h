@@ -121,9 +121,17 @@ private:
     std::string title;
   };
 
+  struct BlockSyncData
+  {
+    std::vector<u8> data;
+    std::string title;
+  };
+
   bool SetupNetSettings();
   std::optional<SaveSyncInfo> CollectSaveSyncInfo();
   bool SyncSaveData(const SaveSyncInfo& sync_info);
+  bool AddBlockSyncData(const std::string& path, std::string title, sf::Packet& packet);
+  bool SendRequestedBlocks(sf::Packet& packet, const Client& player);
   bool SyncCodes();
   void CheckSyncAndStartGame();
 
@@ -195,8 +203,13 @@ private:
     std::recursive_mutex players;
     std::recursive_mutex async_queue_write;
     std::recursive_mutex chunked_data_queue_write;
+    std::recursive_mutex block_sync_data;
   } m_crit;
 
+  // Save data whose blocks clients can request after receiving its manifest, indexed by the ID
+  // that was sent along with the manifest
+  std::vector<BlockSyncData> m_block_sync_data;
+
   Common::SPSCQueue<AsyncQueueEntry, false> m_async_queue;
   Common::SPSCQueue<ChunkedDataQueueEntry, false> m_chunked_data_queue;
 
@@ -203,7 +203,10 @@ void Interpreter::mtsr(Interpreter& interpreter, UGeckoInstruction inst)
 
   const u32 index = inst.SR;
   const u32 value = ppc_state.gpr[inst.RS];
+  const u32 old_value = ppc_state.sr[index];
   ppc_state.SetSR(index, value);
+  if (value != old_value)
+    interpreter.m_mmu.SRUpdated(index);
 }
 
 void Interpreter::mtsrin(Interpreter& interpreter, UGeckoInstruction inst)
@@ -217,7 +220,10 @@ void Interpreter::mtsrin(Interpreter& interpreter, UGeckoInstruction inst)
 
   const u32 index = (ppc_state.gpr[inst.RB] >> 28) & 0xF;
   const u32 value = ppc_state.gpr[inst.RS];
+  const u32 old_value = ppc_state.sr[index];
   ppc_state.SetSR(index, value);
+  if (value != old_value)
+    interpreter.m_mmu.SRUpdated(index);
 }
 
 void Interpreter::mftb(Interpreter& interpreter, UGeckoInstruction inst)
@@ -103,7 +103,7 @@ FixupBranch EmuCodeBlock::BATAddressLookup(X64Reg addr, X64Reg tmp, const void*
 }
 
 FixupBranch EmuCodeBlock::CheckIfSafeAddress(const OpArg& reg_value, X64Reg reg_addr,
-                                             BitSet32 registers_in_use)
+                                             int access_size, BitSet32 registers_in_use)
 {
   registers_in_use[reg_addr] = true;
   if (reg_value.IsSimpleReg())
@@ -118,17 +118,54 @@ FixupBranch EmuCodeBlock::CheckIfSafeAddress(const OpArg& reg_value, X64Reg reg_
   if (reg_addr != RSCRATCH_EXTRA)
     MOV(32, R(RSCRATCH_EXTRA), R(reg_addr));
 
-  // Perform lookup to see if we can use fast path.
+  // Perform lookup to see if we can use fast path. The carry flag gets set if we can.
   MOV(64, R(RSCRATCH), ImmPtr(m_jit.m_mmu.GetDBATTable().data()));
   SHR(32, R(RSCRATCH_EXTRA), Imm8(PowerPC::BAT_INDEX_SHIFT));
-  TEST(32, MComplex(RSCRATCH, RSCRATCH_EXTRA, SCALE_4, 0), Imm32(PowerPC::BAT_PHYSICAL_BIT));
+  BT(32, MComplex(RSCRATCH, RSCRATCH_EXTRA, SCALE_4, 0),
+     Imm8(MathUtil::IntLog2(PowerPC::BAT_PHYSICAL_BIT)));
+
+  if (m_jit.jo.fastmem_tlb)
+  {
+    // If there's no BAT mapping, check whether the page is mapped through the page table. The tag
+    // is computed from the last byte of the access, so accesses that cross into another page miss.
+    FixupBranch bat_hit = J_CC(CC_C);
+
+    // If reg_addr is one of the scratch registers, it has been clobbered, but it was also pushed
+    OpArg address = R(reg_addr);
+    if (reg_addr == RSCRATCH_EXTRA)
+      address = MatR(RSP);
+    else if (reg_addr == RSCRATCH)
+      address = MDisp(RSP, registers_in_use[RSCRATCH_EXTRA] ? 8 : 0);
+
+    MOV(32, R(RSCRATCH_EXTRA), address);
+    SHR(32, R(RSCRATCH_EXTRA), Imm8(PowerPC::HW_PAGE_INDEX_SHIFT));
+    AND(32, R(RSCRATCH_EXTRA), Imm32(PowerPC::FASTMEM_TLB_SETS - 1));
+    MOV(32, R(RSCRATCH), address);
+    if (access_size > 8)
+      ADD(32, R(RSCRATCH), Imm8(access_size / 8 - 1));
+    OR(32, R(RSCRATCH), Imm32(PowerPC::HW_PAGE_MASK));
+
+    static_assert(PowerPC::FASTMEM_TLB_WAYS == 2);
+    const int way0_offset = PPCSTATE_OFF(fastmem_tlb);
+    const int way1_offset = way0_offset + static_cast<int>(sizeof(u32));
+    CMP(32, R(RSCRATCH), MComplex(RPPCSTATE, RSCRATCH_EXTRA, SCALE_8, way0_offset));
+    FixupBranch way0_hit = J_CC(CC_E);
+    XOR(32, R(RSCRATCH), MComplex(RPPCSTATE, RSCRATCH_EXTRA, SCALE_8, way1_offset));
+    // Sets the carry flag if RSCRATCH is 0
+    CMP(32, R(RSCRATCH), Imm8(1));
+    FixupBranch way1_checked = J();
+    SetJumpTarget(way0_hit);
+    STC();
+    SetJumpTarget(way1_checked);
+    SetJumpTarget(bat_hit);
+  }
 
   if (registers_in_use[RSCRATCH_EXTRA])
     POP(RSCRATCH_EXTRA);
   if (registers_in_use[RSCRATCH])
     POP(RSCRATCH);
 
-  return J_CC(CC_Z, m_far_code.Enabled() ? Jump::Near : Jump::Short);
+  return J_CC(CC_NC, m_far_code.Enabled() ? Jump::Near : Jump::Short);
 }
 
 void EmuCodeBlock::UnsafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int accessSize, s32 offset,
@@ -377,7 +414,7 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
       !force_slow_access && dr_set && m_jit.jo.fastmem_arena && !m_jit.m_ppc_state.m_enable_dcache;
   if (fast_check_address)
   {
-    FixupBranch slow = CheckIfSafeAddress(R(reg_value), reg_addr, registersInUse);
+    FixupBranch slow = CheckIfSafeAddress(R(reg_value), reg_addr, accessSize, registersInUse);
     UnsafeLoadToReg(reg_value, R(reg_addr), accessSize, 0, signExtend);
     if (m_far_code.Enabled())
       SwitchToFarCode();
@@ -551,7 +588,7 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
       !force_slow_access && dr_set && m_jit.jo.fastmem_arena && !m_jit.m_ppc_state.m_enable_dcache;
   if (fast_check_address)
   {
-    FixupBranch slow = CheckIfSafeAddress(reg_value, reg_addr, registersInUse);
+    FixupBranch slow = CheckIfSafeAddress(reg_value, reg_addr, accessSize, registersInUse);
     UnsafeWriteRegToReg(reg_value, reg_addr, accessSize, 0, swap);
     if (m_far_code.Enabled())
       SwitchToFarCode();
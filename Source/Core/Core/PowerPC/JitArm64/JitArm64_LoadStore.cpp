@@ -4,6 +4,7 @@
 #include "Core/PowerPC/JitArm64/Jit.h"
 
 #include <bit>
+#include <optional>
 
 #include "Common/Arm64Emitter.h"
 #include "Common/BitSet.h"
@@ -356,8 +357,8 @@ FixupBranch JitArm64::BATAddressLookup(ARM64Reg addr_out, ARM64Reg addr_in, ARM6
   return fail;
 }
 
-FixupBranch JitArm64::CheckIfSafeAddress(Arm64Gen::ARM64Reg addr, Arm64Gen::ARM64Reg tmp1,
-                                         Arm64Gen::ARM64Reg tmp2)
+FixupBranch JitArm64::CheckIfSafeAddress(Arm64Gen::ARM64Reg addr, u32 access_size,
+                                         Arm64Gen::ARM64Reg tmp1, Arm64Gen::ARM64Reg tmp2)
 {
   tmp2 = EncodeRegTo64(tmp2);
 
@@ -365,8 +366,40 @@ FixupBranch JitArm64::CheckIfSafeAddress(Arm64Gen::ARM64Reg addr, Arm64Gen::ARM6
   LSR(tmp1, addr, PowerPC::BAT_INDEX_SHIFT);
   LDR(tmp1, tmp2, ArithOption(tmp1, true));
   FixupBranch pass = TBNZ(tmp1, MathUtil::IntLog2(PowerPC::BAT_PHYSICAL_BIT));
+
+  std::optional<FixupBranch> pass_tlb_way0;
+  std::optional<FixupBranch> pass_tlb_way1;
+  if (jo.fastmem_tlb)
+  {
+    // If there's no BAT mapping, check whether the page is mapped through the page table. The tag
+    // is computed from the last byte of the access, so accesses that cross into another page miss.
+    // Both ways of the set are loaded at once, with way 0 in the low word.
+    static_assert(PowerPC::FASTMEM_TLB_WAYS == 2);
+    MOVP2R(tmp2, m_ppc_state.fastmem_tlb.data());
+    UBFX(tmp1, addr, PowerPC::HW_PAGE_INDEX_SHIFT, MathUtil::IntLog2(PowerPC::FASTMEM_TLB_SETS));
+    LDR(EncodeRegTo64(tmp1), tmp2, ArithOption(EncodeRegTo64(tmp1), true));
+    if (access_size > 8)
+    {
+      ADD(EncodeRegTo32(tmp2), addr, access_size / 8 - 1);
+      ORR(EncodeRegTo32(tmp2), EncodeRegTo32(tmp2),
+          LogicalImm(PowerPC::HW_PAGE_MASK, GPRSize::B32));
+    }
+    else
+    {
+      ORR(EncodeRegTo32(tmp2), addr, LogicalImm(PowerPC::HW_PAGE_MASK, GPRSize::B32));
+    }
+    CMP(EncodeRegTo32(tmp1), EncodeRegTo32(tmp2));
+    pass_tlb_way0 = B(CC_EQ);
+    CMP(tmp2, EncodeRegTo64(tmp1), ArithOption(EncodeRegTo64(tmp1), ShiftType::LSR, 32));
+    pass_tlb_way1 = B(CC_EQ);
+  }
+
   FixupBranch fail = B();
   SetJumpTarget(pass);
+  if (pass_tlb_way0)
+    SetJumpTarget(*pass_tlb_way0);
+  if (pass_tlb_way1)
+    SetJumpTarget(*pass_tlb_way1);
   return fail;
 }
 
@@ -167,6 +167,8 @@ void JitArm64::mtsr(UGeckoInstruction inst)
 {
   INSTRUCTION_START
   JITDISABLE(bJITSystemRegistersOff);
+  // The interpreter removes the segment's pages from the fastmem TLB
+  FALLBACK_IF(jo.fastmem_tlb);
 
   STR(IndexType::Unsigned, gpr.R(inst.RS), PPC_REG, PPCSTATE_OFF_SR(inst.SR));
 }
@@ -193,6 +195,7 @@ void JitArm64::mtsrin(UGeckoInstruction inst)
 {
   INSTRUCTION_START
   JITDISABLE(bJITSystemRegistersOff);
+  FALLBACK_IF(jo.fastmem_tlb);
 
   u32 b = inst.RB, d = inst.RD;
   gpr.BindToRegister(d, d == b);
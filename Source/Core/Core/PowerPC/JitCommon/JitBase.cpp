@@ -146,6 +146,7 @@ void JitBase::InitFastmemArena()
 {
   auto& memory = m_system.GetMemory();
   jo.fastmem_arena = Config::Get(Config::MAIN_FASTMEM_ARENA) && memory.InitFastmemArena();
+  jo.fastmem_tlb = jo.fastmem_arena && m_system.IsMMUMode() && memory.CanMapLogicalPages();
 }
 
 void JitBase::InitBLROptimization()
@@ -86,6 +86,8 @@ protected:
     bool accurateSinglePrecision;
     bool fastmem;
     bool fastmem_arena;
+    // Whether fast accesses can be used for pages in PowerPCState::fastmem_tlb
+    bool fastmem_tlb;
     bool memcheck;
     bool fp_exceptions;
     bool div_by_zero_exceptions;
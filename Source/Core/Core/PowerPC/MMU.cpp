@@ -25,6 +25,7 @@
 
 #include "Core/PowerPC/MMU.h"
 
+#include <algorithm>
 #include <bit>
 #include <cstddef>
 #include <cstring>
@@ -1335,7 +1336,7 @@ enum class TLBLookupResult
 
 static TLBLookupResult LookupTLBPageAddress(PowerPC::PowerPCState& ppc_state,
                                             const XCheckTLBFlag flag, const u32 vpa, const u32 vsid,
-                                            u32* paddr, bool* wi)
+                                            u32* paddr, bool* wi, u32* pte)
 {
   const u32 tag = vpa >> HW_PAGE_INDEX_SHIFT;
   const size_t tlb_index = IsOpcodeFlag(flag) ? PowerPC::INST_TLB_INDEX : PowerPC::DATA_TLB_INDEX;
@@ -1361,6 +1362,7 @@ static TLBLookupResult LookupTLBPageAddress(PowerPC::PowerPCState& ppc_state,
 
     *paddr = tlbe.paddr[0] | (vpa & 0xfff);
     *wi = (pte2.WIMG & 0b1100) != 0;
+    *pte = pte2.Hex;
 
     return TLBLookupResult::Found;
   }
@@ -1384,27 +1386,31 @@ static TLBLookupResult LookupTLBPageAddress(PowerPC::PowerPCState& ppc_state,
 
     *paddr = tlbe.paddr[1] | (vpa & 0xfff);
     *wi = (pte2.WIMG & 0b1100) != 0;
+    *pte = pte2.Hex;
 
     return TLBLookupResult::Found;
   }
   return TLBLookupResult::NotFound;
 }
 
-static void UpdateTLBEntry(PowerPC::PowerPCState& ppc_state, const XCheckTLBFlag flag, UPTE_Hi pte2,
-                           const u32 address, const u32 vsid)
+// Returns the tag of the entry that was replaced
+static u32 UpdateTLBEntry(PowerPC::PowerPCState& ppc_state, const XCheckTLBFlag flag, UPTE_Hi pte2,
+                          const u32 address, const u32 vsid)
 {
   if (IsNoExceptionFlag(flag))
-    return;
+    return TLBEntry::INVALID_TAG;
 
   const u32 tag = address >> HW_PAGE_INDEX_SHIFT;
   const size_t tlb_index = IsOpcodeFlag(flag) ? PowerPC::INST_TLB_INDEX : PowerPC::DATA_TLB_INDEX;
   TLBEntry& tlbe = ppc_state.tlb[tlb_index][tag & HW_PAGE_INDEX_MASK];
   const u32 index = tlbe.recent == 0 && tlbe.tag[0] != TLBEntry::INVALID_TAG;
+  const u32 replaced_tag = tlbe.tag[index];
   tlbe.recent = index;
   tlbe.paddr[index] = pte2.RPN << HW_PAGE_INDEX_SHIFT;
   tlbe.pte[index] = pte2.Hex;
   tlbe.tag[index] = tag;
   tlbe.vsid[index] = vsid;
+  return replaced_tag;
 }
 
 void MMU::InvalidateTLBEntry(u32 address)
@@ -1413,6 +1419,93 @@ void MMU::InvalidateTLBEntry(u32 address)
 
   m_ppc_state.tlb[PowerPC::DATA_TLB_INDEX][entry_index].Invalidate();
   m_ppc_state.tlb[PowerPC::INST_TLB_INDEX][entry_index].Invalidate();
+
+  // tlbie invalidates all entries with the same index, regardless of the rest of the address.
+  // Software relies on this to flush the whole TLB with one tlbie per index.
+  for (size_t i = entry_index; i < PowerPC::FASTMEM_TLB_SETS; i += HW_PAGE_INDEX_MASK + 1)
+  {
+    for (u32& entry : m_ppc_state.fastmem_tlb[i])
+      UnmapFastmemTLBEntry(entry);
+  }
+}
+
+void MMU::SRUpdated(u32 index)
+{
+  // Unlike the real TLB, the fastmem TLB isn't tagged with the VSID.
+  for (auto& set : m_ppc_state.fastmem_tlb)
+  {
+    for (u32& entry : set)
+    {
+      if (entry >> 28 == index)
+        UnmapFastmemTLBEntry(entry);
+    }
+  }
+}
+
+// Fast accesses can't set the R and C bits of the PTE, so pages are only added once both are set.
+// (R is always set for pages in the TLB.) Software has to invalidate the TLB entry when clearing
+// them, which also removes the page from the fastmem TLB. Uncached pages aren't added for the same
+// reasons as with BATs.
+static bool CanAddToFastmemTLB(const UPTE_Hi& pte2)
+{
+  return pte2.C != 0 && (pte2.WIMG & 0b1100) == 0;
+}
+
+void MMU::AddFastmemTLBEntry(u32 effective_address, u32 physical_address)
+{
+  auto& set = m_ppc_state.fastmem_tlb[(effective_address >> HW_PAGE_INDEX_SHIFT) &
+                                      (PowerPC::FASTMEM_TLB_SETS - 1)];
+  const u32 tag = effective_address | HW_PAGE_MASK;
+  if (std::ranges::find(set, tag) != set.end() || !m_memory.CanMapLogicalPages())
+    return;
+
+  const u32 logical_page = effective_address & ~HW_PAGE_MASK;
+  const u32 physical_page = physical_address & ~HW_PAGE_MASK;
+  if (!IsFastmemMappable(physical_page) ||
+      m_power_pc.GetMemChecks().OverlapsMemcheck(logical_page, HW_PAGE_SIZE))
+  {
+    return;
+  }
+
+  // Only pages that are in the data TLB get here, so there is normally a free way. The set can
+  // still be full if the data TLB was reset without going through the MMU.
+  auto way = std::ranges::find(set, 0u);
+  if (way == set.end())
+  {
+    way = set.begin();
+    UnmapFastmemTLBEntry(*way);
+  }
+
+  if (m_memory.MapLogicalPage(logical_page, physical_page))
+    *way = tag;
+}
+
+void MMU::RemoveFastmemTLBEntry(u32 effective_address)
+{
+  auto& set = m_ppc_state.fastmem_tlb[(effective_address >> HW_PAGE_INDEX_SHIFT) &
+                                      (PowerPC::FASTMEM_TLB_SETS - 1)];
+  const u32 tag = effective_address | HW_PAGE_MASK;
+  const auto way = std::ranges::find(set, tag);
+  if (way != set.end())
+    UnmapFastmemTLBEntry(*way);
+}
+
+void MMU::UnmapFastmemTLBEntry(u32& entry)
+{
+  if (entry == 0)
+    return;
+
+  m_memory.UnmapLogicalPage(entry & ~HW_PAGE_MASK);
+  entry = 0;
+}
+
+void MMU::ClearFastmemTLB()
+{
+  for (auto& set : m_ppc_state.fastmem_tlb)
+  {
+    for (u32& entry : set)
+      UnmapFastmemTLBEntry(entry);
+  }
 }
 
 // Page Address Translation
@@ -1426,10 +1519,17 @@ MMU::TranslateAddressResult MMU::TranslatePageAddress(const EffectiveAddress add
   // This catches 99%+ of lookups in practice, so the actual page table entry code below doesn't
   // benefit much from optimization.
   u32 translated_address = 0;
-  const TLBLookupResult res =
-      LookupTLBPageAddress(m_ppc_state, flag, address.Hex, VSID, &translated_address, wi);
+  u32 tlb_pte2 = 0;
+  const TLBLookupResult res = LookupTLBPageAddress(m_ppc_state, flag, address.Hex, VSID,
+                                                   &translated_address, wi, &tlb_pte2);
   if (res == TLBLookupResult::Found)
   {
+    if constexpr (flag == XCheckTLBFlag::Read || flag == XCheckTLBFlag::Write)
+    {
+      if (CanAddToFastmemTLB(UPTE_Hi{tlb_pte2}))
+        AddFastmemTLBEntry(address.Hex, translated_address);
+    }
+
     return TranslateAddressResult{TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED,
                                   translated_address};
   }
@@ -1503,10 +1603,28 @@ MMU::TranslateAddressResult MMU::TranslatePageAddress(const EffectiveAddress add
 
         // We already updated the TLB entry if this was caused by a C bit.
         if (res != TLBLookupResult::UpdateC)
-          UpdateTLBEntry(m_ppc_state, flag, pte2, address.Hex, VSID);
+        {
+          const u32 replaced_tag = UpdateTLBEntry(m_ppc_state, flag, pte2, address.Hex, VSID);
+
+          // Keep the fastmem TLB a subset of the data TLB
+          if constexpr (flag == XCheckTLBFlag::Read || flag == XCheckTLBFlag::Write)
+          {
+            if (replaced_tag != TLBEntry::INVALID_TAG &&
+                replaced_tag != address.Hex >> HW_PAGE_INDEX_SHIFT)
+            {
+              RemoveFastmemTLBEntry(replaced_tag << HW_PAGE_INDEX_SHIFT);
+            }
+          }
+        }
 
         *wi = (pte2.WIMG & 0b1100) != 0;
 
+        if constexpr (flag == XCheckTLBFlag::Read || flag == XCheckTLBFlag::Write)
+        {
+          if (CanAddToFastmemTLB(pte2))
+            AddFastmemTLBEntry(address.Hex, (pte2.RPN << 12) | offset);
+        }
+
         return TranslateAddressResult{TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED,
                                       (pte2.RPN << 12) | offset};
       }
@@ -1574,27 +1692,8 @@ void MMU::UpdateBATs(BatTable& bat_table, u32 base_spr)
         // Enable fastmem mappings for cached memory. There are quirks related to uncached memory
         // that can't be correctly emulated by fast accesses, so we don't map uncached memory.
         // (No normal games are known to rely on the quirks, though.)
-        if (!wi)
-        {
-          if (m_memory.GetFakeVMEM() && (physical_address & 0xFE000000) == 0x7E000000)
-          {
-            valid_bit |= BAT_PHYSICAL_BIT;
-          }
-          else if (physical_address < m_memory.GetRamSizeReal())
-          {
-            valid_bit |= BAT_PHYSICAL_BIT;
-          }
-          else if (m_memory.GetEXRAM() && physical_address >> 28 == 0x1 &&
-                   (physical_address & 0x0FFFFFFF) < m_memory.GetExRamSizeReal())
-          {
-            valid_bit |= BAT_PHYSICAL_BIT;
-          }
-          else if (physical_address >> 28 == 0xE &&
-                   physical_address < 0xE0000000 + m_memory.GetL1CacheSize())
-          {
-            valid_bit |= BAT_PHYSICAL_BIT;
-          }
-        }
+        if (!wi && IsFastmemMappable(physical_address))
+          valid_bit |= BAT_PHYSICAL_BIT;
 
         // Fast accesses don't support memchecks, so force slow accesses by removing fastmem
         // mappings for all overlapping virtual pages.
@@ -1608,6 +1707,24 @@ void MMU::UpdateBATs(BatTable& bat_table, u32 base_spr)
   }
 }
 
+bool MMU::IsFastmemMappable(u32 physical_address) const
+{
+  if (m_memory.GetFakeVMEM() && (physical_address & 0xFE000000) == 0x7E000000)
+    return true;
+
+  if (physical_address < m_memory.GetRamSizeReal())
+    return true;
+
+  if (m_memory.GetEXRAM() && physical_address >> 28 == 0x1 &&
+      (physical_address & 0x0FFFFFFF) < m_memory.GetExRamSizeReal())
+  {
+    return true;
+  }
+
+  return physical_address >> 28 == 0xE &&
+         physical_address < 0xE0000000 + m_memory.GetL1CacheSize();
+}
+
 void MMU::UpdateFakeMMUBat(BatTable& bat_table, u32 start_addr)
 {
   for (u32 i = 0; i < (0x10000000 >> BAT_INDEX_SHIFT); ++i)
@@ -1627,6 +1744,10 @@ void MMU::UpdateFakeMMUBat(BatTable& bat_table, u32 start_addr)
 
 void MMU::DBATUpdated()
 {
+  // Pages that are translated through the page table may now be covered by a BAT, and the
+  // memchecks may have changed.
+  ClearFastmemTLB();
+
   m_dbat_table = {};
   UpdateBATs(m_dbat_table, SPR_DBAT0U);
   bool extended_bats = m_system.IsWii() && HID4(m_ppc_state).SBE;
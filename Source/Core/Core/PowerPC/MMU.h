@@ -239,6 +239,7 @@ public:
   // TLB functions
   void SDRUpdated();
   void InvalidateTLBEntry(u32 address);
+  void SRUpdated(u32 index);
   void DBATUpdated();
   void IBATUpdated();
 
@@ -304,6 +305,12 @@ private:
 
   void UpdateBATs(BatTable& bat_table, u32 base_spr);
   void UpdateFakeMMUBat(BatTable& bat_table, u32 start_addr);
+  bool IsFastmemMappable(u32 physical_address) const;
+
+  void AddFastmemTLBEntry(u32 effective_address, u32 physical_address);
+  void RemoveFastmemTLBEntry(u32 effective_address);
+  void UnmapFastmemTLBEntry(u32& entry);
+  void ClearFastmemTLB();
 
   template <XCheckTLBFlag flag, typename T, bool never_translate = false>
   T ReadFromHardware(u32 em_address);
@@ -737,55 +737,121 @@ void PPCAnalyzer::SetInstructionStats(CodeBlock* block, CodeOp* code,
   }
 }
 
+// Returns whether executing the instruction again, with the same inputs, has no further effect.
+// Cache management and synchronization instructions are common in loops that poll memory which
+// hardware writes to with DMA.
+static bool IsRepeatableSystemInstruction(UGeckoInstruction inst)
+{
+  if (inst.OPCD == 19)
+    return inst.SUBOP10 == 0 || inst.SUBOP10 == 150;  // mcrf, isync
+
+  if (inst.OPCD != 31)
+    return false;
+
+  switch (inst.SUBOP10)
+  {
+  case 54:   // dcbst
+  case 86:   // dcbf
+  case 246:  // dcbtst
+  case 278:  // dcbt
+  case 470:  // dcbi
+  case 598:  // sync
+  case 854:  // eieio
+    return true;
+  default:
+    return false;
+  }
+}
+
 bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions) const
 {
-  // Very basic algorithm to detect busy wait loops:
-  //   * It loops to itself and does not contain any other branches.
+  // Detects loops which, once they have run, will keep running the exact same way until something
+  // outside the CPU changes memory or an MMIO register, which only happens in CoreTiming events
+  // (or on the GPU thread, which Idle() syncs with if SyncOnSkipIdle is enabled):
+  //   * It loops to itself and does not use CTR.
   //   * It does not write to memory.
-  //   * It only reads from registers it wrote to earlier in the loop, or it
-  //     does not write to these registers.
+  //   * Every instruction computes the same result in every iteration: it only reads registers,
+  //     CR fields, the carry flag and the FPSCR status bits that it wrote to earlier in the loop,
+  //     or that the loop does not write to at all.
+  //   * It does not set XER[OV] or XER[SO].
+  //   * Apart from loads and computations, it only contains instructions that have no further
+  //     effect when repeated, like cache invalidation and synchronization.
   //
-  // Would benefit a lot from basic inlining support - a lot of the most
-  // used busy loops are DSP register interactions, which are bl/cmp/bne
-  // (with the bl target a pure function that follows the above rules). We
-  // don't detect these at the moment.
-  std::bitset<32> write_disallowed_regs;
-  std::bitset<32> written_regs;
+  // When branch following is enabled, followed calls are part of the block, so this also covers
+  // loops that call a pure leaf function, such as the bl/cmp/bne loops that poll DSP mailboxes.
+  BitSet32 write_disallowed_regs;
+  BitSet32 written_regs;
+  BitSet32 write_disallowed_fregs;
+  BitSet32 written_fregs;
+  BitSet8 write_disallowed_crs;
+  BitSet8 written_crs;
+  bool write_disallowed_ca = false;
+  bool written_ca = false;
+  bool write_disallowed_fpscr = false;
+  bool written_fpscr = false;
+
   for (size_t i = 0; i <= instructions; ++i)
   {
-    if (code[i].opinfo->type == OpType::Branch)
+    const CodeOp& op = code[i];
+    if (op.opinfo->type == OpType::Branch)
     {
-      if (code[i].branchUsesCtr)
+      if (op.branchUsesCtr)
         return false;
-      if (code[i].branchTo == block->m_address && i == instructions)
+      if (op.branchTo == block->m_address && i == instructions)
         return true;
+      continue;
     }
-    else if (code[i].opinfo->type != OpType::Integer && code[i].opinfo->type != OpType::Load)
+
+    switch (op.opinfo->type)
     {
-      // In the future, some subsets of other instruction types might get
-      // supported. Right now, only try loops that have this very
-      // restricted instruction set.
-      return false;
+    case OpType::Integer:
+    case OpType::CR:
+    case OpType::Load:
+    case OpType::LoadFP:
+    case OpType::LoadPS:
+    case OpType::SingleFP:
+    case OpType::DoubleFP:
+    case OpType::PS:
+      break;
+    default:
+      if (!IsRepeatableSystemInstruction(op.inst))
+        return false;
+      break;
     }
-    else
+
+    // SO is sticky and gets copied into CR0 by every compare and record form, so the first
+    // overflow would change what later iterations compute. Overflow-enabled forms are rare enough
+    // that they aren't worth tracking.
+    if (op.opinfo->flags & FL_SET_OE)
+      return false;
+
+    // Floating point arithmetic sets the FPRF and the sticky exception bits, and record forms then
+    // copy the exception summary bits into CR1. fcmpo/fcmpu are flagged as reading the FPRF, but
+    // only so that the JITs don't discard it, so they count as writes only. Instructions that move
+    // to or from the FPSCR are SystemFP and have already been rejected above.
+    const bool reads_fpscr = (op.opinfo->flags & FL_RC_BIT_F) && op.inst.Rc;
+    const bool writes_fpscr = op.outputFPRF || (op.opinfo->flags & FL_FLOAT_EXCEPTION);
+
+    write_disallowed_regs |= op.regsIn & ~written_regs;
+    write_disallowed_fregs |= op.fregsIn & ~written_fregs;
+    write_disallowed_crs |= op.crIn & ~written_crs;
+    write_disallowed_ca |= op.wantsCA && !written_ca;
+    write_disallowed_fpscr |= reads_fpscr && !written_fpscr && !writes_fpscr;
+
+    if ((op.regsOut & write_disallowed_regs) ||
+        (op.fregOut >= 0 && write_disallowed_fregs[op.fregOut]) ||
+        (op.crOut & write_disallowed_crs) || (op.outputCA && write_disallowed_ca) ||
+        (writes_fpscr && write_disallowed_fpscr))
     {
-      for (int reg : code[i].regsIn)
-      {
-        if (reg == -1)
-          continue;
-        if (written_regs[reg])
-          continue;
-        write_disallowed_regs[reg] = true;
-      }
-      for (int reg : code[i].regsOut)
-      {
-        if (reg == -1)
-          continue;
-        if (write_disallowed_regs[reg])
-          return false;
-        written_regs[reg] = true;
-      }
+      return false;
     }
+
+    written_regs |= op.regsOut;
+    if (op.fregOut >= 0)
+      written_fregs[op.fregOut] = true;
+    written_crs |= op.crOut;
+    written_ca |= op.outputCA;
+    written_fpscr |= writes_fpscr;
   }
   return false;
 }
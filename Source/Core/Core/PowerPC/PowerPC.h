@@ -68,6 +68,14 @@ struct TLBEntry
   void Invalidate() { tag.fill(INVALID_TAG); }
 };
 
+// Data pages translated through the page table that are mapped into the logical fastmem arena.
+// Set-associative and indexed by the low bits of the page number, so that JIT code can look pages
+// up inline. Each entry is the effective address of the page with the offset bits set, or 0 if the
+// entry is unused. Pages are removed when they leave the data TLB, which has as many ways and
+// fewer sets, so a set normally always has room for a page that is in the data TLB.
+constexpr size_t FASTMEM_TLB_SETS = 1024;
+constexpr size_t FASTMEM_TLB_WAYS = TLB_WAYS;
+
 struct PairedSingle
 {
   u64 PS0AsU64() const { return ps0; }
@@ -177,6 +185,9 @@ struct PowerPCState
 
   std::array<std::array<TLBEntry, TLB_SIZE / TLB_WAYS>, NUM_TLBS> tlb;
 
+  // Not part of savestates. This only reflects mappings that currently exist in the host's memory.
+  std::array<std::array<u32, FASTMEM_TLB_WAYS>, FASTMEM_TLB_SETS> fastmem_tlb{};
+
   u32 pagetable_base = 0;
   u32 pagetable_hashmask = 0;
 
@@ -0,0 +1,232 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/RewindBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <lz4.h>
+
+#include "Common/Assert.h"
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+#include "Core/State.h"
+
+namespace State
+{
+RewindBuffer::RewindBuffer(size_t memory_budget, size_t keyframe_interval)
+    : m_memory_budget(memory_budget), m_keyframe_interval(std::max<size_t>(keyframe_interval, 1))
+{
+}
+
+size_t RewindBuffer::Entry::GetMemoryUsage() const
+{
+  return sizeof(Entry) + data.capacity() + changed_pages.capacity() * sizeof(u32);
+}
+
+void RewindBuffer::SetMemoryBudget(size_t memory_budget)
+{
+  m_memory_budget = memory_budget;
+  EvictOldEntries();
+}
+
+void RewindBuffer::Add(const std::vector<u8>& state, u64 frame)
+{
+  if (state.size() > LZ4_MAX_INPUT_SIZE)
+  {
+    ERROR_LOG_FMT(CORE, "State is too large for the rewind buffer ({} bytes)", state.size());
+    return;
+  }
+
+  Entry entry;
+  entry.frame = frame;
+  entry.size = state.size();
+
+  bool keyframe =
+      m_entries.empty() || m_entries.back().keyframe_distance + 1 >= m_keyframe_interval;
+
+  if (!keyframe)
+  {
+    std::vector<u8> delta;
+
+    const size_t num_pages = (state.size() + PAGE_SIZE - 1) / PAGE_SIZE;
+    for (size_t page = 0; page < num_pages; ++page)
+    {
+      const size_t offset = page * PAGE_SIZE;
+      const size_t page_size = std::min(PAGE_SIZE, state.size() - offset);
+
+      // Anything past the end of the keyframe is compared with zeroes
+      const size_t size_in_keyframe =
+          offset < m_keyframe.size() ? std::min(page_size, m_keyframe.size() - offset) : 0;
+
+      if (size_in_keyframe == page_size &&
+          std::memcmp(state.data() + offset, m_keyframe.data() + offset, page_size) == 0)
+      {
+        continue;
+      }
+
+      entry.changed_pages.push_back(static_cast<u32>(page));
+
+      const size_t delta_offset = delta.size();
+      delta.insert(delta.end(), state.begin() + offset, state.begin() + offset + page_size);
+      for (size_t i = 0; i < size_in_keyframe; ++i)
+        delta[delta_offset + i] ^= m_keyframe[offset + i];
+    }
+
+    // If most of the state has changed, a new keyframe costs about as much as a delta,
+    // and it makes the following deltas smaller
+    if (entry.changed_pages.size() * 2 > num_pages)
+    {
+      keyframe = true;
+    }
+    else
+    {
+      entry.keyframe_distance = m_entries.back().keyframe_distance + 1;
+      entry.changed_pages.shrink_to_fit();
+      if (!delta.empty())
+        entry.data = CompressLZ4Block(delta);
+    }
+  }
+
+  if (keyframe)
+  {
+    entry.keyframe_distance = 0;
+    entry.changed_pages = {};
+    entry.data = CompressLZ4Block(state);
+  }
+
+  if (entry.data.empty() && (keyframe || !entry.changed_pages.empty()))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to compress a state for the rewind buffer");
+    return;
+  }
+
+  // Copying into the existing allocation avoids allocating (and paging in) a new keyframe buffer
+  if (keyframe)
+    m_keyframe.assign(state.begin(), state.end());
+
+  m_memory_usage += entry.GetMemoryUsage();
+  m_entries.push_back(std::move(entry));
+
+  EvictOldEntries();
+}
+
+bool RewindBuffer::DecompressKeyframe(size_t index, std::vector<u8>* out) const
+{
+  const Entry& entry = m_entries[index];
+  ASSERT(entry.keyframe_distance == 0);
+
+  // The newest keyframe is already available uncompressed
+  if (index == m_entries.size() - 1 - m_entries.back().keyframe_distance)
+  {
+    out->assign(m_keyframe.begin(), m_keyframe.end());
+    return true;
+  }
+
+  return DecompressLZ4Block(entry.data, entry.size, out);
+}
+
+bool RewindBuffer::Restore(size_t steps_back, std::vector<u8>* state_out, u64* frame_out) const
+{
+  if (steps_back >= m_entries.size())
+    return false;
+
+  const size_t index = m_entries.size() - 1 - steps_back;
+  const Entry& entry = m_entries[index];
+
+  if (!DecompressKeyframe(index - entry.keyframe_distance, state_out))
+    return false;
+
+  if (entry.keyframe_distance != 0)
+  {
+    state_out->resize(entry.size);
+
+    if (!entry.changed_pages.empty())
+    {
+      // Only the last page of the state can be smaller than PAGE_SIZE
+      const size_t last_page_offset = static_cast<size_t>(entry.changed_pages.back()) * PAGE_SIZE;
+      const size_t last_page_size = std::min(PAGE_SIZE, entry.size - last_page_offset);
+      const size_t delta_size =
+          (entry.changed_pages.size() - 1) * PAGE_SIZE + last_page_size;
+
+      std::vector<u8> delta;
+      if (!DecompressLZ4Block(entry.data, delta_size, &delta))
+        return false;
+
+      const u8* delta_ptr = delta.data();
+      for (const u32 page : entry.changed_pages)
+      {
+        const size_t offset = static_cast<size_t>(page) * PAGE_SIZE;
+        const size_t page_size = std::min(PAGE_SIZE, entry.size - offset);
+
+        u8* out_ptr = state_out->data() + offset;
+        for (size_t i = 0; i < page_size; ++i)
+          out_ptr[i] ^= delta_ptr[i];
+
+        delta_ptr += page_size;
+      }
+    }
+  }
+
+  if (frame_out)
+    *frame_out = entry.frame;
+
+  return true;
+}
+
+void RewindBuffer::DiscardNewerThan(size_t steps_back)
+{
+  if (steps_back == 0)
+    return;
+
+  if (steps_back >= m_entries.size())
+  {
+    Clear();
+    return;
+  }
+
+  const bool newest_keyframe_discarded = m_entries.back().keyframe_distance < steps_back;
+
+  for (size_t i = 0; i < steps_back; ++i)
+  {
+    m_memory_usage -= m_entries.back().GetMemoryUsage();
+    m_entries.pop_back();
+  }
+
+  if (newest_keyframe_discarded)
+  {
+    const size_t index = m_entries.size() - 1 - m_entries.back().keyframe_distance;
+    if (!DecompressLZ4Block(m_entries[index].data, m_entries[index].size, &m_keyframe))
+    {
+      ERROR_LOG_FMT(CORE, "Failed to decompress a keyframe in the rewind buffer");
+      Clear();
+    }
+  }
+}
+
+void RewindBuffer::Clear()
+{
+  m_entries.clear();
+  m_keyframe = {};
+  m_memory_usage = 0;
+}
+
+void RewindBuffer::EvictOldEntries()
+{
+  // Entries can only be evicted together with the keyframe they depend on,
+  // and the newest keyframe is needed for adding new entries
+  while (!m_entries.empty() && GetMemoryUsage() > m_memory_budget &&
+         m_entries.back().keyframe_distance + 1 < m_entries.size())
+  {
+    do
+    {
+      m_memory_usage -= m_entries.front().GetMemoryUsage();
+      m_entries.pop_front();
+    } while (m_entries.front().keyframe_distance != 0);
+  }
+}
+
+}  // namespace State
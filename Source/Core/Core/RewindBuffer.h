@@ -0,0 +1,81 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace State
+{
+// Keeps savestates that were taken at regular intervals in memory, so that emulation can be
+// rewound to any of them.
+//
+// Every few entries store a full LZ4-compressed state (a keyframe). The entries in between only
+// store the pages that differ from the most recent keyframe, XORed with that keyframe and then
+// compressed, which makes them small since most of RAM doesn't change between frames. Restoring
+// any entry takes at most two decompressions. Once the memory budget is exceeded, the oldest
+// keyframe is dropped together with the entries that depend on it.
+//
+// This class is not thread-safe.
+class RewindBuffer
+{
+public:
+  static constexpr size_t PAGE_SIZE = 0x1000;
+  static constexpr size_t DEFAULT_KEYFRAME_INTERVAL = 16;
+
+  explicit RewindBuffer(size_t memory_budget,
+                        size_t keyframe_interval = DEFAULT_KEYFRAME_INTERVAL);
+
+  // Evicts old entries if they no longer fit. The newest keyframe is always kept.
+  void SetMemoryBudget(size_t memory_budget);
+
+  // Adds a state as the newest entry. frame is stored for display purposes only.
+  void Add(const std::vector<u8>& state, u64 frame);
+
+  // steps_back is 0 for the newest entry, 1 for the one before it, and so on.
+  // Returns false if there is no such entry.
+  bool Restore(size_t steps_back, std::vector<u8>* state_out, u64* frame_out = nullptr) const;
+
+  // Removes the entries that are newer than the given entry, e.g. after rewinding to it.
+  void DiscardNewerThan(size_t steps_back);
+
+  void Clear();
+
+  size_t GetSize() const { return m_entries.size(); }
+  bool IsEmpty() const { return m_entries.empty(); }
+
+  // Includes the uncompressed copy of the newest keyframe, which new entries are compared with
+  size_t GetMemoryUsage() const { return m_memory_usage + m_keyframe.capacity(); }
+
+private:
+  struct Entry
+  {
+    u64 frame = 0;
+    // Uncompressed size of the state
+    size_t size = 0;
+    // 0 for keyframes, otherwise the number of entries between this entry and its keyframe
+    size_t keyframe_distance = 0;
+    // Indices of the pages stored in data, for entries that aren't keyframes
+    std::vector<u32> changed_pages;
+    std::vector<u8> data;
+
+    size_t GetMemoryUsage() const;
+  };
+
+  bool DecompressKeyframe(size_t index, std::vector<u8>* out) const;
+  void EvictOldEntries();
+
+  std::deque<Entry> m_entries;
+  // The newest keyframe, uncompressed
+  std::vector<u8> m_keyframe;
+
+  size_t m_memory_budget;
+  size_t m_keyframe_interval;
+  size_t m_memory_usage = 0;
+};
+
+}  // namespace State
@@ -7,10 +7,12 @@
 #include <atomic>
 #include <condition_variable>
 #include <filesystem>
+#include <limits>
 #include <locale>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
 #include <thread>
 #include <utility>
@@ -21,6 +23,7 @@
 
 #include <lz4.h>
 #include <lzo/lzo1x.h>
+#include <zstd.h>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -28,6 +31,9 @@
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/MsgHandler.h"
+#include "Common/ParallelFor.h"
+#include "Common/Random.h"
+#include "Common/ScopeGuard.h"
 #include "Common/Thread.h"
 #include "Common/TimeUtil.h"
 #include "Common/Timer.h"
@@ -36,10 +42,14 @@
 
 #include "Core/AchievementManager.h"
 #include "Core/Config/AchievementSettings.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
+#include "Core/DSPEmulator.h"
 #include "Core/GeckoCode.h"
+#include "Core/HW/CPU.h"
+#include "Core/HW/DSP.h"
 #include "Core/HW/HW.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/Wiimote.h"
@@ -47,8 +57,10 @@
 #include "Core/Movie.h"
 #include "Core/NetPlayClient.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/RewindBuffer.h"
 #include "Core/System.h"
 
+#include "VideoCommon/Fifo.h"
 #include "VideoCommon/FrameDumpFFMpeg.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -79,9 +91,23 @@ struct CompressAndDumpState_args
 {
   std::vector<u8> buffer_vector;
   std::string filename;
+  CompressionType compression_type = CompressionType::Uncompressed;
+  int compression_level = 0;
+  StateExtendedIncrementalHeader incremental_header{};
+  std::string base_filename;
   std::shared_ptr<Common::Event> state_write_done_event;
 };
 
+// The state that incremental states are currently saved relative to. Its memory is what
+// MemoryManager's dirty page base was set for.
+struct IncrementalBase
+{
+  std::string filename;
+  u64 state_id = 0;
+};
+static std::mutex s_incremental_base_mutex;
+static IncrementalBase s_incremental_base;
+
 // Protects against simultaneous reads and writes to the final savestate location from multiple
 // threads.
 static std::mutex s_save_thread_mutex;
@@ -89,6 +115,21 @@ static std::mutex s_save_thread_mutex;
 // Queue for compressing and writing savestates to disk.
 static Common::WorkQueueThread<CompressAndDumpState_args> s_save_thread;
 
+// Invalidated whenever the emulation is rewound, so that rewind points that were captured before
+// that but are still being compressed are dropped
+static BackgroundStateSaver s_rewind_saver;
+static std::mutex s_rewind_buffer_mutex;
+static RewindBuffer s_rewind_buffer{0};
+// Only accessed on the CPU thread
+static u32 s_frames_since_rewind_point = 0;
+
+// A state sized buffer kept around between saves. Only one is kept, since holding on to more would
+// cost as much memory as another savestate.
+static std::mutex s_state_buffer_pool_mutex;
+static std::vector<u8> s_pooled_state_buffer;
+// Size of the last state saved, used as the initial buffer size for the next one
+static std::atomic<size_t> s_last_state_size{0};
+
 // Keeps track of savestate writes that are currently happening, so we don't load a state while
 // another one is still saving. This is particularly important so if you save to a slot and then
 // immediately load from the same one, you don't accidentally load the state that's still at that
@@ -98,16 +139,20 @@ static size_t s_state_writes_in_queue;
 static std::condition_variable s_state_write_queue_is_empty;
 
 // Don't forget to increase this after doing changes on the savestate system
-constexpr u32 STATE_VERSION = 169;  // Last changed in PR 13074
+constexpr u32 STATE_VERSION = 172;  // Last changed for DVDThread::ReadRequest
 
 // Increase this if the StateExtendedHeader definition changes
-constexpr u32 EXTENDED_HEADER_VERSION = 1;  // Last changed in PR 12217
+constexpr u32 EXTENDED_HEADER_VERSION = 2;  // Last changed for incremental states
 
 // Change this if we ever need to store more data in the extended header
 constexpr u32 COMPRESSED_DATA_OFFSET = 0;
 
 constexpr u32 COOKIE_BASE = 0xBAADBABE;
 
+// Uncompressed size of the chunks of chunked payloads. Large enough to compress well, and small
+// enough that even GameCube states have enough chunks to keep every CPU thread busy.
+constexpr u32 CHUNK_SIZE = 0x200000;
+
 // Maps savestate versions to Dolphin versions.
 // Versions after 42 don't need to be added to this list,
 // because they save the exact Dolphin version to savestates.
@@ -204,47 +249,268 @@ static void DoState(Core::System& system, PointerWrap& p)
 #endif  // USE_RETRO_ACHIEVEMENTS
 }
 
-void LoadFromBuffer(Core::System& system, std::vector<u8>& buffer)
+bool LoadFromBuffer(Core::System& system, std::vector<u8>& buffer)
 {
   if (NetPlay::IsNetPlayRunning())
   {
     OSD::AddMessage("Loading savestates is disabled in Netplay to prevent desyncs");
-    return;
+    return false;
   }
 
   if (AchievementManager::GetInstance().IsHardcoreModeActive())
   {
     OSD::AddMessage("Loading savestates is disabled in RetroAchievements hardcore mode");
-    return;
+    return false;
   }
 
+  bool success = false;
   Core::RunOnCPUThread(
       system,
       [&] {
         u8* ptr = buffer.data();
         PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
         DoState(system, p);
+        success = p.IsReadMode();
       },
       true);
+  return success;
+}
+
+// Must be called on the CPU thread. Returns false if the state couldn't be saved.
+//
+// The size of a state rarely changes much between saves, so instead of measuring the state first,
+// it's written directly to a buffer a bit larger than the previous state. If that's too small,
+// PointerWrap switches to measure mode once it reaches the end of the buffer, so the first pass
+// still tells how large the buffer needs to be for a second one.
+static bool SaveStateToBuffer(Core::System& system, std::vector<u8>& buffer)
+{
+  const size_t expected_size = std::max(buffer.size(), s_last_state_size.load());
+  for (size_t buffer_size = expected_size + expected_size / 16;;)
+  {
+    buffer.resize(buffer_size);
+
+    u8* ptr = buffer.data();
+    PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
+    DoState(system, p);
+
+    const size_t state_size = static_cast<size_t>(ptr - buffer.data());
+    if (p.IsWriteMode())
+    {
+      buffer.resize(state_size);
+      s_last_state_size.store(state_size);
+      return true;
+    }
+
+    // If the state didn't grow, something else aborted the save
+    if (state_size <= buffer_size)
+      return false;
+
+    buffer_size = state_size;
+  }
+}
+
+// Buffers are returned here once the state in them has been written, so that saving again doesn't
+// have to allocate a new buffer and page it in
+static std::vector<u8> TakeStateBuffer()
+{
+  std::lock_guard lk(s_state_buffer_pool_mutex);
+  return std::exchange(s_pooled_state_buffer, {});
+}
+
+static void ReturnStateBuffer(std::vector<u8> buffer)
+{
+  std::lock_guard lk(s_state_buffer_pool_mutex);
+  if (s_pooled_state_buffer.capacity() < buffer.capacity())
+    s_pooled_state_buffer = std::move(buffer);
+}
+
+bool SaveToBuffer(Core::System& system, std::vector<u8>& buffer)
+{
+  bool success = false;
+  Core::RunOnCPUThread(system, [&] { success = SaveStateToBuffer(system, buffer); }, true);
+  return success;
+}
+
+// Saves the state from the CPU thread while it keeps running, which has to happen at a point where
+// the state is consistent, like the end of CoreTiming::Advance. The DSP and GPU threads are still
+// stopped like Core::PauseAndLock does, so that their state matches what the CPU thread saves.
+static bool SaveStateToBufferWithoutPausing(Core::System& system, std::vector<u8>& buffer)
+{
+  DSPEmulator* dsp = system.GetDSP().GetDSPEmulator();
+  auto& fifo = system.GetFifo();
+  dsp->PauseAndLock(true);
+  fifo.PauseAndLock(true, false);
+
+  const bool success = SaveStateToBuffer(system, buffer);
+
+  // Another thread may have stopped emulation in the meantime, in which case the GPU thread has to
+  // stay paused
+  fifo.PauseAndLock(false, system.GetCPU().GetState() == CPU::State::Running);
+  dsp->PauseAndLock(false);
+  return success;
+}
+
+void BackgroundStateSaver::Reset(std::string_view name, Callback callback)
+{
+  m_pending.store(false);
+  m_thread.Reset(name, [this, callback = std::move(callback)](PendingState pending_state) {
+    callback(pending_state.state, pending_state.frame, pending_state.generation);
+    ReturnStateBuffer(std::move(pending_state.state));
+    m_pending.store(false);
+  });
+}
+
+void BackgroundStateSaver::Shutdown()
+{
+  m_thread.Shutdown(true);
+  m_pending.store(false);
+}
+
+bool BackgroundStateSaver::Request(Core::System& system)
+{
+  if (m_pending.exchange(true))
+    return false;
+
+  // We're in the middle of a CoreTiming event, which isn't a consistent point to save the state
+  // at, so the state is saved once the events are done. Pausing the CPU thread to save it from a
+  // CPU thread job would make emulation stutter every time.
+  system.GetCoreTiming().RunAfterAdvance([this, &system] {
+    PendingState pending_state;
+    pending_state.generation = m_generation.load();
+    pending_state.frame = system.GetMovie().GetCurrentFrame();
+    pending_state.state = TakeStateBuffer();
+    if (!SaveStateToBufferWithoutPausing(system, pending_state.state))
+    {
+      ReturnStateBuffer(std::move(pending_state.state));
+      m_pending.store(false);
+      return;
+    }
+
+    m_thread.Push(std::move(pending_state));
+  });
+
+  return true;
+}
+
+void BackgroundStateSaver::WaitForCompletion()
+{
+  m_thread.WaitForCompletion();
+  m_pending.store(false);
+}
+
+std::vector<u8> CompressLZ4Block(std::span<const u8> data)
+{
+  if (data.size() > LZ4_MAX_INPUT_SIZE)
+    return {};
+
+  const int size = static_cast<int>(data.size());
+  std::vector<u8> compressed(LZ4_compressBound(size));
+  const int compressed_size =
+      LZ4_compress_default(reinterpret_cast<const char*>(data.data()),
+                           reinterpret_cast<char*>(compressed.data()), size,
+                           static_cast<int>(compressed.size()));
+
+  compressed.resize(std::max(compressed_size, 0));
+  compressed.shrink_to_fit();
+  return compressed;
+}
+
+bool DecompressLZ4Block(std::span<const u8> compressed, size_t size, std::vector<u8>* out)
+{
+  if (size > LZ4_MAX_INPUT_SIZE || compressed.size() > std::numeric_limits<int>::max())
+    return false;
+
+  out->resize(size);
+  const int decompressed_size = LZ4_decompress_safe(
+      reinterpret_cast<const char*>(compressed.data()), reinterpret_cast<char*>(out->data()),
+      static_cast<int>(compressed.size()), static_cast<int>(size));
+
+  return decompressed_size == static_cast<int>(size);
+}
+
+void OnFrameEnd(Core::System& system)
+{
+  if (!Config::Get(Config::MAIN_REWIND_ENABLE) || NetPlay::IsNetPlayRunning() ||
+      AchievementManager::GetInstance().IsHardcoreModeActive())
+  {
+    return;
+  }
+
+  if (++s_frames_since_rewind_point < std::max(Config::Get(Config::MAIN_REWIND_INTERVAL), 1u))
+    return;
+
+  // If the previous rewind point hasn't been compressed yet, try again on the next frame
+  if (s_rewind_saver.Request(system))
+    s_frames_since_rewind_point = 0;
 }
 
-void SaveToBuffer(Core::System& system, std::vector<u8>& buffer)
+bool Rewind(Core::System& system, size_t steps)
 {
+  if (steps == 0)
+    return false;
+
+  if (NetPlay::IsNetPlayRunning())
+  {
+    OSD::AddMessage("Loading savestates is disabled in Netplay to prevent desyncs");
+    return false;
+  }
+
+  if (AchievementManager::GetInstance().IsHardcoreModeActive())
+  {
+    OSD::AddMessage("Loading savestates is disabled in RetroAchievements hardcore mode");
+    return false;
+  }
+
+  bool success = false;
+  bool failed_to_load = false;
+  u64 frame = 0;
   Core::RunOnCPUThread(
       system,
       [&] {
-        u8* ptr = nullptr;
-        PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+        std::vector<u8> buffer;
+        {
+          std::lock_guard lk(s_rewind_buffer_mutex);
+          if (!s_rewind_buffer.Restore(steps - 1, &buffer, &frame))
+            return;
 
-        DoState(system, p_measure);
-        const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-        buffer.resize(buffer_size);
+          // Rewind points that are still being compressed must not be added after this, or the
+          // entries would no longer be where Restore found them
+          s_rewind_saver.Invalidate();
+        }
 
-        ptr = buffer.data();
-        PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-        DoState(system, p);
+        s_frames_since_rewind_point = 0;
+        if (!LoadFromBuffer(system, buffer))
+        {
+          OSD::AddMessage("Failed to load the rewind point");
+          failed_to_load = true;
+          return;
+        }
+
+        // The state that we loaded becomes the current state, so it's removed as well
+        std::lock_guard lk(s_rewind_buffer_mutex);
+        s_rewind_buffer.DiscardNewerThan(steps);
+        success = true;
       },
       true);
+
+  if (failed_to_load)
+    return false;
+
+  if (!success)
+  {
+    OSD::AddMessage("There is no rewind point to go back to");
+    return false;
+  }
+
+  OSD::AddMessage(fmt::format("Rewound to frame {}", frame));
+  return true;
+}
+
+void ClearRewindBuffer()
+{
+  std::lock_guard lk(s_rewind_buffer_mutex);
+  s_rewind_saver.Invalidate();
+  s_rewind_buffer.Clear();
 }
 
 namespace
@@ -318,51 +584,84 @@ static bool CompareTimestamp(const SlotWithTimestamp& lhs, const SlotWithTimesta
   return lhs.timestamp < rhs.timestamp;
 }
 
-static void CompressBufferToFile(const u8* raw_buffer, u64 size, File::IOFile& f)
+static bool CompressChunksToFile(const u8* raw_buffer, u64 size, CompressionType compression_type,
+                                 int compression_level, File::IOFile& f)
 {
-  u64 total_bytes_compressed = 0;
+  StateChunkIndexHeader index_header;
+  index_header.chunk_size = CHUNK_SIZE;
+  index_header.chunk_count = static_cast<u32>((size + CHUNK_SIZE - 1) / CHUNK_SIZE);
 
-  while (true)
-  {
-    u64 bytes_left_to_compress = size - total_bytes_compressed;
+  std::vector<std::vector<u8>> chunks(index_header.chunk_count);
+  std::atomic<bool> success = true;
 
-    int bytes_to_compress =
-        static_cast<int>(std::min(static_cast<u64>(LZ4_MAX_INPUT_SIZE), bytes_left_to_compress));
-    int compressed_buffer_size = LZ4_compressBound(bytes_to_compress);
-    auto compressed_buffer = std::make_unique<char[]>(compressed_buffer_size);
-    s32 compressed_len =
-        LZ4_compress_default(reinterpret_cast<const char*>(raw_buffer) + total_bytes_compressed,
-                             compressed_buffer.get(), bytes_to_compress, compressed_buffer_size);
+  Common::ParallelFor(chunks.size(), [&](size_t i) {
+    const u8* chunk_data = raw_buffer + i * CHUNK_SIZE;
+    const size_t chunk_size = static_cast<size_t>(std::min<u64>(CHUNK_SIZE, size - i * CHUNK_SIZE));
+    std::vector<u8>& chunk = chunks[i];
 
-    if (compressed_len == 0)
+    size_t compressed_size;
+    if (compression_type == CompressionType::ChunkedZstd)
     {
-      PanicAlertFmtT("Internal LZ4 Error - compression failed");
-      break;
+      chunk.resize(ZSTD_compressBound(chunk_size));
+      compressed_size =
+          ZSTD_compress(chunk.data(), chunk.size(), chunk_data, chunk_size, compression_level);
+      if (ZSTD_isError(compressed_size))
+        compressed_size = 0;
+    }
+    else
+    {
+      chunk.resize(LZ4_compressBound(static_cast<int>(chunk_size)));
+      compressed_size = static_cast<size_t>(std::max(
+          LZ4_compress_default(reinterpret_cast<const char*>(chunk_data),
+                               reinterpret_cast<char*>(chunk.data()), static_cast<int>(chunk_size),
+                               static_cast<int>(chunk.size())),
+          0));
     }
 
-    // The size of the data to write is 'compressed_len'
-    f.WriteArray(&compressed_len, 1);
-    f.WriteBytes(compressed_buffer.get(), compressed_len);
+    if (compressed_size == 0)
+      success = false;
+    chunk.resize(compressed_size);
+  });
 
-    total_bytes_compressed += bytes_to_compress;
-    if (total_bytes_compressed == size)
-      break;
+  if (!success)
+  {
+    PanicAlertFmtT("Internal Error - savestate compression failed");
+    return false;
   }
+
+  std::vector<u32> compressed_sizes(chunks.size());
+  for (size_t i = 0; i < chunks.size(); ++i)
+    compressed_sizes[i] = static_cast<u32>(chunks[i].size());
+
+  f.WriteArray(&index_header, 1);
+  f.WriteArray(compressed_sizes.data(), compressed_sizes.size());
+  for (const std::vector<u8>& chunk : chunks)
+    f.WriteBytes(chunk.data(), chunk.size());
+
+  return true;
 }
 
-static void CreateExtendedHeader(StateExtendedHeader& extended_header, size_t uncompressed_size)
+static void CreateExtendedHeader(StateExtendedHeader& extended_header, size_t uncompressed_size,
+                                 const CompressAndDumpState_args& save_args)
 {
+  extended_header.incremental_header = save_args.incremental_header;
+  extended_header.incremental_header.base_filename_length =
+      static_cast<u32>(save_args.base_filename.size());
+  extended_header.base_filename = save_args.base_filename;
+
   StateExtendedBaseHeader& base_header = extended_header.base_header;
   base_header.header_version = EXTENDED_HEADER_VERSION;
-  base_header.compression_type =
-      s_use_compression ? CompressionType::LZ4 : CompressionType::Uncompressed;
-  base_header.payload_offset = COMPRESSED_DATA_OFFSET;
+  base_header.compression_type = save_args.compression_type;
+  base_header.payload_offset = static_cast<u32>(sizeof(StateExtendedIncrementalHeader) +
+                                                extended_header.base_filename.size()) +
+                               COMPRESSED_DATA_OFFSET;
   base_header.uncompressed_size = uncompressed_size;
 
   // If more fields are added to StateExtendedHeader, set them here.
 }
 
-static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
+static void WriteHeadersToFile(size_t uncompressed_size, const CompressAndDumpState_args& save_args,
+                               File::IOFile& f)
 {
   StateHeader header{};
   SConfig::GetInstance().GetGameID().copy(header.legacy_header.game_id,
@@ -374,16 +673,43 @@ static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
   header.version_header.version_string_length = static_cast<u32>(header.version_string.length());
 
   StateExtendedHeader extended_header{};
-  CreateExtendedHeader(extended_header, uncompressed_size);
+  CreateExtendedHeader(extended_header, uncompressed_size, save_args);
 
   f.WriteArray(&header.legacy_header, 1);
   f.WriteArray(&header.version_header, 1);
   f.WriteString(header.version_string);
 
   f.WriteArray(&extended_header.base_header, 1);
+  f.WriteArray(&extended_header.incremental_header, 1);
+  f.WriteString(extended_header.base_filename);
   // If StateExtendedHeader is amended to include more than the base, add WriteBytes() calls here.
 }
 
+static u64 GenerateStateID()
+{
+  u64 state_id = 0;
+  while (state_id == 0)
+    state_id = Common::Random::GenerateValue<u64>();
+  return state_id;
+}
+
+// Must be called on the CPU thread, while memory contains what was saved in the given state
+static void SetIncrementalBase(Core::System& system, const std::string& filename, u64 state_id)
+{
+  system.GetMemory().SetDirtyPageBase();
+
+  std::lock_guard lk(s_incremental_base_mutex);
+  s_incremental_base = {filename, state_id};
+}
+
+// Makes sure that no incremental states are saved relative to a state that couldn't be written
+static void DiscardIncrementalBase(u64 state_id)
+{
+  std::lock_guard lk(s_incremental_base_mutex);
+  if (s_incremental_base.state_id == state_id)
+    s_incremental_base = {};
+}
+
 static void CompressAndDumpState(Core::System& system, CompressAndDumpState_args& save_args)
 {
   const u8* const buffer_data = save_args.buffer_vector.data();
@@ -405,18 +731,30 @@ static void CompressAndDumpState(Core::System& system, CompressAndDumpState_args
   if (!f)
   {
     Core::DisplayMessage("Failed to create state file", 2000);
+    DiscardIncrementalBase(save_args.incremental_header.state_id);
     return;
   }
 
-  WriteHeadersToFile(buffer_size, f);
+  WriteHeadersToFile(buffer_size, save_args, f);
 
-  if (s_use_compression)
-    CompressBufferToFile(buffer_data, buffer_size, f);
-  else
+  bool compressed = true;
+  if (save_args.compression_type == CompressionType::Uncompressed)
+  {
     f.WriteBytes(buffer_data, buffer_size);
+  }
+  else
+  {
+    compressed = CompressChunksToFile(buffer_data, buffer_size, save_args.compression_type,
+                                      save_args.compression_level, f);
+  }
 
-  if (!f.IsGood())
+  ReturnStateBuffer(std::move(save_args.buffer_vector));
+
+  if (!compressed || !f.IsGood())
+  {
     Core::DisplayMessage("Failed to write state file", 2000);
+    DiscardIncrementalBase(save_args.incremental_header.state_id);
+  }
 
   const std::string last_state_filename = File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav";
   const std::string last_state_dtmname = last_state_filename + ".dtm";
@@ -459,6 +797,7 @@ static void CompressAndDumpState(Core::System& system, CompressAndDumpState_args
     if (!File::Rename(temp_filename, filename))
     {
       Core::DisplayMessage("Failed to rename state file", 2000);
+      DiscardIncrementalBase(save_args.incremental_header.state_id);
     }
     else
     {
@@ -470,12 +809,89 @@ static void CompressAndDumpState(Core::System& system, CompressAndDumpState_args
   Host_UpdateMainFrame();
 }
 
-void SaveAs(Core::System& system, const std::string& filename, bool wait)
+// If a state is currently being written, waits for that to end. Returns false if it timed out.
+static bool WaitForStateWrites()
+{
+  std::unique_lock lk(s_state_writes_in_queue_mutex);
+  return s_state_write_queue_is_empty.wait_for(lk, std::chrono::seconds(3),
+                                               []() { return s_state_writes_in_queue == 0; });
+}
+
+// Reads the incremental header of a state without decompressing it or showing any messages
+static bool ReadIncrementalHeader(const std::string& filename,
+                                  StateExtendedIncrementalHeader* incremental_header,
+                                  std::string* base_filename)
+{
+  File::IOFile f(filename, "rb");
+  StateHeaderLegacy legacy_header;
+  StateHeaderVersion version_header;
+  StateExtendedBaseHeader base_header;
+  if (!f.ReadArray(&legacy_header, 1) || legacy_header.lzo_size != 0 ||
+      !f.ReadArray(&version_header, 1) ||
+      !f.Seek(version_header.version_string_length, File::SeekOrigin::Current) ||
+      !f.ReadArray(&base_header, 1) || base_header.header_version != EXTENDED_HEADER_VERSION ||
+      !f.ReadArray(incremental_header, 1))
+  {
+    return false;
+  }
+
+  base_filename->resize(incremental_header->base_filename_length);
+  return f.ReadBytes(base_filename->data(), base_filename->size());
+}
+
+// Returns true if an incremental state in another slot was saved relative to the given state.
+// Overwriting the state would make those states unloadable.
+static bool HasDependentStates(const std::string& filename)
+{
+  StateExtendedIncrementalHeader incremental_header;
+  std::string base_filename;
+  if (!ReadIncrementalHeader(filename, &incremental_header, &base_filename) ||
+      incremental_header.state_id == 0 || incremental_header.base_state_id != 0)
+  {
+    return false;
+  }
+
+  const std::string name = std::filesystem::path(filename).filename().string();
+  for (int i = 1; i <= (int)NUM_STATES; i++)
+  {
+    const std::string slot_filename = MakeStateFilename(i);
+    StateExtendedIncrementalHeader slot_header;
+    std::string slot_base_filename;
+    if (slot_filename != filename &&
+        ReadIncrementalHeader(slot_filename, &slot_header, &slot_base_filename) &&
+        slot_header.base_state_id == incremental_header.state_id && slot_base_filename == name)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Incremental states are only saved to slots, since their base must stay next to them
+static void SaveToFile(Core::System& system, const std::string& filename, bool wait,
+                       bool allow_incremental)
 {
   std::unique_lock lk(s_load_or_save_in_progress_mutex, std::try_to_lock);
   if (!lk)
     return;
 
+  // Incremental states that were saved relative to this state may still be in the write queue
+  if (!WaitForStateWrites())
+  {
+    Core::DisplayMessage(
+        "A previous state saving operation is still in progress, cancelling save.", 2000);
+    return;
+  }
+
+  if (HasDependentStates(filename))
+  {
+    Core::DisplayMessage("Not overwriting this state, since other states were saved relative to "
+                         "it. Delete those states first.",
+                         4000);
+    return;
+  }
+
   Core::RunOnCPUThread(
       system,
       [&] {
@@ -484,20 +900,28 @@ void SaveAs(Core::System& system, const std::string& filename, bool wait)
           ++s_state_writes_in_queue;
         }
 
-        // Measure the size of the buffer.
-        u8* ptr = nullptr;
-        PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-        DoState(system, p_measure);
-        const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-
-        // Then actually do the write.
-        std::vector<u8> current_buffer;
-        current_buffer.resize(buffer_size);
-        ptr = current_buffer.data();
-        PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-        DoState(system, p);
+        // Only save the memory pages that changed since the last full state, if that one is still
+        // around. Overwriting it with an incremental state would make that state unloadable.
+        auto& memory = system.GetMemory();
+        const bool incremental_enabled =
+            allow_incremental && Config::Get(Config::MAIN_INCREMENTAL_SAVESTATES);
+        IncrementalBase base;
+        if (incremental_enabled && memory.HasDirtyPageBase())
+        {
+          std::lock_guard lk_(s_incremental_base_mutex);
+          base = s_incremental_base;
+        }
+        const bool incremental =
+            base.state_id != 0 && base.filename != filename &&
+            std::filesystem::path(base.filename).parent_path() ==
+                std::filesystem::path(filename).parent_path() &&
+            File::Exists(base.filename);
+
+        memory.SetIncrementalSaving(incremental);
+        Common::ScopeGuard incremental_guard{[&memory] { memory.SetIncrementalSaving(false); }};
 
-        if (p.IsWriteMode())
+        std::vector<u8> current_buffer = TakeStateBuffer();
+        if (SaveStateToBuffer(system, current_buffer))
         {
           Core::DisplayMessage("Saving State...", 1000);
 
@@ -506,6 +930,31 @@ void SaveAs(Core::System& system, const std::string& filename, bool wait)
           CompressAndDumpState_args save_args;
           save_args.buffer_vector = std::move(current_buffer);
           save_args.filename = filename;
+          if (s_use_compression)
+          {
+            const bool zstd = Config::Get(Config::MAIN_SAVESTATE_ZSTD);
+            save_args.compression_type =
+                zstd ? CompressionType::ChunkedZstd : CompressionType::ChunkedLZ4;
+            save_args.compression_level = Config::Get(Config::MAIN_SAVESTATE_ZSTD_LEVEL);
+          }
+          save_args.incremental_header.state_id = GenerateStateID();
+          if (incremental)
+          {
+            save_args.incremental_header.base_state_id = base.state_id;
+            save_args.base_filename = std::filesystem::path(base.filename).filename().string();
+          }
+          else if (incremental_enabled)
+          {
+            // Following states will be saved relative to this one
+            SetIncrementalBase(system, filename, save_args.incremental_header.state_id);
+          }
+          else
+          {
+            // The state that following states would be saved relative to is being overwritten
+            std::lock_guard lk_(s_incremental_base_mutex);
+            if (s_incremental_base.filename == filename)
+              s_incremental_base = {};
+          }
           if (wait)
           {
             sync_event = std::make_shared<Common::Event>();
@@ -532,6 +981,11 @@ void SaveAs(Core::System& system, const std::string& filename, bool wait)
       true);
 }
 
+void SaveAs(Core::System& system, const std::string& filename, bool wait)
+{
+  SaveToFile(system, filename, wait, false);
+}
+
 static bool GetVersionFromLZO(StateHeader& header, File::IOFile& f)
 {
   // Just read the first block, since it will contain the full revision string
@@ -667,60 +1121,82 @@ u64 GetUnixTimeOfSlot(int slot)
          (DOUBLE_TIME_OFFSET * MS_PER_SEC);
 }
 
-static bool DecompressLZ4(std::vector<u8>& raw_buffer, u64 size, File::IOFile& f)
+static bool DecompressChunks(std::vector<u8>& raw_buffer, u64 size,
+                             CompressionType compression_type, File::IOFile& f)
 {
-  raw_buffer.resize(size);
+  StateChunkIndexHeader index_header;
+  if (!f.ReadArray(&index_header, 1))
+  {
+    PanicAlertFmt("Could not read state chunk index");
+    return false;
+  }
 
-  u64 total_bytes_read = 0;
-  while (true)
+  const u64 chunk_size = index_header.chunk_size;
+  if (chunk_size == 0 || chunk_size > LZ4_MAX_INPUT_SIZE ||
+      index_header.chunk_count != (size + chunk_size - 1) / chunk_size)
   {
-    s32 compressed_data_len;
-    if (!f.ReadArray(&compressed_data_len, 1))
-    {
-      PanicAlertFmt("Could not read state data length");
-      return false;
-    }
+    PanicAlertFmt("State chunk index corrupted");
+    return false;
+  }
 
-    if (compressed_data_len <= 0)
-    {
-      PanicAlertFmtT("Internal LZ4 Error - Tried decompressing {0} bytes", compressed_data_len);
-      return false;
-    }
+  std::vector<u32> compressed_sizes(index_header.chunk_count);
+  if (!f.ReadArray(compressed_sizes.data(), compressed_sizes.size()))
+  {
+    PanicAlertFmt("Could not read state chunk index");
+    return false;
+  }
 
-    auto compressed_data = std::make_unique<char[]>(compressed_data_len);
-    if (!f.ReadBytes(compressed_data.get(), compressed_data_len))
-    {
-      PanicAlertFmt("Could not read state data");
-      return false;
-    }
+  std::vector<u64> compressed_offsets(compressed_sizes.size() + 1);
+  for (size_t i = 0; i < compressed_sizes.size(); ++i)
+    compressed_offsets[i + 1] = compressed_offsets[i] + compressed_sizes[i];
 
-    u32 max_decompress_size =
-        static_cast<u32>(std::min((u64)LZ4_MAX_INPUT_SIZE, size - total_bytes_read));
+  const u64 compressed_size = compressed_offsets.back();
+  if (compressed_size > f.GetSize() - f.Tell())
+  {
+    PanicAlertFmt("State chunk index corrupted");
+    return false;
+  }
 
-    int bytes_read = LZ4_decompress_safe(
-        compressed_data.get(), reinterpret_cast<char*>(raw_buffer.data()) + total_bytes_read,
-        compressed_data_len, max_decompress_size);
+  // Reading everything at once is faster than seeking around while decompressing
+  std::vector<u8> compressed_data(compressed_size);
+  if (!f.ReadBytes(compressed_data.data(), compressed_data.size()))
+  {
+    PanicAlertFmt("Could not read state data");
+    return false;
+  }
 
-    if (bytes_read < 0)
-    {
-      PanicAlertFmtT("Internal LZ4 Error - decompression failed ({0}, {1}, {2})", bytes_read,
-                     compressed_data_len, max_decompress_size);
-      return false;
-    }
+  raw_buffer.resize(size);
+  std::atomic<bool> success = true;
 
-    total_bytes_read += static_cast<u64>(bytes_read);
+  Common::ParallelFor(compressed_sizes.size(), [&](size_t i) {
+    u8* const dst = raw_buffer.data() + i * chunk_size;
+    const size_t dst_size = static_cast<size_t>(std::min(chunk_size, size - i * chunk_size));
+    const u8* const src = compressed_data.data() + compressed_offsets[i];
+    const size_t src_size = compressed_sizes[i];
 
-    if (total_bytes_read == size)
+    if (compression_type == CompressionType::ChunkedZstd)
     {
-      return true;
+      const size_t result = ZSTD_decompress(dst, dst_size, src, src_size);
+      if (ZSTD_isError(result) || result != dst_size)
+        success = false;
     }
-    else if (total_bytes_read > size)
+    else
     {
-      PanicAlertFmtT("Internal LZ4 Error - payload size mismatch ({0} / {1}))", total_bytes_read,
-                     size);
-      return false;
+      const int result =
+          LZ4_decompress_safe(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst),
+                              static_cast<int>(src_size), static_cast<int>(dst_size));
+      if (result != static_cast<int>(dst_size))
+        success = false;
     }
+  });
+
+  if (!success)
+  {
+    PanicAlertFmtT("Internal Error - savestate decompression failed");
+    return false;
   }
+
+  return true;
 }
 
 static bool ValidateHeaders(const StateHeader& header)
@@ -770,37 +1246,28 @@ static bool ValidateHeaders(const StateHeader& header)
   return success;
 }
 
-static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data)
+static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data,
+                              StateExtendedHeader& extended_header)
 {
   File::IOFile f;
 
+  if (!WaitForStateWrites())
   {
-    // If a state is currently saving, wait for that to end or time out.
-    std::unique_lock lk(s_state_writes_in_queue_mutex);
-    if (s_state_writes_in_queue != 0)
-    {
-      if (!s_state_write_queue_is_empty.wait_for(lk, std::chrono::seconds(3),
-                                                 []() { return s_state_writes_in_queue == 0; }))
-      {
-        Core::DisplayMessage(
-            "A previous state saving operation is still in progress, cancelling load.", 2000);
-        return;
-      }
-    }
-    f.Open(filename, "rb");
+    Core::DisplayMessage("A previous state saving operation is still in progress, cancelling load.",
+                         2000);
+    return;
   }
+  f.Open(filename, "rb");
 
   StateHeader header;
   if (!ReadStateHeaderFromFile(header, f) || !ValidateHeaders(header))
     return;
 
-  StateExtendedHeader extended_header;
   if (!f.ReadArray(&extended_header.base_header, 1))
   {
     PanicAlertFmt("Unable to read state header");
     return;
   }
-  // If StateExtendedHeader is amended to include more than the base, add ReadBytes() calls here.
 
   if (extended_header.base_header.header_version != EXTENDED_HEADER_VERSION)
   {
@@ -808,20 +1275,40 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
     return;
   }
 
+  if (!f.ReadArray(&extended_header.incremental_header, 1))
+  {
+    PanicAlertFmt("Unable to read state header");
+    return;
+  }
+
+  extended_header.base_filename.resize(extended_header.incremental_header.base_filename_length);
+  if (!f.ReadBytes(extended_header.base_filename.data(), extended_header.base_filename.size()))
+  {
+    PanicAlertFmt("Unable to read state header");
+    return;
+  }
+  // If StateExtendedHeader is amended to include more, add ReadBytes() calls here.
+
   std::vector<u8> buffer;
 
   switch (extended_header.base_header.compression_type)
   {
-  case CompressionType::LZ4:
+  case CompressionType::ChunkedLZ4:
+  case CompressionType::ChunkedZstd:
   {
-    Core::DisplayMessage("Decompressing State...", 500);
-    if (!DecompressLZ4(buffer, extended_header.base_header.uncompressed_size, f))
+    const auto compression_type =
+        static_cast<CompressionType>(extended_header.base_header.compression_type);
+    if (!DecompressChunks(buffer, extended_header.base_header.uncompressed_size, compression_type,
+                          f))
+    {
       return;
+    }
 
     break;
   }
   case CompressionType::Uncompressed:
   {
+    // The payload offset includes the rest of the extended header
     u64 header_len = sizeof(StateHeaderLegacy) + sizeof(StateHeaderVersion) +
                      header.version_header.version_string_length + sizeof(StateExtendedBaseHeader) +
                      extended_header.base_header.payload_offset;
@@ -852,6 +1339,28 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
   ret_data.swap(buffer);
 }
 
+// Loads the full state that an incremental state was saved relative to
+static bool LoadIncrementalBase(Core::System& system, const std::string& filename, u64 state_id)
+{
+  std::vector<u8> buffer;
+  StateExtendedHeader extended_header{};
+  LoadFileStateData(filename, buffer, extended_header);
+
+  if (buffer.empty() || extended_header.incremental_header.state_id != state_id ||
+      extended_header.incremental_header.base_state_id != 0)
+  {
+    Core::DisplayMessage("The state that this state was saved relative to is missing or has been "
+                         "overwritten",
+                         OSD::Duration::NORMAL);
+    return false;
+  }
+
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+  DoState(system, p);
+  return p.IsReadMode();
+}
+
 void LoadAs(Core::System& system, const std::string& filename)
 {
   if (!Core::IsRunningOrStarting(system))
@@ -881,7 +1390,8 @@ void LoadAs(Core::System& system, const std::string& filename)
         if (!movie.IsJustStartingRecordingInputFromSaveState())
         {
           std::lock_guard lk2(s_undo_load_buffer_mutex);
-          SaveToBuffer(system, s_undo_load_buffer);
+          if (!SaveToBuffer(system, s_undo_load_buffer))
+            s_undo_load_buffer.clear();
           const std::string dtmpath = File::GetUserPath(D_STATESAVES_IDX) + "undo.dtm";
           if (movie.IsMovieActive())
             movie.SaveRecording(dtmpath);
@@ -895,15 +1405,37 @@ void LoadAs(Core::System& system, const std::string& filename)
         // brackets here are so buffer gets freed ASAP
         {
           std::vector<u8> buffer;
-          LoadFileStateData(filename, buffer);
+          StateExtendedHeader extended_header{};
+          LoadFileStateData(filename, buffer, extended_header);
 
           if (!buffer.empty())
           {
-            u8* ptr = buffer.data();
-            PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
-            DoState(system, p);
             loaded = true;
-            loadedSuccessfully = p.IsReadMode();
+
+            const bool incremental_enabled = Config::Get(Config::MAIN_INCREMENTAL_SAVESTATES);
+            const StateExtendedIncrementalHeader& incremental_header =
+                extended_header.incremental_header;
+
+            // Incremental states only contain the memory pages that differ from their base
+            bool base_loaded = true;
+            if (incremental_header.base_state_id != 0)
+            {
+              const std::string base_filename =
+                  (std::filesystem::path(filename).parent_path() / extended_header.base_filename)
+                      .string();
+              base_loaded =
+                  LoadIncrementalBase(system, base_filename, incremental_header.base_state_id);
+              if (base_loaded && incremental_enabled)
+                SetIncrementalBase(system, base_filename, incremental_header.base_state_id);
+            }
+
+            if (base_loaded)
+            {
+              u8* ptr = buffer.data();
+              PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+              DoState(system, p);
+              loadedSuccessfully = p.IsReadMode();
+            }
           }
         }
 
@@ -940,6 +1472,21 @@ void SetOnAfterLoadCallback(AfterLoadCallbackFunc callback)
   s_on_after_load_callback = std::move(callback);
 }
 
+// Called on the rewind worker thread
+static void AddRewindPoint(const std::vector<u8>& state, u64 frame, u64 generation)
+{
+  const size_t memory_budget =
+      static_cast<size_t>(Config::Get(Config::MAIN_REWIND_MEMORY_BUDGET)) * 0x100000;
+
+  // Checked under the lock so that a rewind can't happen between the check and the Add
+  std::lock_guard lk(s_rewind_buffer_mutex);
+  if (generation == s_rewind_saver.GetGeneration())
+  {
+    s_rewind_buffer.SetMemoryBudget(memory_budget);
+    s_rewind_buffer.Add(state, frame);
+  }
+}
+
 void Init(Core::System& system)
 {
   s_save_thread.Reset("Savestate Worker", [&system](CompressAndDumpState_args args) {
@@ -954,11 +1501,27 @@ void Init(Core::System& system)
     if (args.state_write_done_event)
       args.state_write_done_event->Set();
   });
+
+  ClearRewindBuffer();
+  {
+    std::lock_guard lk(s_incremental_base_mutex);
+    s_incremental_base = {};
+  }
+  s_frames_since_rewind_point = 0;
+  s_rewind_saver.Reset("Rewind Worker", AddRewindPoint);
 }
 
 void Shutdown()
 {
   s_save_thread.Shutdown();
+  s_rewind_saver.Shutdown();
+  ClearRewindBuffer();
+
+  {
+    std::lock_guard lk(s_state_buffer_pool_mutex);
+    s_pooled_state_buffer = {};
+  }
+  s_last_state_size.store(0);
 
   // swapping with an empty vector, rather than clear()ing
   // this gives a better guarantee to free the allocated memory right NOW (as opposed to, actually,
@@ -977,7 +1540,7 @@ static std::string MakeStateFilename(int number)
 
 void Save(Core::System& system, int slot, bool wait)
 {
-  SaveAs(system, MakeStateFilename(slot), wait);
+  SaveToFile(system, MakeStateFilename(slot), wait, true);
 }
 
 void Load(Core::System& system, int slot)
@@ -1015,9 +1578,12 @@ void SaveFirstSaved(Core::System& system)
     return;
   }
 
-  // overwrite the oldest state
+  // overwrite the oldest state that no incremental state depends on
   std::stable_sort(used_slots.begin(), used_slots.end(), CompareTimestamp);
-  Save(system, used_slots.front().slot, true);
+  const auto it = std::ranges::find_if(used_slots, [](const SlotWithTimestamp& used_slot) {
+    return !HasDependentStates(MakeStateFilename(used_slot.slot));
+  });
+  Save(system, it != used_slots.end() ? it->slot : used_slots.front().slot, true);
 }
 
 // Load the last state before loading the state
@@ -5,13 +5,17 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <functional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
 
 namespace Core
 {
@@ -54,11 +58,27 @@ struct StateHeader
 enum CompressionType : u16
 {
   Uncompressed = 0,
+  // A sequence of LZ4 blocks, each preceded by its compressed size. Only written by versions
+  // whose states are rejected by the version check, so it's no longer read either.
   LZ4 = 1,
   // Add new compression types after this, as the compression type
   // is numerically stored in the state file.
+  // The payload is split into chunks that are compressed independently, see StateChunkIndexHeader
+  ChunkedLZ4 = 2,
+  ChunkedZstd = 3,
 };
 
+// Chunked payloads start with this header, followed by the compressed size of every chunk as a u32
+// and then the compressed chunks. Every chunk except the last one decompresses to chunk_size bytes.
+// Knowing where every chunk starts lets them be compressed and decompressed in parallel.
+struct StateChunkIndexHeader
+{
+  u32 chunk_size;
+  u32 chunk_count;
+};
+static_assert(sizeof(StateChunkIndexHeader) == 8);
+static_assert(std::is_trivially_copyable_v<StateChunkIndexHeader>);
+
 struct StateExtendedBaseHeader
 {
   u16 header_version;
@@ -72,9 +92,26 @@ static_assert(offsetof(StateExtendedBaseHeader, payload_offset) == 4);
 static_assert(offsetof(StateExtendedBaseHeader, uncompressed_size) == 8);
 static_assert(std::is_trivially_copyable_v<StateExtendedBaseHeader>);
 
+// States that only contain the pages of emulated memory that changed since another state (the
+// base) have to be loaded on top of the base, which must be in the same directory.
+struct StateExtendedIncrementalHeader
+{
+  // Random non-zero value identifying this state
+  u64 state_id;
+  // 0 if this isn't an incremental state
+  u64 base_state_id;
+  u32 base_filename_length;
+  u32 reserved;
+};
+static_assert(sizeof(StateExtendedIncrementalHeader) == 24);
+static_assert(std::is_trivially_copyable_v<StateExtendedIncrementalHeader>);
+
 struct StateExtendedHeader
 {
   StateExtendedBaseHeader base_header;
+  StateExtendedIncrementalHeader incremental_header;
+  // The file name (without directory) of the base state, if this is an incremental state
+  std::string base_filename;
   // Feel free to add new fields here, adjusting COMPRESSED_DATA_OFFSET accordingly, as well as
   // CreateExtendedHeader(). Add the appropriate IOFile read/write calls within LoadFileStateData()
   // and WriteHeadersToFile()
@@ -106,8 +143,61 @@ void Load(Core::System& system, int slot);
 void SaveAs(Core::System& system, const std::string& filename, bool wait = false);
 void LoadAs(Core::System& system, const std::string& filename);
 
-void SaveToBuffer(Core::System& system, std::vector<u8>& buffer);
-void LoadFromBuffer(Core::System& system, std::vector<u8>& buffer);
+// Returns false if the state couldn't be saved
+bool SaveToBuffer(Core::System& system, std::vector<u8>& buffer);
+// Returns false if the state couldn't be loaded
+bool LoadFromBuffer(Core::System& system, std::vector<u8>& buffer);
+
+// Saves states in the background for features that keep one every few frames, like rewinding and
+// movie checkpoints. The state is saved on the CPU thread without pausing it once the current
+// CoreTiming events are done, and then handed to a worker thread so that the CPU thread doesn't
+// wait for it to be compressed or written. Only one state is in flight at a time.
+class BackgroundStateSaver
+{
+public:
+  // Called on the worker thread. generation is what GetGeneration() returned when the state was
+  // requested, so that states requested before a call to Invalidate can be dropped.
+  using Callback = std::function<void(const std::vector<u8>& state, u64 frame, u64 generation)>;
+
+  void Reset(std::string_view name, Callback callback);
+  void Shutdown();
+
+  // Must be called on the CPU thread at the end of a frame. Returns false if the previous state is
+  // still in flight, in which case the caller should try again on the next frame.
+  bool Request(Core::System& system);
+
+  u64 GetGeneration() const { return m_generation.load(); }
+  void Invalidate() { ++m_generation; }
+  // Waits until the worker thread is idle. A state that was never saved because emulation stopped
+  // is forgotten, so that a new one can be requested.
+  void WaitForCompletion();
+
+private:
+  struct PendingState
+  {
+    std::vector<u8> state;
+    u64 frame = 0;
+    u64 generation = 0;
+  };
+
+  Common::WorkQueueThread<PendingState> m_thread;
+  std::atomic<bool> m_pending = false;
+  std::atomic<u64> m_generation = 0;
+};
+
+// LZ4 compression for states that are kept outside of savestate files, like rewind points and
+// movie checkpoints. Returns an empty vector if the data can't be compressed.
+std::vector<u8> CompressLZ4Block(std::span<const u8> data);
+// Returns false unless the data decompresses to exactly size bytes
+bool DecompressLZ4Block(std::span<const u8> compressed, size_t size, std::vector<u8>* out);
+
+// While rewinding is enabled, a state is kept in memory every few frames. Must be called on
+// the CPU thread at the end of every emulated frame.
+void OnFrameEnd(Core::System& system);
+// Goes back the given number of rewind points. Points that are newer than the one that was
+// loaded are discarded, so calling this again goes back further.
+bool Rewind(Core::System& system, size_t steps = 1);
+void ClearRewindBuffer();
 
 void LoadLastSaved(Core::System& system, int i = 1);
 void SaveFirstSaved(Core::System& system);
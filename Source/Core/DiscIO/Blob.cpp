@@ -15,6 +15,7 @@
 #include "Common/MsgHandler.h"
 
 #include "DiscIO/CISOBlob.h"
+#include "DiscIO/ChunkStoreBlob.h"
 #include "DiscIO/CompressedBlob.h"
 #include "DiscIO/DirectoryBlob.h"
 #include "DiscIO/FileBlob.h"
@@ -56,6 +57,8 @@ std::string GetName(BlobType blob_type, bool translate)
     return "NFS";
   case BlobType::SPLIT_PLAIN:
     return translate_str("Multi-part ISO");
+  case BlobType::CHUNK_STORE:
+    return translate_str("Chunk Store");
   default:
     return "";
   }
@@ -93,6 +96,12 @@ const SectorReader::Cache* SectorReader::FindCacheLine(u64 block_num)
   return &*itr;
 }
 
+bool SectorReader::IsCached(u64 block_num) const
+{
+  return std::ranges::any_of(m_cache,
+                             [&](const Cache& entry) { return entry.Contains(block_num); });
+}
+
 SectorReader::Cache* SectorReader::GetEmptyCacheLine()
 {
   Cache* oldest = &m_cache[0];
@@ -144,6 +153,29 @@ bool SectorReader::Read(u64 offset, u64 size, u8* out_ptr)
   {
     block = offset / m_block_size;
 
+    // Runs of whole blocks that aren't cached are read straight into the output buffer.
+    // This lets ReadMultipleAlignedBlocks handle all of them at once, and keeps a single
+    // large read from evicting everything else from the cache.
+    if (position_in_block == 0 && remain >= 2 * static_cast<u64>(m_block_size) && !IsCached(block))
+    {
+      const u64 max_blocks = remain / m_block_size;
+      u64 num_blocks = 1;
+      while (num_blocks < max_blocks && !IsCached(block + num_blocks))
+        ++num_blocks;
+
+      if (num_blocks >= 2)
+      {
+        if (!ReadMultipleAlignedBlocks(block, num_blocks, out_ptr))
+          return false;
+
+        const u64 bytes_read = num_blocks * m_block_size;
+        offset += bytes_read;
+        out_ptr += bytes_read;
+        remain -= bytes_read;
+        continue;
+      }
+    }
+
     const Cache* cache = GetCacheLine(block);
     if (!cache)
       return false;
@@ -244,6 +276,8 @@ std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename)
     return RVZFileReader::Create(std::move(file), filename);
   case NFS_MAGIC:
     return NFSFileReader::Create(std::move(file), filename);
+  case CHUNK_STORE_MAGIC:
+    return ChunkStoreFileReader::Create(std::move(file), filename);
   default:
     if (auto directory_blob = DirectoryBlobReader::Create(filename))
       return std::move(directory_blob);
@@ -42,6 +42,7 @@ enum class BlobType
   MOD_DESCRIPTOR,
   NFS,
   SPLIT_PLAIN,
+  CHUNK_STORE,
 };
 
 // If you convert an ISO file to another format and then call GetDataSize on it, what is the result?
@@ -165,6 +166,9 @@ private:
     bool IsLessRecentlyUsedThan(const Cache& other) const { return lru_sreg < other.lru_sreg; }
   };
 
+  // Like FindCacheLine, but without marking the line as used.
+  bool IsCached(u64 block_num) const;
+
   // Gets the cache line that contains the given block, or nullptr.
   // NOTE: The cache record only lasts until it expires (next GetEmptyCacheLine)
   const Cache* FindCacheLine(u64 block_num);
@@ -199,9 +203,15 @@ bool ConvertToGCZ(BlobReader* infile, const std::string& infile_path,
                   CompressCB callback);
 bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
                     const std::string& outfile_path, CompressCB callback);
+// If memory_limit isn't 0, fewer compression threads are used when needed to keep the memory
+// used by the conversion (in bytes) approximately below the limit.
 bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
-                       int chunk_size, CompressCB callback);
+                       int chunk_size, CompressCB callback, u64 memory_limit = 0);
+// If store_path is relative, it's relative to the directory of outfile_path.
+bool ConvertToChunkStore(BlobReader* infile, const std::string& infile_path,
+                         const std::string& outfile_path, const std::string& store_path,
+                         int compression_level, CompressCB callback);
 
 }  // namespace DiscIO
@@ -0,0 +1,96 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/ChunkCache.h"
+
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+
+namespace DiscIO
+{
+ChunkCache& ChunkCache::GetInstance()
+{
+  static ChunkCache instance;
+  return instance;
+}
+
+u64 ChunkCache::GetSourceID(const std::string& path)
+{
+  SourceKey key{path, File::GetSize(path), File::GetLastWriteTime(path).value_or(0)};
+
+  std::lock_guard lk(m_lock);
+
+  // ID 0 is never handed out, so readers can use it to mean "don't cache". Entries for an older
+  // version of the file are never looked up again, so they age out like any other entry.
+  return m_source_ids.try_emplace(std::move(key), m_source_ids.size() + 1).first->second;
+}
+
+ChunkCache::Data ChunkCache::Get(u64 source_id, u64 offset)
+{
+  std::lock_guard lk(m_lock);
+
+  const auto it = m_entry_map.find({source_id, offset});
+  if (it == m_entry_map.end())
+    return nullptr;
+
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->data;
+}
+
+bool ChunkCache::Contains(u64 source_id, u64 offset)
+{
+  std::lock_guard lk(m_lock);
+  return m_entry_map.contains({source_id, offset});
+}
+
+void ChunkCache::Insert(u64 source_id, u64 offset, std::vector<u8> data)
+{
+  Insert(source_id, offset, std::make_shared<const std::vector<u8>>(std::move(data)));
+}
+
+void ChunkCache::Insert(u64 source_id, u64 offset, Data data)
+{
+  std::lock_guard lk(m_lock);
+
+  const Key key{source_id, offset};
+  if (m_entry_map.contains(key) || data->size() > m_capacity)
+    return;
+
+  EvictUntilBelow(m_capacity - data->size());
+
+  m_size += data->size();
+  m_entries.push_front(Entry{key, std::move(data)});
+  m_entry_map.emplace(key, m_entries.begin());
+}
+
+void ChunkCache::SetCapacity(size_t capacity)
+{
+  std::lock_guard lk(m_lock);
+  m_capacity = capacity;
+  EvictUntilBelow(capacity);
+}
+
+void ChunkCache::Clear()
+{
+  std::lock_guard lk(m_lock);
+  EvictUntilBelow(0);
+}
+
+void ChunkCache::EvictUntilBelow(size_t size)
+{
+  // Data that is still in use by a reader stays alive through its shared_ptr.
+  while (m_size > size && !m_entries.empty())
+  {
+    const Entry& entry = m_entries.back();
+    m_size -= entry.data->size();
+    m_entry_map.erase(entry.key);
+    m_entries.pop_back();
+  }
+}
+
+}  // namespace DiscIO
@@ -0,0 +1,73 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace DiscIO
+{
+// A size-bounded LRU cache for decompressed or decrypted disc data, shared by every BlobReader
+// in the process. This lets copies of a reader (e.g. one used for prefetching on another thread)
+// reuse each other's work, and avoids redoing expensive work when reads alternate between
+// a few distant parts of a disc.
+//
+// Entries are identified by a source ID, which stands for one file on the host, and an offset
+// whose meaning is up to the reader. All functions are thread-safe.
+class ChunkCache
+{
+public:
+  using Data = std::shared_ptr<const std::vector<u8>>;
+
+  static constexpr size_t DEFAULT_CAPACITY = 64 * 1024 * 1024;
+
+  static ChunkCache& GetInstance();
+
+  // Returns an ID for the file at the given path. The same path gets the same ID as long as the
+  // file's size and last write time stay the same, so a replaced file doesn't get stale data.
+  u64 GetSourceID(const std::string& path);
+
+  // Returns nullptr if there is no such entry.
+  Data Get(u64 source_id, u64 offset);
+  bool Contains(u64 source_id, u64 offset);
+
+  void Insert(u64 source_id, u64 offset, std::vector<u8> data);
+  void Insert(u64 source_id, u64 offset, Data data);
+
+  void SetCapacity(size_t capacity);
+  void Clear();
+
+private:
+  using Key = std::pair<u64, u64>;
+  // Path, size and last write time
+  using SourceKey = std::tuple<std::string, u64, s64>;
+
+  struct Entry
+  {
+    Key key;
+    Data data;
+  };
+
+  void EvictUntilBelow(size_t size);
+
+  std::mutex m_lock;
+  std::map<SourceKey, u64> m_source_ids;
+
+  // Most recently used first.
+  std::list<Entry> m_entries;
+  std::map<Key, std::list<Entry>::iterator> m_entry_map;
+  size_t m_size = 0;
+  size_t m_capacity = DEFAULT_CAPACITY;
+};
+
+}  // namespace DiscIO
@@ -0,0 +1,1023 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/ChunkStoreBlob.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <zstd.h>
+
+#include "Common/Align.h"
+#include "Common/Assert.h"
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/AES.h"
+#include "Common/Crypto/SHA1.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
+#include "Core/IOS/ES/Formats.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/ChunkCache.h"
+#include "DiscIO/Filesystem.h"
+#include "DiscIO/LaggedFibonacciGenerator.h"
+#include "DiscIO/Volume.h"
+#include "DiscIO/VolumeDisc.h"
+#include "DiscIO/VolumeWii.h"
+#include "DiscIO/WiiEncryptionCache.h"
+
+namespace DiscIO
+{
+// Content-defined chunking parameters. Chunk boundaries are placed where a rolling hash of the
+// data matches a pattern, so inserting or removing data only changes the chunks around the edit.
+static constexpr size_t MIN_CHUNK_SIZE = 0x4000;
+static constexpr size_t AVERAGE_CHUNK_SIZE = 0x10000;
+static constexpr size_t MAX_CHUNK_SIZE = 0x40000;
+static constexpr u64 CHUNK_BOUNDARY_MASK = AVERAGE_CHUNK_SIZE - 1;
+
+// Junk chunks are generated from seeds instead of being stored, so their size is only limited by
+// the size field of the entry
+static constexpr u64 MAX_JUNK_CHUNK_SIZE = 0x40000000;
+
+// Random values for the "gear" rolling hash. These must never change, since that would prevent
+// new images from sharing chunks with images that are already in a store.
+static constexpr std::array<u64, 256> GEAR_TABLE = [] {
+  std::array<u64, 256> table{};
+  u64 state = 0x446f6c7068696e21;  // splitmix64
+  for (u64& value : table)
+  {
+    state += 0x9e3779b97f4a7c15;
+    u64 z = state;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    value = z ^ (z >> 31);
+  }
+  return table;
+}();
+
+static size_t FindChunkBoundary(const u8* data, size_t size)
+{
+  if (size <= MIN_CHUNK_SIZE)
+    return size;
+
+  const size_t end = std::min(size, MAX_CHUNK_SIZE);
+
+  // The hash only depends on the last 64 bytes, so skipping ahead doesn't affect where
+  // boundaries are found in data that has been shifted
+  u64 hash = 0;
+  for (size_t i = MIN_CHUNK_SIZE - 64; i < end; ++i)
+  {
+    hash = (hash << 1) + GEAR_TABLE[data[i]];
+    if (i >= MIN_CHUNK_SIZE && (hash & CHUNK_BOUNDARY_MASK) == 0)
+      return i + 1;
+  }
+
+  return end;
+}
+
+std::string GetChunkStoreChunkPath(const std::string& store_path, const Common::SHA1::Digest& hash)
+{
+  const std::string hex = Common::BytesToHexString(hash);
+  return fmt::format("{}/{}/{}", store_path, hex.substr(0, 2), hex.substr(2));
+}
+
+static std::string ResolveStorePath(const std::string& image_path, const std::string& store_path)
+{
+  if (StringToPath(store_path).is_absolute())
+    return store_path;
+
+  std::string directory;
+  SplitPath(image_path, &directory, nullptr, nullptr);
+  return directory + store_path;
+}
+
+ChunkStoreFileReader::ChunkStoreFileReader(File::IOFile file, const std::string& path,
+                                           std::shared_ptr<const Manifest> manifest)
+    : m_file(std::move(file)), m_path(path), m_file_size(m_file.GetSize()),
+      m_manifest(std::move(manifest)), m_header(m_manifest->header),
+      m_store_path(m_manifest->store_path),
+      m_chunk_cache_source_id(ChunkCache::GetInstance().GetSourceID(m_store_path)),
+      m_encryption_cache(this)
+{
+}
+
+std::unique_ptr<ChunkStoreFileReader> ChunkStoreFileReader::Create(File::IOFile file,
+                                                                   const std::string& path)
+{
+  std::shared_ptr<const Manifest> manifest = LoadManifest(&file, path);
+  if (!manifest)
+    return nullptr;
+
+  return std::unique_ptr<ChunkStoreFileReader>(
+      new ChunkStoreFileReader(std::move(file), path, std::move(manifest)));
+}
+
+std::unique_ptr<BlobReader> ChunkStoreFileReader::CopyReader() const
+{
+  return std::unique_ptr<ChunkStoreFileReader>(
+      new ChunkStoreFileReader(m_file.Duplicate("rb"), m_path, m_manifest));
+}
+
+std::shared_ptr<const ChunkStoreFileReader::Manifest>
+ChunkStoreFileReader::LoadManifest(File::IOFile* file, const std::string& path)
+{
+  auto manifest = std::make_shared<Manifest>();
+
+  if (!file->Seek(0, File::SeekOrigin::Begin) || !file->ReadArray(&manifest->header, 1))
+    return nullptr;
+
+  const ChunkStoreHeader& header = manifest->header;
+  if (header.magic != CHUNK_STORE_MAGIC)
+    return nullptr;
+
+  if (header.version != CHUNK_STORE_VERSION)
+  {
+    ERROR_LOG_FMT(DISCIO, "Chunk store image {} has unsupported version {}", path, header.version);
+    return nullptr;
+  }
+
+  const u64 expected_size = sizeof(ChunkStoreHeader) + header.store_path_size +
+                            header.num_partitions * sizeof(ChunkStorePartitionEntry) +
+                            header.num_chunks * sizeof(ChunkStoreEntry) +
+                            header.num_hash_exceptions * sizeof(ChunkStoreHashException) +
+                            header.num_junk_seeds * sizeof(ChunkStoreJunkSeed);
+  if (file->GetSize() != expected_size)
+  {
+    ERROR_LOG_FMT(DISCIO, "Chunk store image {} has the wrong size", path);
+    return nullptr;
+  }
+
+  std::string store_path(header.store_path_size, '\0');
+  std::vector<ChunkStorePartitionEntry> partition_entries(header.num_partitions);
+  manifest->entries.resize(header.num_chunks);
+  manifest->hash_exceptions.resize(header.num_hash_exceptions);
+  manifest->junk_seeds.resize(header.num_junk_seeds);
+  if (!file->ReadArray(store_path.data(), store_path.size()) ||
+      !file->ReadArray(partition_entries.data(), partition_entries.size()) ||
+      !file->ReadArray(manifest->entries.data(), manifest->entries.size()) ||
+      !file->ReadArray(manifest->hash_exceptions.data(), manifest->hash_exceptions.size()) ||
+      !file->ReadArray(manifest->junk_seeds.data(), manifest->junk_seeds.size()))
+  {
+    return nullptr;
+  }
+  manifest->store_path = ResolveStorePath(path, store_path);
+
+  // Partitions must be sorted and can't overlap, so that the data outside of partitions
+  // can be mapped to the chunks
+  u64 stored_size = header.data_size;
+  u64 last_partition_end = 0;
+  for (const ChunkStorePartitionEntry& entry : partition_entries)
+  {
+    const u64 max_hash_exceptions = header.num_hash_exceptions - entry.first_hash_exception;
+    if (entry.data_offset < last_partition_end || entry.data_size == 0 ||
+        entry.data_size % VolumeWii::BLOCK_TOTAL_SIZE != 0 ||
+        entry.data_offset > header.data_size ||
+        entry.data_size > header.data_size - entry.data_offset ||
+        entry.first_hash_exception > header.num_hash_exceptions ||
+        entry.num_hash_exceptions > max_hash_exceptions)
+    {
+      ERROR_LOG_FMT(DISCIO, "Chunk store image {} has an invalid partition entry", path);
+      return nullptr;
+    }
+
+    const auto begin = manifest->hash_exceptions.begin() + entry.first_hash_exception;
+    const auto end = begin + entry.num_hash_exceptions;
+    constexpr u64 HASH_BLOCKS_SIZE = VolumeWii::GROUP_HEADER_SIZE;
+    const bool exceptions_valid =
+        std::is_sorted(begin, end, [](const auto& a, const auto& b) {
+          return a.group_index < b.group_index;
+        }) &&
+        std::all_of(begin, end, [](const ChunkStoreHashException& exception) {
+          return exception.offset <= HASH_BLOCKS_SIZE - Common::SHA1::DIGEST_LEN;
+        });
+    if (!exceptions_valid)
+    {
+      ERROR_LOG_FMT(DISCIO, "Chunk store image {} has invalid hash exceptions", path);
+      return nullptr;
+    }
+
+    const u64 decrypted_size =
+        entry.data_size / VolumeWii::BLOCK_TOTAL_SIZE * VolumeWii::BLOCK_DATA_SIZE;
+    const u64 stored_offset = entry.data_offset - (header.data_size - stored_size);
+    manifest->partitions.push_back(Partition{entry, decrypted_size, stored_offset});
+
+    stored_size -= entry.data_size - decrypted_size;
+    last_partition_end = entry.data_offset + entry.data_size;
+  }
+
+  // Each entry must lie entirely within a partition or entirely outside of partitions, since the
+  // position of junk data depends on which of the two it is in
+  manifest->offsets.reserve(manifest->entries.size() + 1);
+  manifest->data_offsets.reserve(manifest->entries.size());
+  manifest->first_junk_seeds.reserve(manifest->entries.size());
+  auto partition = manifest->partitions.cbegin();
+  u64 offset = 0;
+  u64 raw_data_offset = 0;
+  u64 raw_stored_offset = 0;
+  u64 junk_seeds = 0;
+  for (const ChunkStoreEntry& entry : manifest->entries)
+  {
+    const u64 end_offset = offset + entry.size;
+    while (partition != manifest->partitions.cend() &&
+           offset >= partition->stored_offset + partition->decrypted_size)
+    {
+      raw_data_offset = partition->entry.data_offset + partition->entry.data_size;
+      raw_stored_offset = partition->stored_offset + partition->decrypted_size;
+      ++partition;
+    }
+
+    u64 data_offset;
+    u64 region_end;
+    if (partition != manifest->partitions.cend() && offset >= partition->stored_offset)
+    {
+      data_offset = offset - partition->stored_offset;
+      region_end = partition->stored_offset + partition->decrypted_size;
+    }
+    else
+    {
+      data_offset = raw_data_offset + (offset - raw_stored_offset);
+      region_end =
+          partition != manifest->partitions.cend() ? partition->stored_offset : stored_size;
+    }
+
+    if (entry.size == 0 || end_offset > region_end)
+    {
+      ERROR_LOG_FMT(DISCIO, "Chunk store image {} has an invalid chunk entry", path);
+      return nullptr;
+    }
+
+    manifest->offsets.push_back(offset);
+    manifest->data_offsets.push_back(data_offset);
+    manifest->first_junk_seeds.push_back(junk_seeds);
+
+    if (entry.flags & CHUNK_STORE_FLAG_JUNK)
+    {
+      constexpr u64 BLOCK_SIZE = VolumeWii::BLOCK_TOTAL_SIZE;
+      junk_seeds += (data_offset + entry.size - 1) / BLOCK_SIZE - data_offset / BLOCK_SIZE + 1;
+    }
+
+    offset = end_offset;
+  }
+  manifest->offsets.push_back(offset);
+
+  if (offset != stored_size)
+  {
+    ERROR_LOG_FMT(DISCIO, "Chunk sizes in chunk store image {} don't add up", path);
+    return nullptr;
+  }
+
+  if (junk_seeds != header.num_junk_seeds)
+  {
+    ERROR_LOG_FMT(DISCIO, "Junk seeds in chunk store image {} don't add up", path);
+    return nullptr;
+  }
+
+  return manifest;
+}
+
+std::shared_ptr<const std::vector<u8>> ChunkStoreFileReader::GetChunk(size_t index)
+{
+  if (index == m_cached_chunk_index)
+    return m_cached_chunk;
+
+  const ChunkStoreEntry& entry = m_manifest->entries[index];
+
+  // The hash identifies the chunk no matter which image refers to it, so other images using
+  // the same store can share the decompressed data
+  u64 cache_key;
+  std::memcpy(&cache_key, entry.hash.data(), sizeof(cache_key));
+
+  ChunkCache& chunk_cache = ChunkCache::GetInstance();
+  std::shared_ptr<const std::vector<u8>> chunk =
+      chunk_cache.Get(m_chunk_cache_source_id, cache_key);
+  if (!chunk || chunk->size() != entry.size)
+  {
+    const std::string chunk_path = GetChunkStoreChunkPath(m_store_path, entry.hash);
+
+    std::string compressed;
+    if (!File::ReadFileToString(chunk_path, compressed))
+    {
+      ERROR_LOG_FMT(DISCIO, "Failed to read chunk {}", chunk_path);
+      return nullptr;
+    }
+
+    auto decompressed = std::make_shared<std::vector<u8>>(entry.size);
+    const size_t result = ZSTD_decompress(decompressed->data(), decompressed->size(),
+                                          compressed.data(), compressed.size());
+    if (ZSTD_isError(result) || result != entry.size ||
+        Common::SHA1::CalculateDigest(*decompressed) != entry.hash)
+    {
+      ERROR_LOG_FMT(DISCIO, "Chunk {} is corrupt", chunk_path);
+      return nullptr;
+    }
+
+    chunk = std::move(decompressed);
+    chunk_cache.Insert(m_chunk_cache_source_id, cache_key, chunk);
+  }
+
+  m_cached_chunk_index = index;
+  m_cached_chunk = chunk;
+  return chunk;
+}
+
+void ChunkStoreFileReader::GenerateJunk(size_t index, u64 offset_in_chunk, u64 size,
+                                        u8* out_ptr) const
+{
+  constexpr u64 BLOCK_SIZE = VolumeWii::BLOCK_TOTAL_SIZE;
+
+  const u64 chunk_data_offset = m_manifest->data_offsets[index];
+  u64 data_offset = chunk_data_offset + offset_in_chunk;
+  u64 seed_index = m_manifest->first_junk_seeds[index] + data_offset / BLOCK_SIZE -
+                   chunk_data_offset / BLOCK_SIZE;
+
+  LaggedFibonacciGenerator lfg;
+  while (size > 0)
+  {
+    const u64 offset_in_block = data_offset % BLOCK_SIZE;
+    const u64 bytes_to_generate = std::min(size, BLOCK_SIZE - offset_in_block);
+
+    lfg.SetSeed(m_manifest->junk_seeds[seed_index].data());
+    lfg.Forward(offset_in_block);
+    lfg.GetBytes(bytes_to_generate, out_ptr);
+
+    data_offset += bytes_to_generate;
+    size -= bytes_to_generate;
+    out_ptr += bytes_to_generate;
+    ++seed_index;
+  }
+}
+
+bool ChunkStoreFileReader::ReadStored(u64 offset, u64 size, u8* out_ptr)
+{
+  const std::vector<u64>& offsets = m_manifest->offsets;
+  if (offset > offsets.back() || size > offsets.back() - offset)
+    return false;
+
+  size_t index = std::upper_bound(offsets.begin(), offsets.end(), offset) - offsets.begin() - 1;
+
+  while (size > 0)
+  {
+    const ChunkStoreEntry& entry = m_manifest->entries[index];
+    const u64 offset_in_chunk = offset - offsets[index];
+    const u64 bytes_to_read = std::min<u64>(entry.size - offset_in_chunk, size);
+
+    if (entry.flags & CHUNK_STORE_FLAG_ZERO)
+    {
+      std::memset(out_ptr, 0, bytes_to_read);
+    }
+    else if (entry.flags & CHUNK_STORE_FLAG_JUNK)
+    {
+      GenerateJunk(index, offset_in_chunk, bytes_to_read, out_ptr);
+    }
+    else
+    {
+      const std::shared_ptr<const std::vector<u8>> chunk = GetChunk(index);
+      if (!chunk)
+        return false;
+
+      std::memcpy(out_ptr, chunk->data() + offset_in_chunk, bytes_to_read);
+    }
+
+    offset += bytes_to_read;
+    size -= bytes_to_read;
+    out_ptr += bytes_to_read;
+    ++index;
+  }
+
+  return true;
+}
+
+const ChunkStoreFileReader::Partition*
+ChunkStoreFileReader::FindPartition(u64 partition_data_offset) const
+{
+  const std::vector<Partition>& partitions = m_manifest->partitions;
+  const auto it = std::ranges::lower_bound(partitions, partition_data_offset, {},
+                                           [](const Partition& p) { return p.entry.data_offset; });
+  if (it == partitions.end() || it->entry.data_offset != partition_data_offset)
+    return nullptr;
+  return &*it;
+}
+
+bool ChunkStoreFileReader::SupportsReadWiiDecrypted(u64 offset, u64 size,
+                                                    u64 partition_data_offset) const
+{
+  const Partition* partition = FindPartition(partition_data_offset);
+  return partition && offset <= partition->decrypted_size &&
+         size <= partition->decrypted_size - offset;
+}
+
+bool ChunkStoreFileReader::ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr,
+                                            u64 partition_data_offset)
+{
+  if (!SupportsReadWiiDecrypted(offset, size, partition_data_offset))
+    return false;
+
+  const Partition* partition = FindPartition(partition_data_offset);
+  return ReadStored(partition->stored_offset + offset, size, out_ptr);
+}
+
+bool ChunkStoreFileReader::Read(u64 offset, u64 size, u8* out_ptr)
+{
+  if (offset > m_header.data_size || size > m_header.data_size - offset)
+    return false;
+
+  const std::vector<Partition>& partitions = m_manifest->partitions;
+
+  while (size > 0)
+  {
+    // The first partition that ends after the offset
+    const auto it = std::ranges::upper_bound(partitions, offset, {}, [](const Partition& p) {
+      return p.entry.data_offset + p.entry.data_size;
+    });
+
+    if (it != partitions.end() && offset >= it->entry.data_offset)
+    {
+      const ChunkStorePartitionEntry& entry = it->entry;
+      const u64 bytes_to_read = std::min(entry.data_offset + entry.data_size - offset, size);
+
+      // Without hash exceptions, the encryption cache can encrypt ahead in the background
+      WiiEncryptionCache::HashExceptionCallback hash_exception_callback;
+      if (entry.num_hash_exceptions != 0)
+      {
+        hash_exception_callback = [this, &entry](VolumeWii::HashBlock* hash_blocks,
+                                                 u64 offset_in_partition) {
+          const auto begin = m_manifest->hash_exceptions.begin() + entry.first_hash_exception;
+          const auto end = begin + entry.num_hash_exceptions;
+          const ChunkStoreHashException key{
+              static_cast<u32>(offset_in_partition / VolumeWii::GROUP_TOTAL_SIZE)};
+          const auto [first, last] =
+              std::equal_range(begin, end, key, [](const auto& a, const auto& b) {
+                return a.group_index < b.group_index;
+              });
+
+          u8* hashes = reinterpret_cast<u8*>(hash_blocks);
+          for (auto exception = first; exception != last; ++exception)
+            std::ranges::copy(exception->hash, hashes + exception->offset);
+        };
+      }
+
+      if (!m_encryption_cache.EncryptGroups(offset - entry.data_offset, bytes_to_read, out_ptr,
+                                            entry.data_offset, it->decrypted_size, entry.key,
+                                            hash_exception_callback))
+      {
+        return false;
+      }
+
+      offset += bytes_to_read;
+      size -= bytes_to_read;
+      out_ptr += bytes_to_read;
+    }
+    else
+    {
+      // Data outside of partitions is stored as is, right after the preceding partition
+      const u64 raw_end = it != partitions.end() ? it->entry.data_offset : m_header.data_size;
+      const u64 bytes_to_read = std::min(raw_end - offset, size);
+
+      u64 stored_offset = offset;
+      if (it != partitions.begin())
+      {
+        const Partition& previous = *std::prev(it);
+        stored_offset = previous.stored_offset + previous.decrypted_size +
+                        (offset - previous.entry.data_offset - previous.entry.data_size);
+      }
+
+      if (!ReadStored(stored_offset, bytes_to_read, out_ptr))
+        return false;
+
+      offset += bytes_to_read;
+      size -= bytes_to_read;
+      out_ptr += bytes_to_read;
+    }
+  }
+
+  return true;
+}
+
+// Writes the chunk to the store unless it's already there
+static bool StoreChunk(const std::string& store_path, const Common::SHA1::Digest& hash,
+                       const u8* data, size_t size, int compression_level,
+                       std::vector<u8>* compression_buffer, bool* was_new)
+{
+  const std::string chunk_path = GetChunkStoreChunkPath(store_path, hash);
+  *was_new = !File::Exists(chunk_path);
+  if (!*was_new)
+    return true;
+
+  compression_buffer->resize(ZSTD_compressBound(size));
+  const size_t compressed_size = ZSTD_compress(compression_buffer->data(),
+                                               compression_buffer->size(), data, size,
+                                               compression_level);
+  if (ZSTD_isError(compressed_size))
+    return false;
+
+  if (!File::CreateFullPath(chunk_path))
+    return false;
+
+  // Write to a temporary file first, so that a concurrent conversion using the same store
+  // never sees a partially written chunk
+  const std::string temp_path = File::GetTempFilenameForAtomicWrite(chunk_path);
+  {
+    File::IOFile file(temp_path, "wb");
+    if (!file.WriteBytes(compression_buffer->data(), compressed_size))
+    {
+      file.Close();
+      File::Delete(temp_path);
+      return false;
+    }
+  }
+
+  return File::Rename(temp_path, chunk_path);
+}
+
+namespace
+{
+struct JunkRange
+{
+  size_t start;
+  size_t end;
+  ChunkStoreJunkSeed seed;
+};
+
+// Splits data into content-defined chunks and junk chunks and writes new chunks to the store
+class ChunkWriter final
+{
+public:
+  ChunkWriter(const std::string& store_path, int compression_level)
+      : m_store_path(store_path), m_compression_level(compression_level)
+  {
+    m_pending_data.reserve(MAX_CHUNK_SIZE * 2);
+  }
+
+  bool AddData(const u8* data, size_t size)
+  {
+    if (size == 0)
+      return true;
+
+    EndJunk();
+    m_pending_data.insert(m_pending_data.end(), data, data + size);
+    return WritePendingData(false);
+  }
+
+  // Junk is passed in one range per block. Ranges that continue each other become one chunk.
+  bool AddJunk(u64 data_offset, size_t size, const ChunkStoreJunkSeed& seed)
+  {
+    if (!WritePendingData(true))
+      return false;
+
+    if (m_junk_size == 0 || data_offset != m_junk_end ||
+        data_offset % VolumeWii::BLOCK_TOTAL_SIZE != 0 || m_junk_size + size > MAX_JUNK_CHUNK_SIZE)
+    {
+      EndJunk();
+    }
+
+    m_junk_size += size;
+    m_junk_end = data_offset + size;
+    m_junk_seeds.push_back(seed);
+    return true;
+  }
+
+  // Chunks never extend past the end of a partition or of the data between partitions
+  bool EndRegion()
+  {
+    EndJunk();
+    return WritePendingData(true);
+  }
+
+  std::vector<ChunkStoreEntry>& GetEntries() { return m_entries; }
+  std::vector<ChunkStoreJunkSeed>& GetJunkSeeds() { return m_junk_seeds; }
+  u64 GetNewBytes() const { return m_new_bytes; }
+  u64 GetJunkBytes() const { return m_junk_bytes; }
+
+private:
+  void EndJunk()
+  {
+    if (m_junk_size == 0)
+      return;
+
+    ChunkStoreEntry& entry = m_entries.emplace_back();
+    entry.hash = {};
+    entry.size = static_cast<u32>(m_junk_size);
+    entry.flags = CHUNK_STORE_FLAG_JUNK;
+
+    m_junk_bytes += m_junk_size;
+    m_junk_size = 0;
+  }
+
+  bool WritePendingData(bool at_end)
+  {
+    size_t position = 0;
+    bool success = true;
+    while (position < m_pending_data.size())
+    {
+      // Don't cut chunks short just because the buffer ends
+      const size_t available = m_pending_data.size() - position;
+      if (!at_end && available < MAX_CHUNK_SIZE)
+        break;
+
+      const u8* chunk_data = m_pending_data.data() + position;
+      const size_t chunk_size = FindChunkBoundary(chunk_data, available);
+
+      ChunkStoreEntry& entry = m_entries.emplace_back();
+      entry.hash = Common::SHA1::CalculateDigest(chunk_data, chunk_size);
+      entry.size = static_cast<u32>(chunk_size);
+      entry.flags = 0;
+
+      if (std::all_of(chunk_data, chunk_data + chunk_size, [](u8 x) { return x == 0; }))
+      {
+        entry.flags |= CHUNK_STORE_FLAG_ZERO;
+      }
+      else
+      {
+        bool was_new;
+        if (!StoreChunk(m_store_path, entry.hash, chunk_data, chunk_size, m_compression_level,
+                        &m_compression_buffer, &was_new))
+        {
+          success = false;
+          break;
+        }
+
+        if (was_new)
+          m_new_bytes += chunk_size;
+      }
+
+      position += chunk_size;
+    }
+
+    m_pending_data.erase(m_pending_data.begin(), m_pending_data.begin() + position);
+    return success;
+  }
+
+  const std::string& m_store_path;
+  int m_compression_level;
+
+  std::vector<u8> m_pending_data;
+  std::vector<u8> m_compression_buffer;
+
+  u64 m_junk_size = 0;
+  u64 m_junk_end = 0;
+
+  std::vector<ChunkStoreEntry> m_entries;
+  std::vector<ChunkStoreJunkSeed> m_junk_seeds;
+  u64 m_new_bytes = 0;
+  u64 m_junk_bytes = 0;
+};
+}  // namespace
+
+// Finds junk data the same way as RVZPack in WIABlob.cpp does. data_offset is the offset of the
+// data in the disc, or in the decrypted data for data in partitions. Ranges never extend past the
+// end of a block.
+static std::vector<JunkRange> FindJunk(const u8* data, size_t size, u64 data_offset,
+                                       const FileSystem* file_system)
+{
+  std::vector<JunkRange> junk;
+
+  size_t position = 0;
+  while (position < size)
+  {
+    // Skip the 0 to 32 zero bytes that typically come after a file
+    while (position < size && data[position] == 0)
+    {
+      ++position;
+      ++data_offset;
+    }
+
+    const size_t bytes_to_read = static_cast<size_t>(
+        std::min<u64>(Common::AlignUp(data_offset + 1, VolumeWii::BLOCK_TOTAL_SIZE) - data_offset,
+                      size - position));
+
+    ChunkStoreJunkSeed seed;
+    const size_t bytes_reconstructed =
+        LaggedFibonacciGenerator::GetSeed(data + position, bytes_to_read,
+                                          data_offset % VolumeWii::BLOCK_TOTAL_SIZE, seed.data());
+
+    if (bytes_reconstructed > 0)
+      junk.push_back(JunkRange{position, position + bytes_reconstructed, seed});
+
+    if (file_system)
+    {
+      const std::unique_ptr<FileInfo> file_info =
+          file_system->FindFileInfo(data_offset + bytes_reconstructed);
+
+      // If we're at a file and there's more space in this block after the file,
+      // continue after the file instead of skipping to the next block
+      if (file_info)
+      {
+        const u64 file_end_offset = file_info->GetOffset() + file_info->GetSize();
+        if (file_end_offset < data_offset + bytes_to_read)
+        {
+          position += file_end_offset - data_offset;
+          data_offset = file_end_offset;
+          continue;
+        }
+      }
+    }
+
+    position += bytes_to_read;
+    data_offset += bytes_to_read;
+  }
+
+  return junk;
+}
+
+static bool AddDataAndJunk(ChunkWriter* writer, const u8* data, size_t size, u64 data_offset,
+                           const FileSystem* file_system)
+{
+  size_t position = 0;
+  for (const JunkRange& junk : FindJunk(data, size, data_offset, file_system))
+  {
+    if (!writer->AddData(data + position, junk.start - position) ||
+        !writer->AddJunk(data_offset + junk.start, junk.end - junk.start, junk.seed))
+    {
+      return false;
+    }
+    position = junk.end;
+  }
+
+  return writer->AddData(data + position, size - position);
+}
+
+// Returns the partitions whose data can be stored decrypted
+static std::vector<ChunkStorePartitionEntry>
+GetPartitionsForWriting(const VolumeDisc* volume, u64 iso_size,
+                        std::vector<const FileSystem*>* partition_file_systems)
+{
+  std::vector<ChunkStorePartitionEntry> entries;
+  if (!volume || !volume->HasWiiHashes() || !volume->HasWiiEncryption())
+    return entries;
+
+  std::vector<Partition> partitions = volume->GetPartitions();
+  std::ranges::sort(partitions, {}, &Partition::offset);
+
+  u64 last_partition_end_offset = 0;
+  for (const Partition& partition : partitions)
+  {
+    // Partitions that are odd in some way are stored like the rest of the disc instead
+    const std::optional<u64> data_offset =
+        volume->ReadSwappedAndShifted(partition.offset + 0x2b8, PARTITION_NONE);
+    const std::optional<u64> data_size =
+        volume->ReadSwappedAndShifted(partition.offset + 0x2bc, PARTITION_NONE);
+    if (!data_offset || !data_size || partition.offset < last_partition_end_offset)
+    {
+      WARN_LOG_FMT(DISCIO, "Invalid partition at {:x}", partition.offset);
+      continue;
+    }
+
+    const u64 data_start = partition.offset + *data_offset;
+    if (data_start % VolumeWii::BLOCK_TOTAL_SIZE != 0 || data_start >= iso_size)
+    {
+      WARN_LOG_FMT(DISCIO, "Misaligned partition at {:x}", partition.offset);
+      continue;
+    }
+
+    const u64 size =
+        Common::AlignDown(std::min(*data_size, iso_size - data_start), VolumeWii::BLOCK_TOTAL_SIZE);
+    const IOS::ES::TicketReader& ticket = volume->GetTicket(partition);
+    if (size == 0 || !ticket.IsValid())
+    {
+      WARN_LOG_FMT(DISCIO, "Invalid partition at {:x}", partition.offset);
+      continue;
+    }
+
+    ChunkStorePartitionEntry& entry = entries.emplace_back();
+    entry.key = ticket.GetTitleKey();
+    entry.data_offset = data_start;
+    entry.data_size = size;
+    entry.first_hash_exception = 0;
+    entry.num_hash_exceptions = 0;
+    partition_file_systems->push_back(volume->GetFileSystem(partition));
+
+    last_partition_end_offset = data_start + size;
+  }
+
+  return entries;
+}
+
+// Decrypts one group of a partition and adds the hashes that don't match the decrypted data to
+// hash_exceptions. Missing blocks at the end of the partition count as zeroes, like when reading.
+static void DecryptGroup(const u8* in, size_t blocks, u32 group_index,
+                         Common::AES::Context* aes_context,
+                         std::array<u8, VolumeWii::BLOCK_DATA_SIZE>* decrypted,
+                         VolumeWii::HashBlock* computed_hashes,
+                         std::vector<ChunkStoreHashException>* hash_exceptions)
+{
+  for (size_t i = 0; i < VolumeWii::BLOCKS_PER_GROUP; ++i)
+  {
+    if (i < blocks)
+      VolumeWii::DecryptBlockData(in + i * VolumeWii::BLOCK_TOTAL_SIZE, decrypted[i].data(),
+                                  aes_context);
+    else
+      decrypted[i].fill(0);
+  }
+
+  VolumeWii::HashGroup(decrypted, computed_hashes);
+
+  for (size_t i = 0; i < blocks; ++i)
+  {
+    VolumeWii::HashBlock hashes;
+    VolumeWii::DecryptBlockHashes(in + i * VolumeWii::BLOCK_TOTAL_SIZE, &hashes, aes_context);
+
+    const u8* desired = reinterpret_cast<const u8*>(&hashes);
+    const u8* computed = reinterpret_cast<const u8*>(&computed_hashes[i]);
+    for (size_t j = 0; j < sizeof(hashes); j += Common::SHA1::DIGEST_LEN)
+    {
+      // The last exception overlaps the one before it, since the block size isn't divisible by
+      // the digest size
+      const size_t offset = std::min(j, sizeof(hashes) - Common::SHA1::DIGEST_LEN);
+      if (std::equal(desired + offset, desired + offset + Common::SHA1::DIGEST_LEN,
+                     computed + offset))
+      {
+        continue;
+      }
+
+      ChunkStoreHashException& exception = hash_exceptions->emplace_back();
+      exception.group_index = group_index;
+      exception.offset = static_cast<u32>(i * sizeof(hashes) + offset);
+      std::copy_n(desired + offset, Common::SHA1::DIGEST_LEN, exception.hash.begin());
+    }
+  }
+}
+
+bool ConvertToChunkStore(BlobReader* infile, const std::string& infile_path,
+                         const std::string& outfile_path, const std::string& store_path,
+                         int compression_level, CompressCB callback)
+{
+  ASSERT(infile->GetDataSizeType() == DataSizeType::Accurate);
+
+  const std::string relative_store_path =
+      store_path.empty() ? DEFAULT_CHUNK_STORE_PATH : store_path;
+  const std::string resolved_store_path = ResolveStorePath(outfile_path, relative_store_path);
+
+  File::IOFile outfile(outfile_path, "wb");
+  if (!outfile)
+  {
+    PanicAlertFmtT(
+        "Failed to open the output file \"{0}\".\n"
+        "Check that you have permissions to write the target folder and that the media can "
+        "be written.",
+        outfile_path);
+    return false;
+  }
+
+  const std::unique_ptr<VolumeDisc> infile_volume = CreateDisc(infile_path);
+
+  ChunkStoreHeader header{};
+  header.magic = CHUNK_STORE_MAGIC;
+  header.version = CHUNK_STORE_VERSION;
+  header.data_size = infile->GetDataSize();
+  header.store_path_size = static_cast<u32>(relative_store_path.size());
+
+  std::vector<const FileSystem*> partition_file_systems;
+  std::vector<ChunkStorePartitionEntry> partitions =
+      GetPartitionsForWriting(infile_volume.get(), header.data_size, &partition_file_systems);
+  std::vector<ChunkStoreHashException> hash_exceptions;
+
+  ChunkWriter writer(resolved_store_path, compression_level);
+
+  constexpr size_t BUFFER_SIZE = 0x400000;
+  std::vector<u8> buffer;
+  std::vector<std::array<u8, VolumeWii::BLOCK_DATA_SIZE>> decrypted(VolumeWii::BLOCKS_PER_GROUP);
+  std::vector<VolumeWii::HashBlock> computed_hashes(VolumeWii::BLOCKS_PER_GROUP);
+
+  u64 offset = 0;
+  bool read_failed = false;
+  bool write_failed = false;
+
+  const auto read = [&](u64 size) {
+    const bool was_cancelled =
+        !callback(Common::GetStringT("Converting..."),
+                  static_cast<float>(offset) / static_cast<float>(header.data_size));
+    if (was_cancelled)
+      return false;
+
+    buffer.resize(size);
+    if (!infile->Read(offset, size, buffer.data()))
+    {
+      read_failed = true;
+      return false;
+    }
+
+    offset += size;
+    return true;
+  };
+
+  const auto convert_raw_data = [&](u64 end_offset) {
+    const FileSystem* file_system =
+        infile_volume && partitions.empty() ? infile_volume->GetFileSystem(PARTITION_NONE) :
+                                              nullptr;
+    while (offset < end_offset)
+    {
+      // Reading whole blocks lets junk be found in every block
+      const u64 data_offset = offset;
+      const u64 read_end = std::min(
+          end_offset, Common::AlignDown(offset + BUFFER_SIZE, VolumeWii::BLOCK_TOTAL_SIZE));
+      if (!read(read_end - offset))
+        return false;
+
+      if (!AddDataAndJunk(&writer, buffer.data(), buffer.size(), data_offset, file_system))
+      {
+        write_failed = true;
+        return false;
+      }
+    }
+
+    write_failed = !writer.EndRegion();
+    return !write_failed;
+  };
+
+  const auto convert_partition = [&](ChunkStorePartitionEntry* partition,
+                                     const FileSystem* file_system) {
+    partition->first_hash_exception = hash_exceptions.size();
+
+    const std::unique_ptr<Common::AES::Context> aes_context =
+        Common::AES::CreateContextDecrypt(partition->key.data());
+
+    const u64 end_offset = partition->data_offset + partition->data_size;
+    for (u32 group_index = 0; offset < end_offset; ++group_index)
+    {
+      if (!read(std::min(VolumeWii::GROUP_TOTAL_SIZE, end_offset - offset)))
+        return false;
+
+      const size_t blocks = buffer.size() / VolumeWii::BLOCK_TOTAL_SIZE;
+      DecryptGroup(buffer.data(), blocks, group_index, aes_context.get(), decrypted.data(),
+                   computed_hashes.data(), &hash_exceptions);
+
+      if (!AddDataAndJunk(&writer, decrypted[0].data(), blocks * VolumeWii::BLOCK_DATA_SIZE,
+                          group_index * VolumeWii::GROUP_DATA_SIZE, file_system))
+      {
+        write_failed = true;
+        return false;
+      }
+    }
+
+    partition->num_hash_exceptions = hash_exceptions.size() - partition->first_hash_exception;
+
+    write_failed = !writer.EndRegion();
+    return !write_failed;
+  };
+
+  bool success = true;
+  for (size_t i = 0; i < partitions.size() && success; ++i)
+  {
+    success = convert_raw_data(partitions[i].data_offset) &&
+              convert_partition(&partitions[i], partition_file_systems[i]);
+  }
+  success = success && convert_raw_data(header.data_size);
+
+  if (read_failed)
+    PanicAlertFmtT("Failed to read from the input file \"{0}\".", infile_path);
+  if (write_failed)
+    PanicAlertFmtT("Failed to write to the chunk store \"{0}\".", resolved_store_path);
+
+  const std::vector<ChunkStoreEntry>& entries = writer.GetEntries();
+  const std::vector<ChunkStoreJunkSeed>& junk_seeds = writer.GetJunkSeeds();
+
+  if (success)
+  {
+    header.num_chunks = entries.size();
+    header.num_hash_exceptions = hash_exceptions.size();
+    header.num_junk_seeds = junk_seeds.size();
+    header.num_partitions = static_cast<u32>(partitions.size());
+    success = outfile.WriteArray(&header, 1) &&
+              outfile.WriteBytes(relative_store_path.data(), relative_store_path.size()) &&
+              outfile.WriteArray(partitions.data(), partitions.size()) &&
+              outfile.WriteArray(entries.data(), entries.size()) &&
+              outfile.WriteArray(hash_exceptions.data(), hash_exceptions.size()) &&
+              outfile.WriteArray(junk_seeds.data(), junk_seeds.size());
+
+    if (!success)
+    {
+      PanicAlertFmtT("Failed to write the output file \"{0}\".\n"
+                     "Check that you have enough space available on the target drive.",
+                     outfile_path);
+    }
+  }
+
+  if (success)
+  {
+    INFO_LOG_FMT(DISCIO,
+                 "Converted {} into {} chunks, {} of {} bytes were new to the store, {} bytes "
+                 "were junk",
+                 infile_path, entries.size(), writer.GetNewBytes(), header.data_size,
+                 writer.GetJunkBytes());
+  }
+  else
+  {
+    // Remove the incomplete output file. Chunks that were written to the store are valid
+    // on their own, so they are kept for the next attempt.
+    outfile.Close();
+    File::Delete(outfile_path);
+  }
+
+  return success;
+}
+
+}  // namespace DiscIO
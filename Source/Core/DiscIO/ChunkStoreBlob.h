@@ -0,0 +1,196 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// WARNING Code not big-endian safe.
+
+// File format
+// * Header
+// * Path of the chunk store (not null-terminated)
+// * [Partition entries]
+// * [Chunk entries]
+// * [Hash exception entries]
+// * [Junk seeds]
+//
+// The disc data itself is split into variable-sized chunks using content-defined chunking,
+// so that data which is shared between several disc images (regional variants, revisions)
+// ends up in identical chunks even if it is at different offsets. Each chunk is stored
+// Zstandard-compressed in a content-addressed store directory, named after the SHA-1 of its
+// uncompressed data. Any number of images can refer to the same store, and a chunk that
+// already exists in the store is never written again.
+//
+// Like in WIA and RVZ, encrypted Wii partitions are chunked in decrypted form, without the
+// hashes, so that identical data can be shared no matter which key it was encrypted with.
+// Reads re-encrypt the data and recalculate the hashes. Hashes which don't match the data
+// are stored in the manifest as hash exceptions. Junk data (the padding that Nintendo's
+// mastering tools generate) isn't stored in chunks either. Like in RVZ, only the seeds needed
+// for generating it again are stored.
+//
+// The chunks describe the data of the disc in order, except that each partition contributes
+// its decrypted data instead of its encrypted data. A chunk never extends across the start or
+// end of a partition.
+
+#pragma once
+
+#include <array>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+#include "Common/IOFile.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/LaggedFibonacciGenerator.h"
+#include "DiscIO/VolumeWii.h"
+#include "DiscIO/WiiEncryptionCache.h"
+
+namespace DiscIO
+{
+static constexpr u32 CHUNK_STORE_MAGIC = 0x01534344;  // "DCS\x01" (byteswapped to little endian)
+static constexpr u32 CHUNK_STORE_VERSION = 2;
+
+// The store path used when none is specified, relative to the directory of the image
+static constexpr char DEFAULT_CHUNK_STORE_PATH[] = "chunks";
+
+struct ChunkStoreHeader  // 48 bytes
+{
+  u32 magic;
+  u32 version;
+  u64 data_size;
+  u64 num_chunks;
+  u64 num_hash_exceptions;
+  u64 num_junk_seeds;
+  u32 num_partitions;
+  // If the store path is relative, it's relative to the directory that contains the image
+  u32 store_path_size;
+};
+static_assert(sizeof(ChunkStoreHeader) == 48);
+
+struct ChunkStorePartitionEntry  // 48 bytes
+{
+  WiiEncryptionCache::Key key;
+  // Offset and size of the encrypted data on the disc. The size is a multiple of the block size
+  u64 data_offset;
+  u64 data_size;
+  u64 first_hash_exception;
+  u64 num_hash_exceptions;
+};
+static_assert(sizeof(ChunkStorePartitionEntry) == 48);
+
+enum ChunkStoreEntryFlags : u32
+{
+  // The chunk contains only zeroes and has no file in the store
+  CHUNK_STORE_FLAG_ZERO = 1,
+  // The chunk is junk data and has no file in the store. It uses one junk seed for each
+  // VolumeWii::BLOCK_TOTAL_SIZE-aligned block that it overlaps. Junk chunks take their seeds
+  // from the list of junk seeds in order.
+  CHUNK_STORE_FLAG_JUNK = 2,
+};
+
+struct ChunkStoreEntry  // 28 bytes
+{
+  // Unused for chunks which have no file in the store
+  Common::SHA1::Digest hash;
+  u32 size;
+  u32 flags;
+};
+static_assert(sizeof(ChunkStoreEntry) == 28);
+
+// Hash exceptions of a partition are sorted by group
+struct ChunkStoreHashException  // 28 bytes
+{
+  u32 group_index;
+  // Offset in the hash blocks of the group
+  u32 offset;
+  Common::SHA1::Digest hash;
+};
+static_assert(sizeof(ChunkStoreHashException) == 28);
+
+using ChunkStoreJunkSeed = std::array<u32, LaggedFibonacciGenerator::SEED_SIZE>;
+
+class ChunkStoreFileReader final : public BlobReader
+{
+public:
+  static std::unique_ptr<ChunkStoreFileReader> Create(File::IOFile file, const std::string& path);
+
+  BlobType GetBlobType() const override { return BlobType::CHUNK_STORE; }
+  std::unique_ptr<BlobReader> CopyReader() const override;
+
+  u64 GetRawSize() const override { return m_file_size; }
+  u64 GetDataSize() const override { return m_header.data_size; }
+  DataSizeType GetDataSizeType() const override { return DataSizeType::Accurate; }
+
+  // Chunks vary in size
+  u64 GetBlockSize() const override { return 0; }
+  bool HasFastRandomAccessInBlock() const override { return false; }
+  std::string GetCompressionMethod() const override { return "Zstandard"; }
+  std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
+
+  bool Read(u64 offset, u64 size, u8* out_ptr) override;
+
+  bool SupportsReadWiiDecrypted(u64 offset, u64 size, u64 partition_data_offset) const override;
+  bool ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset) override;
+
+  const std::string& GetStorePath() const { return m_store_path; }
+
+private:
+  struct Partition
+  {
+    ChunkStorePartitionEntry entry;
+    u64 decrypted_size;
+    // Where the decrypted data starts in the chunks
+    u64 stored_offset;
+  };
+
+  struct Manifest
+  {
+    ChunkStoreHeader header;
+    std::string store_path;
+    std::vector<Partition> partitions;
+    std::vector<ChunkStoreEntry> entries;
+    std::vector<ChunkStoreHashException> hash_exceptions;
+    std::vector<ChunkStoreJunkSeed> junk_seeds;
+    // Offset in the chunks of each entry, plus the total size of the chunks as the last element
+    std::vector<u64> offsets;
+    // Offset of each entry in the disc, or in the decrypted data for chunks in partitions
+    std::vector<u64> data_offsets;
+    // Index of the first junk seed used by each entry
+    std::vector<u64> first_junk_seeds;
+  };
+
+  ChunkStoreFileReader(File::IOFile file, const std::string& path,
+                       std::shared_ptr<const Manifest> manifest);
+
+  static std::shared_ptr<const Manifest> LoadManifest(File::IOFile* file, const std::string& path);
+
+  // Returns nullptr if the chunk couldn't be read
+  std::shared_ptr<const std::vector<u8>> GetChunk(size_t index);
+
+  // Reads from the data that the chunks describe, which has partitions in decrypted form
+  bool ReadStored(u64 offset, u64 size, u8* out_ptr);
+  void GenerateJunk(size_t index, u64 offset_in_chunk, u64 size, u8* out_ptr) const;
+
+  const Partition* FindPartition(u64 partition_data_offset) const;
+
+  File::IOFile m_file;
+  std::string m_path;
+  u64 m_file_size;
+
+  // Shared between copies of this reader
+  std::shared_ptr<const Manifest> m_manifest;
+  const ChunkStoreHeader& m_header;
+  const std::string& m_store_path;
+
+  u64 m_chunk_cache_source_id;
+  size_t m_cached_chunk_index = std::numeric_limits<size_t>::max();
+  std::shared_ptr<const std::vector<u8>> m_cached_chunk;
+
+  WiiEncryptionCache m_encryption_cache;
+};
+
+// Returns the path of the file that holds the chunk with the given hash
+std::string GetChunkStoreChunkPath(const std::string& store_path, const Common::SHA1::Digest& hash);
+
+}  // namespace DiscIO
@@ -4,6 +4,7 @@
 #include "DiscIO/CompressedBlob.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <cstring>
 #include <memory>
@@ -25,6 +26,7 @@
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/ParallelFor.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscScrubber.h"
 #include "DiscIO/MultithreadedCompressor.h"
@@ -92,25 +94,33 @@ u64 CompressedBlobReader::GetBlockCompressedSize(u64 block_num) const
   return 0;
 }
 
-bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
+CompressedBlobReader::BlockLocation CompressedBlobReader::GetBlockLocation(u64 block_num) const
 {
-  bool uncompressed = false;
-  u32 comp_block_size = (u32)GetBlockCompressedSize(block_num);
-  u64 offset = m_block_pointers[block_num] + m_data_offset;
+  BlockLocation location;
+  location.size = (u32)GetBlockCompressedSize(block_num);
+  location.offset = m_block_pointers[block_num] + m_data_offset;
+  location.uncompressed = false;
 
-  if (offset & (1ULL << 63))
+  if (location.offset & (1ULL << 63))
   {
-    if (comp_block_size != m_header.block_size)
+    if (location.size != m_header.block_size)
       ERROR_LOG_FMT(DISCIO, "Uncompressed block with wrong size");
-    uncompressed = true;
-    offset &= ~(1ULL << 63);
+    location.uncompressed = true;
+    location.offset &= ~(1ULL << 63);
   }
 
+  return location;
+}
+
+bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
+{
+  const BlockLocation location = GetBlockLocation(block_num);
+
   // clear unused part of zlib buffer. maybe this can be deleted when it works fully.
-  memset(&m_zlib_buffer[comp_block_size], 0, m_zlib_buffer.size() - comp_block_size);
+  memset(&m_zlib_buffer[location.size], 0, m_zlib_buffer.size() - location.size);
 
-  m_file.Seek(offset, File::SeekOrigin::Begin);
-  if (!m_file.ReadBytes(m_zlib_buffer.data(), comp_block_size))
+  m_file.Seek(location.offset, File::SeekOrigin::Begin);
+  if (!m_file.ReadBytes(m_zlib_buffer.data(), location.size))
   {
     ERROR_LOG_FMT(DISCIO, "The disc image \"{}\" is truncated, some of the data is missing.",
                   m_file_name);
@@ -118,8 +128,16 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
     return false;
   }
 
+  return DecompressBlock(block_num, m_zlib_buffer.data(), location, out_ptr);
+}
+
+bool CompressedBlobReader::DecompressBlock(u64 block_num, const u8* in,
+                                           const BlockLocation& location, u8* out_ptr) const
+{
+  const u32 comp_block_size = location.size;
+
   // First, check hash.
-  const u32 block_hash = Common::HashAdler32(m_zlib_buffer.data(), comp_block_size);
+  const u32 block_hash = Common::HashAdler32(in, comp_block_size);
   if (block_hash != m_hashes[block_num])
   {
     ERROR_LOG_FMT(DISCIO,
@@ -128,14 +146,14 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
                   m_file_name, block_num, block_hash, m_hashes[block_num]);
   }
 
-  if (uncompressed)
+  if (location.uncompressed)
   {
-    std::copy_n(m_zlib_buffer.begin(), comp_block_size, out_ptr);
+    std::copy_n(in, comp_block_size, out_ptr);
   }
   else
   {
     z_stream z = {};
-    z.next_in = m_zlib_buffer.data();
+    z.next_in = const_cast<u8*>(in);
     z.avail_in = comp_block_size;
     if (z.avail_in > m_header.block_size)
     {
@@ -162,6 +180,47 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
   return true;
 }
 
+bool CompressedBlobReader::ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr)
+{
+  // For short reads, waking up the worker threads costs more than decompressing on this thread
+  constexpr u64 MIN_PARALLEL_BLOCKS = 8;
+  if (num_blocks < MIN_PARALLEL_BLOCKS || Common::GetParallelForThreadCount() < 2)
+    return SectorReader::ReadMultipleAlignedBlocks(block_num, num_blocks, out_ptr);
+
+  // Blocks are normally stored back to back, which lets us read all of them at once
+  std::vector<BlockLocation> locations(num_blocks);
+  for (u64 i = 0; i < num_blocks; ++i)
+  {
+    locations[i] = GetBlockLocation(block_num + i);
+    if (i > 0 && locations[i].offset != locations[i - 1].offset + locations[i - 1].size)
+      return SectorReader::ReadMultipleAlignedBlocks(block_num, num_blocks, out_ptr);
+  }
+
+  const u64 first_offset = locations.front().offset;
+  m_multi_block_buffer.resize(locations.back().offset + locations.back().size - first_offset);
+
+  m_file.Seek(first_offset, File::SeekOrigin::Begin);
+  if (!m_file.ReadBytes(m_multi_block_buffer.data(), m_multi_block_buffer.size()))
+  {
+    ERROR_LOG_FMT(DISCIO, "The disc image \"{}\" is truncated, some of the data is missing.",
+                  m_file_name);
+    m_file.ClearError();
+    return false;
+  }
+
+  std::atomic<bool> success = true;
+  Common::ParallelFor(num_blocks, [&](size_t i) {
+    if (!DecompressBlock(block_num + i,
+                         m_multi_block_buffer.data() + locations[i].offset - first_offset,
+                         locations[i], out_ptr + i * m_header.block_size))
+    {
+      success = false;
+    }
+  });
+
+  return success;
+}
+
 struct CompressThreadState
 {
   CompressThreadState() : z{} {}
@@ -64,9 +64,24 @@ public:
   u64 GetBlockCompressedSize(u64 block_num) const;
   bool GetBlock(u64 block_num, u8* out_ptr) override;
 
+protected:
+  bool ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr) override;
+
 private:
+  struct BlockLocation
+  {
+    u64 offset;
+    u32 size;
+    bool uncompressed;
+  };
+
   CompressedBlobReader(File::IOFile file, const std::string& filename);
 
+  BlockLocation GetBlockLocation(u64 block_num) const;
+  // Thread-safe
+  bool DecompressBlock(u64 block_num, const u8* in, const BlockLocation& location,
+                       u8* out_ptr) const;
+
   CompressedBlobHeader m_header;
   std::vector<u64> m_block_pointers;
   std::vector<u32> m_hashes;
@@ -74,6 +89,7 @@ private:
   File::IOFile m_file;
   u64 m_file_size;
   std::vector<u8> m_zlib_buffer;
+  std::vector<u8> m_multi_block_buffer;
   std::string m_file_name;
 };
 
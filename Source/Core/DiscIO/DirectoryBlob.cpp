@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
 #include <locale>
 #include <map>
@@ -15,13 +16,18 @@
 #include <variant>
 #include <vector>
 
+#include <fmt/format.h>
+
 #include "Common/Align.h"
 #include "Common/Assert.h"
+#include "Common/ChunkFile.h"
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
+#include "Common/ParallelFor.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
 #include "Core/Boot/DolReader.h"
@@ -97,9 +103,9 @@ bool DiscContent::Read(u64* offset, u64* length, u8** buffer, DirectoryBlobReade
     if (std::holds_alternative<ContentFile>(m_content_source))
     {
       const auto& content = std::get<ContentFile>(m_content_source);
-      File::IOFile file(content.m_filename, "rb");
-      if (!file.Seek(content.m_offset + offset_in_content, File::SeekOrigin::Begin) ||
-          !file.ReadBytes(*buffer, bytes_to_read))
+      File::IOFile* file = blob->GetOpenFile(content.m_filename);
+      if (!file || !file->Seek(content.m_offset + offset_in_content, File::SeekOrigin::Begin) ||
+          !file->ReadBytes(*buffer, bytes_to_read))
       {
         return false;
       }
@@ -485,6 +491,30 @@ DirectoryBlobReader::DirectoryBlobReader(const DirectoryBlobReader& rhs)
 {
 }
 
+File::IOFile* DirectoryBlobReader::GetOpenFile(const std::string& path)
+{
+  ++m_open_files_counter;
+
+  auto it = std::ranges::find(m_open_files, path, &OpenFile::path);
+  if (it == m_open_files.end())
+  {
+    File::IOFile file(path, "rb");
+    if (!file)
+      return nullptr;
+
+    if (m_open_files.size() < MAX_OPEN_FILES)
+      it = m_open_files.emplace(m_open_files.end());
+    else
+      it = std::ranges::min_element(m_open_files, {}, &OpenFile::last_used);
+
+    it->path = path;
+    it->file = std::move(file);
+  }
+
+  it->last_used = m_open_files_counter;
+  return &it->file;
+}
+
 bool DirectoryBlobReader::Read(u64 offset, u64 length, u8* buffer)
 {
   if (offset + length > m_data_size)
@@ -1079,10 +1109,159 @@ static std::vector<FSTBuilderNode> ConvertFSTEntriesToBuilderNodes(const File::F
   return nodes;
 }
 
+// Scanning the files directory of a big game means listing every directory and calling stat on
+// every single file, which is slow on network shares and for cold disk caches. The result of the
+// scan is cached along with the size and modification time of every file and directory. When the
+// cache is loaded, those are checked again in parallel, which is much faster than a sequential
+// scan when each stat call has to wait for the disk or the network. If anything differs, the
+// directory is scanned again. Adding, removing or renaming a file updates the modification time
+// of its parent directory, and changing the contents of a file updates its own.
+struct DirectoryTreeCache
+{
+  static constexpr u32 REVISION = 2;
+
+  struct Entry
+  {
+    std::string path;
+    u64 size;
+    s64 time;
+  };
+
+  std::string root;
+  File::FSTEntry tree;
+  std::vector<Entry> entries;
+};
+
+static std::string GetCachePathForDirectory(const std::string& directory)
+{
+  const std::string hash =
+      Common::SHA1::DigestToString(Common::SHA1::CalculateDigest(std::string_view(directory)));
+  return fmt::format("{}DirectoryBlob/{}.cache", File::GetUserPath(D_CACHE_IDX),
+                     hash.substr(0, 16));
+}
+
+static void GetCacheEntries(const File::FSTEntry& entry,
+                            std::vector<DirectoryTreeCache::Entry>* entries)
+{
+  // File::GetSize returns 0 for directories, which is what's checked when loading the cache
+  entries->push_back({entry.physicalName, entry.isDirectory ? 0 : entry.size,
+                      File::GetLastWriteTime(entry.physicalName).value_or(0)});
+  for (const File::FSTEntry& child : entry.children)
+    GetCacheEntries(child, entries);
+}
+
+static void DoFSTEntry(PointerWrap& p, File::FSTEntry& entry)
+{
+  p.Do(entry.isDirectory);
+  p.Do(entry.size);
+  p.Do(entry.physicalName);
+  p.Do(entry.virtualName);
+  p.DoEachElement(entry.children, DoFSTEntry);
+}
+
+static void DoDirectoryTreeCache(PointerWrap& p, DirectoryTreeCache& cache)
+{
+  u32 revision = DirectoryTreeCache::REVISION;
+  p.Do(revision);
+  if (p.IsReadMode() && revision != DirectoryTreeCache::REVISION)
+  {
+    p.SetMeasureMode();
+    return;
+  }
+
+  p.Do(cache.root);
+  DoFSTEntry(p, cache.tree);
+  p.DoEachElement(cache.entries, [](PointerWrap& p_, DirectoryTreeCache::Entry& entry) {
+    p_.Do(entry.path);
+    p_.Do(entry.size);
+    p_.Do(entry.time);
+  });
+}
+
+static std::optional<File::FSTEntry> LoadDirectoryTreeCache(const std::string& cache_path,
+                                                            const std::string& directory)
+{
+  File::IOFile file(cache_path, "rb");
+  if (!file)
+    return std::nullopt;
+
+  std::vector<u8> buffer(file.GetSize());
+  if (buffer.empty() || !file.ReadBytes(buffer.data(), buffer.size()))
+    return std::nullopt;
+
+  DirectoryTreeCache cache;
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+  DoDirectoryTreeCache(p, cache);
+  if (!p.IsReadMode() || cache.root != directory)
+    return std::nullopt;
+
+  std::atomic<bool> unchanged = true;
+  Common::ParallelFor(cache.entries.size(), [&](size_t i) {
+    if (!unchanged.load(std::memory_order_relaxed))
+      return;
+
+    const DirectoryTreeCache::Entry& entry = cache.entries[i];
+    if (File::GetSize(entry.path) != entry.size ||
+        File::GetLastWriteTime(entry.path) != entry.time)
+    {
+      INFO_LOG_FMT(DISCIO, "{} has changed since {} was scanned", entry.path, directory);
+      unchanged.store(false, std::memory_order_relaxed);
+    }
+  });
+  if (!unchanged)
+    return std::nullopt;
+
+  return std::move(cache.tree);
+}
+
+static void SaveDirectoryTreeCache(const std::string& cache_path, const std::string& directory,
+                                   const File::FSTEntry& tree)
+{
+  DirectoryTreeCache cache{directory, tree, {}};
+  GetCacheEntries(cache.tree, &cache.entries);
+
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  DoDirectoryTreeCache(p_measure, cache);
+  const size_t buffer_size = reinterpret_cast<size_t>(ptr);
+
+  std::vector<u8> buffer(buffer_size);
+  ptr = buffer.data();
+  PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
+  DoDirectoryTreeCache(p, cache);
+
+  if (!File::CreateFullPath(cache_path))
+    return;
+
+  // Write to a temporary file first so that a partially written cache is never loaded
+  const std::string temp_path = File::GetTempFilenameForAtomicWrite(cache_path);
+  File::IOFile file(temp_path, "wb");
+  if (!file || !file.WriteBytes(buffer.data(), buffer.size()))
+  {
+    file.Close();
+    File::Delete(temp_path);
+    return;
+  }
+  file.Close();
+
+  if (!File::Rename(temp_path, cache_path))
+    File::Delete(temp_path);
+}
+
 void DirectoryBlobPartition::BuildFSTFromFolder(const std::string& fst_root_path, u64 fst_address,
                                                 std::vector<u8>* disc_header)
 {
-  auto nodes = ConvertFSTEntriesToBuilderNodes(File::ScanDirectoryTree(fst_root_path, true));
+  const std::string cache_path = GetCachePathForDirectory(fst_root_path);
+
+  std::optional<File::FSTEntry> tree = LoadDirectoryTreeCache(cache_path, fst_root_path);
+  if (!tree)
+  {
+    tree = File::ScanDirectoryTree(fst_root_path, true);
+    SaveDirectoryTreeCache(cache_path, fst_root_path, *tree);
+  }
+
+  auto nodes = ConvertFSTEntriesToBuilderNodes(*tree);
   BuildFST(std::move(nodes), fst_address, disc_header);
 }
 
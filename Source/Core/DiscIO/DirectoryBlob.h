@@ -16,16 +16,11 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
+#include "Common/IOFile.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/Volume.h"
 #include "DiscIO/WiiEncryptionCache.h"
 
-namespace File
-{
-struct FSTEntry;
-class IOFile;
-}  // namespace File
-
 namespace DiscIO
 {
 enum class PartitionType : u32;
@@ -312,6 +307,10 @@ private:
 
   DiscIO::VolumeDisc* GetWrappedVolume() { return m_wrapped_volume.get(); }
 
+  // Returns an open handle for reading the given file. A few handles are kept open between reads,
+  // since patched discs and extracted discs do many small reads from the same files.
+  File::IOFile* GetOpenFile(const std::string& path);
+
   // For GameCube:
   DirectoryBlobPartition m_gamecube_pseudopartition;
 
@@ -325,6 +324,16 @@ private:
 
   u64 m_data_size;
 
+  struct OpenFile
+  {
+    std::string path;
+    File::IOFile file;
+    u64 last_used = 0;
+  };
+  static constexpr size_t MAX_OPEN_FILES = 16;
+  std::vector<OpenFile> m_open_files;
+  u64 m_open_files_counter = 0;
+
   std::unique_ptr<DiscIO::VolumeDisc> m_wrapped_volume;
 };
 
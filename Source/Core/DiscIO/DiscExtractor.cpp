@@ -5,16 +5,24 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <cstddef>
 #include <cstring>
 #include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/Enums.h"
 #include "DiscIO/Filesystem.h"
@@ -51,8 +59,14 @@ u64 ReadFile(const Volume& volume, const Partition& partition, std::string_view
                   offset_in_file);
 }
 
-bool ExportData(const Volume& volume, const Partition& partition, u64 offset, u64 size,
-                const std::string& export_filename)
+// Limit read size to 128 MB
+constexpr u64 MAX_EXPORT_READ_SIZE = 0x08000000;
+
+// Used when several files are exported at once, to keep the total memory usage reasonable
+constexpr u64 PARALLEL_EXPORT_READ_SIZE = 0x00800000;
+
+static bool ExportData(const Volume& volume, const Partition& partition, u64 offset, u64 size,
+                       const std::string& export_filename, std::vector<u8>* buffer)
 {
   File::IOFile f(export_filename, "wb");
   if (!f)
@@ -60,15 +74,12 @@ bool ExportData(const Volume& volume, const Partition& partition, u64 offset, u6
 
   while (size)
   {
-    // Limit read size to 128 MB
-    const size_t read_size = static_cast<size_t>(std::min<u64>(size, 0x08000000));
-
-    std::vector<u8> buffer(read_size);
+    const size_t read_size = static_cast<size_t>(std::min<u64>(size, buffer->size()));
 
-    if (!volume.Read(offset, read_size, buffer.data(), partition))
+    if (!volume.Read(offset, read_size, buffer->data(), partition))
       return false;
 
-    if (!f.WriteBytes(buffer.data(), read_size))
+    if (!f.WriteBytes(buffer->data(), read_size))
       return false;
 
     size -= read_size;
@@ -78,6 +89,13 @@ bool ExportData(const Volume& volume, const Partition& partition, u64 offset, u6
   return true;
 }
 
+bool ExportData(const Volume& volume, const Partition& partition, u64 offset, u64 size,
+                const std::string& export_filename)
+{
+  std::vector<u8> buffer(static_cast<size_t>(std::min(size, MAX_EXPORT_READ_SIZE)));
+  return ExportData(volume, partition, offset, size, export_filename, &buffer);
+}
+
 bool ExportFile(const Volume& volume, const Partition& partition, const FileInfo* file_info,
                 const std::string& export_filename)
 {
@@ -98,10 +116,24 @@ bool ExportFile(const Volume& volume, const Partition& partition, std::string_vi
   return ExportFile(volume, partition, file_system->FindFileInfo(path).get(), export_filename);
 }
 
-void ExportDirectory(const Volume& volume, const Partition& partition, const FileInfo& directory,
-                     bool recursive, const std::string& filesystem_path,
+namespace
+{
+struct FileToExport
+{
+  u64 offset;
+  u64 size;
+  std::string path;
+  std::string export_path;
+};
+}  // namespace
+
+// Creates the directories and collects the files that need to be exported.
+// Returns false if update_progress cancelled the extraction.
+static bool
+CollectFilesToExport(const FileInfo& directory, bool recursive, const std::string& filesystem_path,
                      const std::string& export_folder,
-                     const std::function<bool(const std::string& path)>& update_progress)
+                     const std::function<bool(const std::string& path)>& update_progress,
+                     std::vector<FileToExport>* files)
 {
   std::string export_root = export_folder + '/';
   if (directory.IsDirectory() && !directory.IsRoot())
@@ -115,24 +147,128 @@ void ExportDirectory(const Volume& volume, const Partition& partition, const Fil
     const std::string path = filesystem_path + name;
     const std::string export_path = export_root + name;
 
-    if (update_progress(path))
-      return;
-
     DEBUG_LOG_FMT(DISCIO, "{}", export_path);
 
     if (!file_info.IsDirectory())
     {
       if (File::Exists(export_path))
+      {
+        if (update_progress(path))
+          return false;
         NOTICE_LOG_FMT(DISCIO, "{} already exists", export_path);
-      else if (!ExportFile(volume, partition, &file_info, export_path))
-        ERROR_LOG_FMT(DISCIO, "Could not export {}", export_path);
+      }
+      else
+      {
+        files->push_back({file_info.GetOffset(), file_info.GetSize(), path, export_path});
+      }
+    }
+    else
+    {
+      if (update_progress(path))
+        return false;
+
+      if (recursive &&
+          !CollectFilesToExport(file_info, recursive, filesystem_path, export_root,
+                                update_progress, files))
+      {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+void ExportDirectory(const Volume& volume, const Partition& partition, const FileInfo& directory,
+                     bool recursive, const std::string& filesystem_path,
+                     const std::string& export_folder,
+                     const std::function<bool(const std::string& path)>& update_progress,
+                     unsigned int num_threads)
+{
+  std::vector<FileToExport> files;
+  if (!CollectFilesToExport(directory, recursive, filesystem_path, export_folder, update_progress,
+                            &files))
+  {
+    return;
+  }
+
+  if (files.empty())
+    return;
+
+  // Reading the files in disc order lets the threads share decompressed and decrypted data
+  // through the caches of the blob readers, and keeps the reads close to sequential
+  std::ranges::sort(files, {}, &FileToExport::offset);
+
+  if (num_threads == 0)
+    num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  num_threads = static_cast<unsigned int>(std::min<size_t>(num_threads, files.size()));
+
+  std::atomic<size_t> next_file = 0;
+  std::atomic_bool cancelled = false;
+
+  std::mutex finished_mutex;
+  std::condition_variable finished_changed;
+  std::vector<const FileToExport*> finished;
+  unsigned int threads_running = num_threads;
+
+  const auto worker = [&](const Volume* thread_volume) {
+    std::vector<u8> buffer(PARALLEL_EXPORT_READ_SIZE);
+    for (size_t i = next_file++; i < files.size() && !cancelled; i = next_file++)
+    {
+      const FileToExport& file = files[i];
+      if (!ExportData(*thread_volume, partition, file.offset, file.size, file.export_path,
+                      &buffer))
+      {
+        ERROR_LOG_FMT(DISCIO, "Could not export {}", file.export_path);
+      }
+
+      std::lock_guard lk(finished_mutex);
+      finished.push_back(&file);
+      finished_changed.notify_one();
     }
-    else if (recursive)
+
+    std::lock_guard lk(finished_mutex);
+    --threads_running;
+    finished_changed.notify_one();
+  };
+
+  // The calling thread only reports progress, so the first worker can use the original volume
+  std::vector<std::unique_ptr<Volume>> volume_copies;
+  std::vector<std::future<void>> threads;
+  threads.push_back(std::async(std::launch::async, worker, &volume));
+  for (unsigned int i = 1; i < num_threads; ++i)
+  {
+    std::unique_ptr<Volume> copy = CreateVolume(volume.GetBlobReader().CopyReader());
+    if (!copy)
+    {
+      std::lock_guard lk(finished_mutex);
+      threads_running -= num_threads - i;
+      break;
+    }
+    threads.push_back(std::async(std::launch::async, worker, copy.get()));
+    volume_copies.push_back(std::move(copy));
+  }
+
+  std::vector<const FileToExport*> finished_now;
+  while (true)
+  {
+    {
+      std::unique_lock lk(finished_mutex);
+      finished_changed.wait(lk, [&] { return !finished.empty() || threads_running == 0; });
+      if (finished.empty())
+        break;
+      std::swap(finished, finished_now);
+    }
+
+    for (const FileToExport* file : finished_now)
     {
-      ExportDirectory(volume, partition, file_info, recursive, filesystem_path, export_root,
-                      update_progress);
+      if (!cancelled && update_progress(file->path))
+        cancelled = true;
     }
+    finished_now.clear();
   }
+
+  threads.clear();
 }
 
 bool ExportWiiUnencryptedHeader(const Volume& volume, const std::string& export_filename)
@@ -27,13 +27,17 @@ bool ExportFile(const Volume& volume, const Partition& partition, const FileInfo
 bool ExportFile(const Volume& volume, const Partition& partition, std::string_view path,
                 const std::string& export_filename);
 
-// update_progress is called once for each child (file or directory).
+// update_progress is called once for each child (file or directory), on the calling thread.
+// For files, it's called once the file has been exported.
 // If update_progress returns true, the extraction gets cancelled.
 // filesystem_path is supposed to be the path corresponding to the directory argument.
+// Files are exported on num_threads threads, each with its own copy of the volume's blob reader.
+// If num_threads is 0, one thread per CPU thread is used.
 void ExportDirectory(const Volume& volume, const Partition& partition, const FileInfo& directory,
                      bool recursive, const std::string& filesystem_path,
                      const std::string& export_folder,
-                     const std::function<bool(const std::string& path)>& update_progress);
+                     const std::function<bool(const std::string& path)>& update_progress,
+                     unsigned int num_threads = 0);
 
 // To export everything listed below, you can use ExportSystemData
 
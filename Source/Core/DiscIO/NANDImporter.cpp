@@ -4,7 +4,13 @@
 #include "DiscIO/NANDImporter.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstring>
+#include <future>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "Common/Crypto/AES.h"
 #include "Common/FileUtil.h"
@@ -35,7 +41,11 @@ void NANDImporter::ImportNANDBin(const std::string& path_to_bin,
     return;
 
   ExportKeys();
-  ProcessEntry(0, "");
+
+  std::vector<std::pair<NANDFSTEntry, std::string>> files;
+  ProcessEntry(0, "", &files);
+  ExportFiles(files);
+
   ExtractCertificates();
 }
 
@@ -58,17 +68,24 @@ bool NANDImporter::ReadNANDBin(const std::string& path_to_bin,
 
   m_nand.resize(NAND_SIZE);
 
-  for (size_t i = 0; i < NAND_TOTAL_BLOCKS; i++)
+  // Reading one 2 KiB block at a time means hundreds of thousands of small reads and seeks,
+  // so read many blocks at once and drop the ECC data in memory instead
+  constexpr size_t BLOCKS_PER_READ = 0x400;
+  std::vector<u8> read_buffer((NAND_BLOCK_SIZE + NAND_ECC_BLOCK_SIZE) * BLOCKS_PER_READ);
+
+  for (size_t i = 0; i < NAND_TOTAL_BLOCKS; i += BLOCKS_PER_READ)
   {
-    // Instead of updating on every cycle, we only update every 1000 cycles for a balance between
-    // not updating fast enough vs updating too fast
-    if (i % 1000 == 0)
-      m_update_callback();
+    m_update_callback();
 
-    file.ReadBytes(&m_nand[i * NAND_BLOCK_SIZE], NAND_BLOCK_SIZE);
+    const size_t blocks = std::min(BLOCKS_PER_READ, NAND_TOTAL_BLOCKS - i);
+    file.ReadBytes(read_buffer.data(), (NAND_BLOCK_SIZE + NAND_ECC_BLOCK_SIZE) * blocks);
 
     // We don't care about the ECC blocks
-    file.Seek(NAND_ECC_BLOCK_SIZE, File::SeekOrigin::Current);
+    for (size_t j = 0; j < blocks; ++j)
+    {
+      std::memcpy(&m_nand[(i + j) * NAND_BLOCK_SIZE],
+                  &read_buffer[j * (NAND_BLOCK_SIZE + NAND_ECC_BLOCK_SIZE)], NAND_BLOCK_SIZE);
+    }
   }
 
   m_nand_keys.resize(NAND_KEYS_SIZE);
@@ -131,7 +148,8 @@ std::string NANDImporter::GetPath(const NANDFSTEntry& entry, const std::string&
   return parent_path + '/' + name;
 }
 
-void NANDImporter::ProcessEntry(u16 entry_number, const std::string& parent_path)
+void NANDImporter::ProcessEntry(u16 entry_number, const std::string& parent_path,
+                                std::vector<std::pair<NANDFSTEntry, std::string>>* files)
 {
   while (entry_number != 0xffff)
   {
@@ -150,14 +168,12 @@ void NANDImporter::ProcessEntry(u16 entry_number, const std::string& parent_path
     Type type = static_cast<Type>(entry.mode & 3);
     if (type == Type::File)
     {
-      std::vector<u8> data = GetEntryData(entry);
-      File::IOFile file(m_nand_root + path, "wb");
-      file.WriteBytes(data.data(), data.size());
+      files->emplace_back(entry, path);
     }
     else if (type == Type::Directory)
     {
       File::CreateDir(m_nand_root + path);
-      ProcessEntry(entry.sub, path);
+      ProcessEntry(entry.sub, path, files);
     }
     else
     {
@@ -168,7 +184,35 @@ void NANDImporter::ProcessEntry(u16 entry_number, const std::string& parent_path
   }
 }
 
-std::vector<u8> NANDImporter::GetEntryData(const NANDFSTEntry& entry)
+void NANDImporter::ExportFiles(const std::vector<std::pair<NANDFSTEntry, std::string>>& files)
+{
+  // Decrypting and writing the files is independent for each file, so it's spread over all CPU
+  // threads. The directories have all been created by ProcessEntry at this point.
+  std::atomic<size_t> next_file = 0;
+  const auto worker = [&] {
+    for (size_t i = next_file++; i < files.size(); i = next_file++)
+    {
+      const auto& [entry, path] = files[i];
+      const std::vector<u8> data = GetEntryData(entry);
+      File::IOFile file(m_nand_root + path, "wb");
+      if (!file.WriteBytes(data.data(), data.size()))
+        ERROR_LOG_FMT(DISCIO, "Unable to write to file {}", m_nand_root + path);
+    }
+  };
+
+  const unsigned int num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  std::vector<std::future<void>> threads;
+  for (unsigned int i = 0; i < num_threads; ++i)
+    threads.push_back(std::async(std::launch::async, worker));
+
+  for (std::future<void>& thread : threads)
+  {
+    while (thread.wait_for(std::chrono::milliseconds(100)) != std::future_status::ready)
+      m_update_callback();
+  }
+}
+
+std::vector<u8> NANDImporter::GetEntryData(const NANDFSTEntry& entry) const
 {
   constexpr size_t NAND_FAT_BLOCK_SIZE = 0x4000;
 
@@ -7,6 +7,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -68,8 +69,11 @@ private:
   bool FindSuperblock();
   std::string GetPath(const NANDFSTEntry& entry, const std::string& parent_path);
   std::string FormatDebugString(const NANDFSTEntry& entry);
-  void ProcessEntry(u16 entry_number, const std::string& parent_path);
-  std::vector<u8> GetEntryData(const NANDFSTEntry& entry);
+  void ProcessEntry(u16 entry_number, const std::string& parent_path,
+                    std::vector<std::pair<NANDFSTEntry, std::string>>* files);
+  void ExportFiles(const std::vector<std::pair<NANDFSTEntry, std::string>>& files);
+  // Thread-safe
+  std::vector<u8> GetEntryData(const NANDFSTEntry& entry) const;
   void ExportKeys();
 
   std::string m_nand_root;
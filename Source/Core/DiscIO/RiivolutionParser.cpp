@@ -4,6 +4,9 @@
 #include "DiscIO/RiivolutionParser.h"
 
 #include <algorithm>
+#include <filesystem>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -23,18 +26,53 @@ namespace DiscIO::Riivolution
 {
 Patch::~Patch() = default;
 
+namespace
+{
+// The same XML files get parsed when the Riivolution boot dialog is opened and again when booting,
+// and big patch sets can take a noticeable amount of time to parse
+struct ParsedFile
+{
+  u64 size;
+  std::filesystem::file_time_type modification_time;
+  std::optional<Disc> disc;
+};
+
+std::mutex s_parsed_files_mutex;
+std::map<std::string, ParsedFile> s_parsed_files;
+}  // namespace
+
 std::optional<Disc> ParseFile(const std::string& filename)
 {
   ::File::IOFile f(filename, "rb");
   if (!f)
     return std::nullopt;
 
+  const u64 size = f.GetSize();
+  std::error_code error;
+  const auto modification_time = std::filesystem::last_write_time(StringToPath(filename), error);
+  if (!error)
+  {
+    std::lock_guard lk(s_parsed_files_mutex);
+    const auto it = s_parsed_files.find(filename);
+    if (it != s_parsed_files.end() && it->second.size == size &&
+        it->second.modification_time == modification_time)
+    {
+      return it->second.disc;
+    }
+  }
+
   std::vector<char> data;
-  data.resize(f.GetSize());
+  data.resize(size);
   if (!f.ReadBytes(data.data(), data.size()))
     return std::nullopt;
 
-  return ParseString(std::string_view(data.data(), data.size()), filename);
+  std::optional<Disc> disc = ParseString(std::string_view(data.data(), data.size()), filename);
+  if (!error)
+  {
+    std::lock_guard lk(s_parsed_files_mutex);
+    s_parsed_files.insert_or_assign(filename, ParsedFile{size, modification_time, disc});
+  }
+  return disc;
 }
 
 static std::map<std::string, std::string> ReadParams(const pugi::xml_node& node,
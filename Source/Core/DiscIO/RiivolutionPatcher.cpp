@@ -58,6 +58,26 @@ FileDataLoaderHostFS::FileDataLoaderHostFS(std::string sd_root, const std::strin
 
 std::optional<std::string>
 FileDataLoaderHostFS::MakeAbsoluteFromRelative(std::string_view external_relative_path)
+{
+  const auto it = m_resolved_paths.find(external_relative_path);
+  if (it != m_resolved_paths.end())
+    return it->second;
+
+  std::optional<std::string> result = ResolveAbsoluteFromRelative(external_relative_path);
+  m_resolved_paths.emplace(std::string(external_relative_path), result);
+  return result;
+}
+
+const ::File::FSTEntry& FileDataLoaderHostFS::GetDirectoryListing(const std::string& path)
+{
+  auto it = m_directory_listings.find(path);
+  if (it == m_directory_listings.end())
+    it = m_directory_listings.emplace(path, ::File::ScanDirectoryTree(path, false)).first;
+  return it->second;
+}
+
+std::optional<std::string>
+FileDataLoaderHostFS::ResolveAbsoluteFromRelative(std::string_view external_relative_path)
 {
 #ifdef _WIN32
   // Riivolution treats a backslash as just a standard filename character, but we can't replicate
@@ -130,7 +150,7 @@ FileDataLoaderHostFS::MakeAbsoluteFromRelative(std::string_view external_relativ
         result.erase(result.size() - element.size(), element.size());
 
         // Re-attach an element that actually matches the capitalization in the host filesystem.
-        auto possible_files = ::File::ScanDirectoryTree(result, false);
+        const ::File::FSTEntry& possible_files = GetDirectoryListing(result);
         bool found = false;
         for (auto& f : possible_files.children)
         {
@@ -196,11 +216,11 @@ FileDataLoaderHostFS::GetFolderContents(std::string_view external_relative_path)
   auto path = MakeAbsoluteFromRelative(external_relative_path);
   if (!path)
     return {};
-  ::File::FSTEntry external_files = ::File::ScanDirectoryTree(*path, false);
+  const ::File::FSTEntry& external_files = GetDirectoryListing(*path);
   std::vector<FileDataLoader::Node> nodes;
   nodes.reserve(external_files.children.size());
-  for (auto& file : external_files.children)
-    nodes.emplace_back(FileDataLoader::Node{std::move(file.virtualName), file.isDirectory});
+  for (const auto& file : external_files.children)
+    nodes.emplace_back(FileDataLoader::Node{file.virtualName, file.isDirectory});
   return nodes;
 }
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <map>
 #include <optional>
 #include <span>
 #include <string>
@@ -66,9 +67,17 @@ public:
 
 private:
   std::optional<std::string> MakeAbsoluteFromRelative(std::string_view external_relative_path);
+  std::optional<std::string>
+  ResolveAbsoluteFromRelative(std::string_view external_relative_path);
+  const ::File::FSTEntry& GetDirectoryListing(const std::string& path);
 
   std::string m_sd_root;
   std::string m_patch_root;
+
+  // Every patched file is resolved several times while the FST is built, and resolving a path
+  // can require listing its parent directory, so both are remembered.
+  std::map<std::string, std::optional<std::string>, std::less<>> m_resolved_paths;
+  std::map<std::string, ::File::FSTEntry> m_directory_listings;
 };
 
 enum class PatchIndex
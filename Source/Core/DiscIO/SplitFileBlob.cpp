@@ -3,6 +3,7 @@
 
 #include "DiscIO/SplitFileBlob.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -23,6 +24,9 @@ SplitPlainFileReader::SplitPlainFileReader(std::vector<SingleFile> files)
   m_size = 0;
   for (const auto& f : m_files)
     m_size += f.size;
+
+  SetSectorSize(SECTOR_SIZE);
+  SetChunkSize(CHUNK_BLOCKS);
 }
 
 std::unique_ptr<SplitPlainFileReader> SplitPlainFileReader::Create(std::string_view first_file_path)
@@ -67,7 +71,28 @@ std::unique_ptr<BlobReader> SplitPlainFileReader::CopyReader() const
   return std::unique_ptr<SplitPlainFileReader>(new SplitPlainFileReader(std::move(new_files)));
 }
 
-bool SplitPlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
+bool SplitPlainFileReader::GetBlock(u64 block_num, u8* out_ptr)
+{
+  return ReadMultipleAlignedBlocks(block_num, 1, out_ptr);
+}
+
+bool SplitPlainFileReader::ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr)
+{
+  const u64 offset = block_num * SECTOR_SIZE;
+  if (offset >= m_size)
+    return false;
+
+  // The last block may extend past the end of the last file
+  const u64 size = num_blocks * SECTOR_SIZE;
+  const u64 size_in_files = std::min(size, m_size - offset);
+  if (!ReadFromFiles(offset, size_in_files, out_ptr))
+    return false;
+
+  std::fill(out_ptr + size_in_files, out_ptr + size, 0);
+  return true;
+}
+
+bool SplitPlainFileReader::ReadFromFiles(u64 offset, u64 nbytes, u8* out_ptr)
 {
   if (offset >= m_size)
     return false;
@@ -15,7 +15,9 @@
 
 namespace DiscIO
 {
-class SplitPlainFileReader final : public BlobReader
+// Small reads are served from SectorReader's cache, which is filled in units of a few
+// Wii sectors, so that reading a disc stored on slow media doesn't turn into many tiny reads.
+class SplitPlainFileReader final : public SectorReader
 {
 public:
   static std::unique_ptr<SplitPlainFileReader> Create(std::string_view first_file_path);
@@ -32,9 +34,14 @@ public:
   std::string GetCompressionMethod() const override { return {}; }
   std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
 
-  bool Read(u64 offset, u64 nbytes, u8* out_ptr) override;
+protected:
+  bool GetBlock(u64 block_num, u8* out_ptr) override;
+  bool ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr) override;
 
 private:
+  static constexpr int SECTOR_SIZE = 0x8000;
+  static constexpr int CHUNK_BLOCKS = 4;
+
   struct SingleFile
   {
     File::IOFile file;
@@ -44,6 +51,8 @@ private:
 
   SplitPlainFileReader(std::vector<SingleFile> m_files);
 
+  bool ReadFromFiles(u64 offset, u64 nbytes, u8* out_ptr);
+
   std::vector<SingleFile> m_files;
   u64 m_size;
 };
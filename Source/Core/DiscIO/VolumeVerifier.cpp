@@ -4,12 +4,14 @@
 #include "DiscIO/VolumeVerifier.h"
 
 #include <algorithm>
+#include <deque>
 #include <future>
 #include <limits>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_set>
 
 #include <mbedtls/md5.h>
@@ -374,6 +376,8 @@ VolumeVerifier::VolumeVerifier(const Volume& volume, bool redump_verification,
 VolumeVerifier::~VolumeVerifier()
 {
   WaitForAsyncOperations();
+  for (const std::future<GroupResult>& future : m_group_futures)
+    future.wait();
 }
 
 Hashes<bool> VolumeVerifier::GetDefaultHashesToCalculate()
@@ -415,6 +419,8 @@ void VolumeVerifier::Start()
   CheckMisc();
 
   SetUpHashing();
+
+  m_max_groups_in_flight = std::max<size_t>(std::thread::hardware_concurrency(), 1);
 }
 
 std::vector<Partition> VolumeVerifier::CheckPartitions()
@@ -1087,22 +1093,20 @@ void VolumeVerifier::WaitForAsyncOperations() const
     m_sha1_future.wait();
   if (m_content_future.valid())
     m_content_future.wait();
-  if (m_group_future.valid())
-    m_group_future.wait();
 }
 
 bool VolumeVerifier::ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read)
 {
-  std::vector<u8> data(bytes_to_read);
+  auto data = std::make_shared<std::vector<u8>>(bytes_to_read);
 
   const u64 bytes_to_copy = std::min(m_excess_bytes, bytes_to_read);
   if (bytes_to_copy > 0)
-    std::memcpy(data.data(), m_data.data() + m_data.size() - m_excess_bytes, bytes_to_copy);
+    std::memcpy(data->data(), m_data->data() + m_data->size() - m_excess_bytes, bytes_to_copy);
   bytes_to_read -= bytes_to_copy;
 
   if (bytes_to_read > 0)
   {
-    if (!m_volume.Read(m_progress + bytes_to_copy, bytes_to_read, data.data() + bytes_to_copy,
+    if (!m_volume.Read(m_progress + bytes_to_copy, bytes_to_read, data->data() + bytes_to_copy,
                        PARTITION_NONE))
     {
       return false;
@@ -1203,7 +1207,7 @@ void VolumeVerifier::Process()
     if (m_hashes_to_calculate.crc32)
     {
       m_crc32_future = std::async(std::launch::async, [this, byte_increment] {
-        m_crc32_context = Common::UpdateCRC32(m_crc32_context, m_data.data(),
+        m_crc32_context = Common::UpdateCRC32(m_crc32_context, m_data->data(),
                                               static_cast<size_t>(byte_increment));
       });
     }
@@ -1211,14 +1215,14 @@ void VolumeVerifier::Process()
     if (m_hashes_to_calculate.md5)
     {
       m_md5_future = std::async(std::launch::async, [this, byte_increment] {
-        mbedtls_md5_update_ret(&m_md5_context, m_data.data(), byte_increment);
+        mbedtls_md5_update_ret(&m_md5_context, m_data->data(), byte_increment);
       });
     }
 
     if (m_hashes_to_calculate.sha1)
     {
       m_sha1_future = std::async(std::launch::async, [this, byte_increment] {
-        m_sha1_context->Update(m_data.data(), byte_increment);
+        m_sha1_context->Update(m_data->data(), byte_increment);
       });
     }
   }
@@ -1226,7 +1230,7 @@ void VolumeVerifier::Process()
   if (content_read)
   {
     m_content_future = std::async(std::launch::async, [this, read_failed, content] {
-      if (read_failed || !m_volume.CheckContentIntegrity(content, m_data, m_ticket))
+      if (read_failed || !m_volume.CheckContentIntegrity(content, *m_data, m_ticket))
       {
         AddProblem(Severity::High, Common::FmtFormatT("Content {0:08x} is corrupt.", content.id));
       }
@@ -1237,36 +1241,13 @@ void VolumeVerifier::Process()
 
   if (group_read)
   {
-    m_group_future = std::async(std::launch::async, [this, read_failed,
-                                                     group_index = m_group_index] {
-      const GroupToVerify& group = m_groups[group_index];
-      u64 offset_in_group = 0;
-      for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
-           ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
-      {
-        const u64 block_offset = group.offset + offset_in_group;
+    if (m_group_futures.size() >= m_max_groups_in_flight)
+      CollectOldestGroupResult();
 
-        if (!read_failed && m_volume.CheckBlockIntegrity(
-                                block_index, m_data.data() + offset_in_group, group.partition))
-        {
-          m_biggest_verified_offset =
-              std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
-        }
-        else
-        {
-          if (m_scrubber.CanBlockBeScrubbed(block_offset))
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
-            m_unused_block_errors[group.partition]++;
-          }
-          else
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
-            m_block_errors[group.partition]++;
-          }
-        }
-      }
-    });
+    m_group_futures.push_back(std::async(
+        std::launch::async, [this, read_failed, group_index = m_group_index, data = m_data] {
+          return VerifyGroup(m_groups[group_index], data ? data->data() : nullptr, read_failed);
+        }));
 
     m_group_index++;
   }
@@ -1274,6 +1255,51 @@ void VolumeVerifier::Process()
   m_progress += byte_increment;
 }
 
+VolumeVerifier::GroupResult VolumeVerifier::VerifyGroup(const GroupToVerify& group, const u8* data,
+                                                        bool read_failed) const
+{
+  GroupResult result{group.partition};
+
+  u64 offset_in_group = 0;
+  for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
+       ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
+  {
+    const u64 block_offset = group.offset + offset_in_group;
+
+    if (!read_failed &&
+        m_volume.CheckBlockIntegrity(block_index, data + offset_in_group, group.partition))
+    {
+      result.biggest_verified_offset =
+          std::max(result.biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
+    }
+    else
+    {
+      if (m_scrubber.CanBlockBeScrubbed(block_offset))
+      {
+        WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
+        result.unused_block_errors++;
+      }
+      else
+      {
+        WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
+        result.block_errors++;
+      }
+    }
+  }
+
+  return result;
+}
+
+void VolumeVerifier::CollectOldestGroupResult()
+{
+  const GroupResult result = m_group_futures.front().get();
+  m_group_futures.pop_front();
+
+  m_biggest_verified_offset = std::max(m_biggest_verified_offset, result.biggest_verified_offset);
+  m_block_errors[result.partition] += result.block_errors;
+  m_unused_block_errors[result.partition] += result.unused_block_errors;
+}
+
 u64 VolumeVerifier::GetBytesProcessed() const
 {
   return m_progress;
@@ -1291,6 +1317,8 @@ void VolumeVerifier::Finish()
   m_done = true;
 
   WaitForAsyncOperations();
+  while (!m_group_futures.empty())
+    CollectOldestGroupResult();
 
   if (m_calculating_any_hash)
   {
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <deque>
 #include <future>
 #include <map>
 #include <memory>
@@ -144,6 +145,14 @@ private:
     size_t block_index_end;
   };
 
+  struct GroupResult
+  {
+    Partition partition;
+    u64 biggest_verified_offset = 0;
+    size_t block_errors = 0;
+    size_t unused_block_errors = 0;
+  };
+
   std::vector<Partition> CheckPartitions();
   bool CheckPartition(const Partition& partition);  // Returns false if partition should be ignored
   std::string GetPartitionName(std::optional<u32> type) const;
@@ -158,6 +167,8 @@ private:
   void SetUpHashing();
   void WaitForAsyncOperations() const;
   bool ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read);
+  GroupResult VerifyGroup(const GroupToVerify& group, const u8* data, bool read_failed) const;
+  void CollectOldestGroupResult();
 
   void AddProblem(Severity severity, std::string text);
 
@@ -179,12 +190,16 @@ private:
   std::unique_ptr<Common::SHA1::Context> m_sha1_context;
 
   u64 m_excess_bytes = 0;
-  std::vector<u8> m_data;
+  // Shared with the group verification tasks, which may still be using an older chunk
+  std::shared_ptr<const std::vector<u8>> m_data;
   std::future<void> m_crc32_future;
   std::future<void> m_md5_future;
   std::future<void> m_sha1_future;
   std::future<void> m_content_future;
-  std::future<void> m_group_future;
+  // Groups are verified in parallel. Results are collected in order, and the number of groups
+  // in flight is bounded so that we don't keep too many chunks of read data alive.
+  std::deque<std::future<GroupResult>> m_group_futures;
+  size_t m_max_groups_in_flight = 1;
 
   DiscScrubber m_scrubber;
   IOS::ES::TicketReader m_ticket;
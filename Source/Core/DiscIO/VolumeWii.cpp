@@ -512,18 +512,27 @@ bool VolumeWii::HashGroup(const std::array<u8, BLOCK_DATA_SIZE> in[BLOCKS_PER_GR
                           HashBlock out[BLOCKS_PER_GROUP],
                           const std::function<bool(size_t block)>& read_function)
 {
-  std::array<std::future<void>, BLOCKS_PER_GROUP> hash_futures;
+  // Each H1 hash covers the H0 hashes of 8 blocks, so each set of 8 blocks is hashed by its own
+  // task. This needs far fewer threads than one task per block while still letting the hashing
+  // of one set run in parallel with the reading of the next.
+  constexpr size_t BLOCKS_PER_SET = 8;
+  constexpr size_t SETS_PER_GROUP = BLOCKS_PER_GROUP / BLOCKS_PER_SET;
+
+  std::array<std::future<void>, SETS_PER_GROUP> hash_futures;
   bool success = true;
 
-  for (size_t i = 0; i < BLOCKS_PER_GROUP; ++i)
+  for (size_t set = 0; set < SETS_PER_GROUP; ++set)
   {
-    if (read_function && success)
+    const size_t h1_base = set * BLOCKS_PER_SET;
+
+    for (size_t i = h1_base; i < h1_base + BLOCKS_PER_SET && read_function && success; ++i)
       success = read_function(i);
 
-    hash_futures[i] = std::async(std::launch::async, [&in, &out, &hash_futures, success, i]() {
-      const size_t h1_base = Common::AlignDown(i, 8);
+    if (!success)
+      break;
 
-      if (success)
+    hash_futures[set] = std::async(std::launch::async, [&in, &out, h1_base]() {
+      for (size_t i = h1_base; i < h1_base + BLOCKS_PER_SET; ++i)
       {
         // H0 hashes
         for (size_t j = 0; j < 31; ++j)
@@ -536,47 +545,36 @@ bool VolumeWii::HashGroup(const std::array<u8, BLOCK_DATA_SIZE> in[BLOCKS_PER_GR
         out[h1_base].h1[i - h1_base] = Common::SHA1::CalculateDigest(out[i].h0);
       }
 
-      if (i % 8 == 7)
-      {
-        for (size_t j = 0; j < 7; ++j)
-          hash_futures[h1_base + j].get();
-
-        if (success)
-        {
-          // H1 padding
-          out[h1_base].padding_1 = {};
-
-          // H1 copies
-          for (size_t j = 1; j < 8; ++j)
-            out[h1_base + j].h1 = out[h1_base].h1;
+      // H1 padding
+      out[h1_base].padding_1 = {};
 
-          // H2 hash
-          out[0].h2[h1_base / 8] = Common::SHA1::CalculateDigest(out[i].h1);
-        }
+      // H1 copies
+      for (size_t j = 1; j < BLOCKS_PER_SET; ++j)
+        out[h1_base + j].h1 = out[h1_base].h1;
 
-        if (i == BLOCKS_PER_GROUP - 1)
-        {
-          for (size_t j = 0; j < 7; ++j)
-            hash_futures[j * 8 + 7].get();
-
-          if (success)
-          {
-            // H2 padding
-            out[0].padding_2 = {};
-
-            // H2 copies
-            for (size_t j = 1; j < BLOCKS_PER_GROUP; ++j)
-              out[j].h2 = out[0].h2;
-          }
-        }
-      }
+      // H2 hash
+      out[0].h2[h1_base / BLOCKS_PER_SET] = Common::SHA1::CalculateDigest(out[h1_base].h1);
     });
   }
 
   // Wait for all the async tasks to finish
-  hash_futures.back().get();
+  for (std::future<void>& future : hash_futures)
+  {
+    if (future.valid())
+      future.get();
+  }
+
+  if (!success)
+    return false;
 
-  return success;
+  // H2 padding
+  out[0].padding_2 = {};
+
+  // H2 copies
+  for (size_t j = 1; j < BLOCKS_PER_GROUP; ++j)
+    out[j].h2 = out[0].h2;
+
+  return true;
 }
 
 bool VolumeWii::EncryptGroup(
@@ -588,20 +586,34 @@ bool VolumeWii::EncryptGroup(
   std::vector<std::array<u8, BLOCK_DATA_SIZE>> unencrypted_data(BLOCKS_PER_GROUP);
   std::vector<HashBlock> unencrypted_hashes(BLOCKS_PER_GROUP);
 
+  // Read eight blocks per call. unencrypted_data is contiguous, and one larger read is cheaper
+  // than several small ones for readers that have to decompress the data.
+  constexpr size_t BLOCKS_PER_READ = 8;
+  const u64 readable_blocks =
+      offset >= partition_data_decrypted_size ?
+          0 :
+          std::min<u64>(BLOCKS_PER_GROUP,
+                        (partition_data_decrypted_size - offset) / BLOCK_DATA_SIZE);
+
   const bool success =
       HashGroup(unencrypted_data.data(), unencrypted_hashes.data(), [&](size_t block) {
-        if (offset + (block + 1) * BLOCK_DATA_SIZE <= partition_data_decrypted_size)
+        if (block % BLOCKS_PER_READ != 0)
+          return true;
+
+        const size_t blocks_to_read =
+            static_cast<size_t>(std::clamp<u64>(readable_blocks, block, block + BLOCKS_PER_READ) -
+                                block);
+        if (blocks_to_read != 0 &&
+            !blob->ReadWiiDecrypted(offset + block * BLOCK_DATA_SIZE,
+                                    blocks_to_read * BLOCK_DATA_SIZE,
+                                    unencrypted_data[block].data(), partition_data_offset))
         {
-          if (!blob->ReadWiiDecrypted(offset + block * BLOCK_DATA_SIZE, BLOCK_DATA_SIZE,
-                                      unencrypted_data[block].data(), partition_data_offset))
-          {
-            return false;
-          }
-        }
-        else
-        {
-          unencrypted_data[block].fill(0);
+          return false;
         }
+
+        for (size_t i = block + blocks_to_read; i < block + BLOCKS_PER_READ; ++i)
+          unencrypted_data[i].fill(0);
+
         return true;
       });
 
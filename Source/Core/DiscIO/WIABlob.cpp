@@ -5,14 +5,18 @@
 
 #include <algorithm>
 #include <array>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <thread>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 #include <zstd.h>
@@ -25,10 +29,12 @@
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/ParallelFor.h"
 #include "Common/ScopeGuard.h"
 #include "Common/Swap.h"
 
 #include "DiscIO/Blob.h"
+#include "DiscIO/ChunkCache.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/Filesystem.h"
 #include "DiscIO/LaggedFibonacciGenerator.h"
@@ -79,7 +85,9 @@ std::pair<int, int> GetAllowedCompressionLevels(WIARVZCompressionType compressio
 
 template <bool RVZ>
 WIARVZFileReader<RVZ>::WIARVZFileReader(File::IOFile file, const std::string& path)
-    : m_file(std::move(file)), m_path(path), m_encryption_cache(this)
+    : m_file(std::move(file)), m_path(path),
+      m_chunk_cache_source_id(ChunkCache::GetInstance().GetSourceID(path)),
+      m_encryption_cache(this)
 {
   m_valid = Initialize(path);
 }
@@ -500,6 +508,7 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   data_offset -= skipped_data;
   data_size += skipped_data;
 
+  const u64 full_chunk_size = chunk_size;
   const u64 start_group_index = (*offset - data_offset) / chunk_size;
   for (u64 i = start_group_index; i < number_of_groups && (*size) > 0; ++i)
   {
@@ -536,24 +545,53 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
     {
       const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
 
-      Chunk& chunk =
-          ReadCompressedData(group_offset_in_file, group_data_size, chunk_size, compression_type,
-                             exception_lists, rvz_packed_size, group_offset_in_data);
+      // Hash exceptions aren't kept in the shared cache, so it can't be used when we need them
+      ChunkCache::Data cached_data;
+      if (!m_write_to_exception_list && group_offset_in_file != m_cached_chunk_offset)
+        cached_data = ChunkCache::GetInstance().Get(m_chunk_cache_source_id, group_offset_in_file);
 
-      if (!chunk.Read(offset_in_group, bytes_to_read, *out_ptr))
+      if (cached_data && cached_data->size() >= offset_in_group + bytes_to_read)
       {
-        m_cached_chunk_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
-        return false;
+        std::memcpy(*out_ptr, cached_data->data() + offset_in_group, bytes_to_read);
       }
-
-      if (m_write_to_exception_list && m_exception_list_last_group_index != total_group_index)
+      else
       {
-        const u64 exception_list_index = offset_in_group / VolumeWii::GROUP_DATA_SIZE;
-        const u16 additional_offset =
-            static_cast<u16>(group_offset_in_data % VolumeWii::GROUP_DATA_SIZE /
-                             VolumeWii::BLOCK_DATA_SIZE * VolumeWii::BLOCK_HEADER_SIZE);
-        chunk.GetHashExceptions(&m_exception_list, exception_list_index, additional_offset);
-        m_exception_list_last_group_index = total_group_index;
+        if (group_offset_in_file != m_cached_chunk_offset &&
+            !m_decompressed_chunks.contains(group_offset_in_file))
+        {
+          DecompressGroupsInParallel(*offset, *size, full_chunk_size, data_offset, data_size,
+                                     group_index, number_of_groups, exception_lists);
+        }
+
+        const bool was_fully_decompressed = group_offset_in_file == m_cached_chunk_offset &&
+                                            m_cached_chunk.IsFullyDecompressed();
+
+        Chunk& chunk =
+            ReadCompressedData(group_offset_in_file, group_data_size, chunk_size,
+                               compression_type, exception_lists, rvz_packed_size,
+                               group_offset_in_data);
+
+        if (!chunk.Read(offset_in_group, bytes_to_read, *out_ptr))
+        {
+          m_cached_chunk_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
+          return false;
+        }
+
+        if (!was_fully_decompressed && chunk.IsFullyDecompressed())
+        {
+          ChunkCache::GetInstance().Insert(m_chunk_cache_source_id, group_offset_in_file,
+                                           chunk.GetDecompressedData());
+        }
+
+        if (m_write_to_exception_list && m_exception_list_last_group_index != total_group_index)
+        {
+          const u64 exception_list_index = offset_in_group / VolumeWii::GROUP_DATA_SIZE;
+          const u16 additional_offset =
+              static_cast<u16>(group_offset_in_data % VolumeWii::GROUP_DATA_SIZE /
+                               VolumeWii::BLOCK_DATA_SIZE * VolumeWii::BLOCK_HEADER_SIZE);
+          chunk.GetHashExceptions(&m_exception_list, exception_list_index, additional_offset);
+          m_exception_list_last_group_index = total_group_index;
+        }
       }
     }
 
@@ -575,6 +613,28 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
   if (offset_in_file == m_cached_chunk_offset)
     return m_cached_chunk;
 
+  const auto it = m_decompressed_chunks.find(offset_in_file);
+  if (it != m_decompressed_chunks.end())
+  {
+    m_cached_chunk = std::move(it->second);
+    m_decompressed_chunks.erase(it);
+  }
+  else
+  {
+    m_cached_chunk = CreateChunk(&m_file, offset_in_file, compressed_size, decompressed_size,
+                                 compression_type, exception_lists, rvz_packed_size, data_offset);
+  }
+
+  m_cached_chunk_offset = offset_in_file;
+  return m_cached_chunk;
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk
+WIARVZFileReader<RVZ>::CreateChunk(File::IOFile* file, u64 offset_in_file, u64 compressed_size,
+                                   u64 decompressed_size, WIARVZCompressionType compression_type,
+                                   u32 exception_lists, u32 rvz_packed_size, u64 data_offset) const
+{
   std::unique_ptr<Decompressor> decompressor;
   switch (compression_type)
   {
@@ -603,11 +663,117 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
 
   const bool compressed_exception_lists = compression_type > WIARVZCompressionType::Purge;
 
-  m_cached_chunk =
-      Chunk(&m_file, offset_in_file, compressed_size, decompressed_size, exception_lists,
-            compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
-  m_cached_chunk_offset = offset_in_file;
-  return m_cached_chunk;
+  return Chunk(file, offset_in_file, compressed_size, decompressed_size, exception_lists,
+               compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::DecompressGroupsInParallel(u64 offset, u64 size, u64 chunk_size,
+                                                       u64 data_offset, u64 data_size,
+                                                       u32 group_index, u32 number_of_groups,
+                                                       u32 exception_lists)
+{
+  // Mirrors the group iteration in ReadFromGroups, but only collects the groups which use
+  // a real compression method. (Decompressing None and Purge is about as fast as copying.)
+  struct Job
+  {
+    u64 offset_in_file;
+    u64 compressed_size;
+    u64 decompressed_size;
+    WIARVZCompressionType compression_type;
+    u32 rvz_packed_size;
+    u64 group_offset_in_data;
+    u64 end_offset_in_group;
+
+    Chunk chunk{};
+    bool success = false;
+  };
+  std::vector<Job> jobs;
+
+  // Normally every chunk in here gets used by the ReadFromGroups call that created it, but
+  // a failed read can leave some behind.
+  if (m_decompressed_chunks.size() >= MAX_PARALLEL_GROUPS * 2)
+    m_decompressed_chunks.clear();
+
+  const u64 start_group_index = (offset - data_offset) / chunk_size;
+  for (u64 i = start_group_index;
+       i < number_of_groups && size > 0 && jobs.size() < MAX_PARALLEL_GROUPS; ++i)
+  {
+    const u64 total_group_index = group_index + i;
+    if (total_group_index >= m_group_entries.size())
+      break;
+
+    const GroupEntry group = m_group_entries[total_group_index];
+    const u64 group_offset_in_data = i * chunk_size;
+    const u64 offset_in_group = offset - group_offset_in_data - data_offset;
+    const u64 this_chunk_size = std::min(chunk_size, data_size - group_offset_in_data);
+    const u64 bytes_to_read = std::min(this_chunk_size - offset_in_group, size);
+    offset += bytes_to_read;
+    size -= bytes_to_read;
+
+    u32 group_data_size = Common::swap32(group.data_size);
+    WIARVZCompressionType compression_type = m_compression_type;
+    u32 rvz_packed_size = 0;
+    if constexpr (RVZ)
+    {
+      if ((group_data_size & 0x80000000) == 0)
+        compression_type = WIARVZCompressionType::None;
+
+      group_data_size &= 0x7FFFFFFF;
+
+      rvz_packed_size = Common::swap32(group.rvz_packed_size);
+    }
+
+    const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
+    if (group_data_size == 0 || compression_type <= WIARVZCompressionType::Purge ||
+        group_offset_in_file == m_cached_chunk_offset ||
+        m_decompressed_chunks.contains(group_offset_in_file) ||
+        (!m_write_to_exception_list &&
+         ChunkCache::GetInstance().Contains(m_chunk_cache_source_id, group_offset_in_file)))
+    {
+      continue;
+    }
+
+    jobs.push_back(Job{group_offset_in_file, group_data_size, this_chunk_size, compression_type,
+                       rvz_packed_size, group_offset_in_data, offset_in_group + bytes_to_read});
+  }
+
+  // Not worth spinning up threads for. ReadCompressedData will handle it.
+  if (jobs.size() < 2)
+    return;
+
+  if (m_parallel_files.empty())
+  {
+    for (size_t i = 0; i < MAX_PARALLEL_GROUPS; ++i)
+    {
+      auto file = std::make_unique<File::IOFile>(m_file.Duplicate("rb"));
+      if (!file->IsOpen())
+      {
+        m_parallel_files.clear();
+        return;
+      }
+      m_parallel_files.push_back(std::move(file));
+    }
+  }
+
+  for (size_t i = 0; i < jobs.size(); ++i)
+  {
+    Job& job = jobs[i];
+    job.chunk = CreateChunk(m_parallel_files[i].get(), job.offset_in_file, job.compressed_size,
+                            job.decompressed_size, job.compression_type, exception_lists,
+                            job.rvz_packed_size, job.group_offset_in_data);
+  }
+
+  Common::ParallelFor(jobs.size(), [&jobs](size_t i) {
+    jobs[i].success = jobs[i].chunk.DecompressUntil(jobs[i].end_offset_in_group);
+  });
+
+  for (Job& job : jobs)
+  {
+    // On failure, leave it to ReadFromGroups to retry and report the error
+    if (job.success)
+      m_decompressed_chunks.emplace(job.offset_in_file, std::move(job.chunk));
+  }
 }
 
 template <bool RVZ>
@@ -650,17 +816,27 @@ WIARVZFileReader<RVZ>::Chunk::Chunk(File::IOFile* file, u64 offset_in_file, u64
 
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
+{
+  if (!DecompressUntil(offset + size))
+    return false;
+
+  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
+  return true;
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressUntil(u64 end_offset)
 {
   if (!m_decompressor || !m_file ||
-      offset + size > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
+      end_offset > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
   {
     return false;
   }
 
-  while (offset + size > GetOutBytesWrittenExcludingExceptions())
+  while (end_offset > GetOutBytesWrittenExcludingExceptions())
   {
     u64 bytes_to_read;
-    if (offset + size == m_out.data.size())
+    if (end_offset == m_out.data.size())
     {
       // Read all the remaining data.
       bytes_to_read = m_in.data.size() - m_in.bytes_written;
@@ -673,7 +849,7 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
 
       // The compressed data is probably not much bigger than the decompressed data.
       // Add a few bytes for possible compression overhead and for any hash exceptions.
-      bytes_to_read = offset + size - GetOutBytesWrittenExcludingExceptions() + 0x100;
+      bytes_to_read = end_offset - GetOutBytesWrittenExcludingExceptions() + 0x100;
 
       // Align the access in an attempt to gain speed. But we don't actually know the
       // block size of the underlying storage device, so we just use the Wii block size.
@@ -753,10 +929,24 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
     }
   }
 
-  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
   return true;
 }
 
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::IsFullyDecompressed() const
+{
+  return m_decompressor &&
+         GetOutBytesWrittenExcludingExceptions() ==
+             m_out.data.size() - m_out_bytes_allocated_for_exceptions;
+}
+
+template <bool RVZ>
+std::vector<u8> WIARVZFileReader<RVZ>::Chunk::GetDecompressedData() const
+{
+  const auto begin = m_out.data.begin() + m_out_bytes_used_for_exceptions;
+  return std::vector<u8>(begin, begin + (m_out.data.size() - m_out_bytes_allocated_for_exceptions));
+}
+
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Chunk::Decompress()
 {
@@ -1104,6 +1294,53 @@ void WIARVZFileReader<RVZ>::SetUpCompressor(std::unique_ptr<Compressor>* compres
   }
 }
 
+// How many groups of input data can be read before they're handed to a compression thread
+static constexpr size_t READ_AHEAD_GROUPS = 2;
+
+template <bool RVZ>
+unsigned int WIARVZFileReader<RVZ>::GetCompressThreadCount(WIARVZCompressionType compression_type,
+                                                           int compression_level, int chunk_size,
+                                                           u64 memory_limit)
+{
+  const unsigned int max_threads = std::max(1u, std::thread::hardware_concurrency());
+  if (memory_limit == 0)
+    return max_threads;
+
+  // Measure how much memory a compressor needs by letting one compress a chunk
+  u64 compressor_memory = 0;
+  std::unique_ptr<Compressor> compressor;
+  SetUpCompressor(&compressor, compression_type, compression_level, nullptr);
+  if (compressor)
+  {
+    const std::vector<u8> data(chunk_size);
+    if (compressor->Start(data.size()) && compressor->Compress(data.data(), data.size()) &&
+        compressor->End())
+    {
+      compressor_memory = compressor->GetMemoryUsage();
+    }
+  }
+
+  // Data is handed to the compression threads in units of at least one Wii group
+  const u64 group_size = std::max<u64>(chunk_size, VolumeWii::GROUP_TOTAL_SIZE);
+
+  // Each compression thread can hold three groups at a time (one waiting to be compressed, one
+  // being compressed and one waiting to be written), plus its buffers for decrypted data
+  const u64 memory_per_thread = compressor_memory + group_size * 3 + VolumeWii::GROUP_TOTAL_SIZE;
+
+  // The groups that have been read ahead don't depend on the number of threads
+  const u64 read_ahead_memory = group_size * (READ_AHEAD_GROUPS + 1);
+  const u64 available_memory =
+      memory_limit > read_ahead_memory ? memory_limit - read_ahead_memory : 0;
+
+  const unsigned int threads = static_cast<unsigned int>(
+      std::clamp<u64>(available_memory / memory_per_thread, 1, max_threads));
+
+  INFO_LOG_FMT(DISCIO, "Using {} compression threads ({} MiB each) for a memory limit of {} MiB",
+               threads, memory_per_thread / 0x100000, memory_limit / 0x100000);
+
+  return threads;
+}
+
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::TryReuse(std::map<ReuseID, GroupEntry>* reusable_groups,
                                      std::mutex* reusable_groups_mutex,
@@ -1298,7 +1535,8 @@ static void RVZPack(const u8* in, OutputParametersEntry* out, u64 size, u64 data
 
 template <bool RVZ>
 ConversionResult<typename WIARVZFileReader<RVZ>::OutputParameters>
-WIARVZFileReader<RVZ>::ProcessAndCompress(CompressThreadState* state, CompressParameters parameters,
+WIARVZFileReader<RVZ>::ProcessAndCompress(CompressThreadState* state,
+                                          CompressParameters* parameters,
                                           const std::vector<PartitionEntry>& partition_entries,
                                           const std::vector<DataEntry>& data_entries,
                                           const FileSystem* file_system,
@@ -1309,17 +1547,17 @@ WIARVZFileReader<RVZ>::ProcessAndCompress(CompressThreadState* state, CompressPa
 {
   std::vector<OutputParametersEntry> output_entries;
 
-  if (!parameters.data_entry->is_partition)
+  if (!parameters->data_entry->is_partition)
   {
     OutputParametersEntry& entry = output_entries.emplace_back();
-    std::vector<u8>& data = parameters.data;
+    std::vector<u8>& data = parameters->data;
 
     if (AllSame(data))
       entry.reuse_id = ReuseID{WiiKey{}, data.size(), false, data.front()};
 
     if constexpr (RVZ)
     {
-      RVZPack(data.data(), output_entries.data(), data.size(), parameters.data_offset, true,
+      RVZPack(data.data(), output_entries.data(), data.size(), parameters->data_offset, true,
               compression, file_system);
     }
     else
@@ -1329,15 +1567,20 @@ WIARVZFileReader<RVZ>::ProcessAndCompress(CompressThreadState* state, CompressPa
   }
   else
   {
-    const PartitionEntry& partition_entry = partition_entries[parameters.data_entry->index];
+    const PartitionEntry& partition_entry = partition_entries[parameters->data_entry->index];
 
-    auto aes_context = Common::AES::CreateContextDecrypt(partition_entry.partition_key.data());
+    if (!state->aes_context || state->aes_context_key != partition_entry.partition_key)
+    {
+      state->aes_context = Common::AES::CreateContextDecrypt(partition_entry.partition_key.data());
+      state->aes_context_key = partition_entry.partition_key;
+    }
+    Common::AES::Context* aes_context = state->aes_context.get();
 
-    const u64 groups = Common::AlignUp(parameters.data.size(), VolumeWii::GROUP_TOTAL_SIZE) /
+    const u64 groups = Common::AlignUp(parameters->data.size(), VolumeWii::GROUP_TOTAL_SIZE) /
                        VolumeWii::GROUP_TOTAL_SIZE;
 
-    ASSERT(parameters.data.size() % VolumeWii::BLOCK_TOTAL_SIZE == 0);
-    const u64 blocks = parameters.data.size() / VolumeWii::BLOCK_TOTAL_SIZE;
+    ASSERT(parameters->data.size() % VolumeWii::BLOCK_TOTAL_SIZE == 0);
+    const u64 blocks = parameters->data.size() / VolumeWii::BLOCK_TOTAL_SIZE;
 
     const u64 blocks_per_chunk = chunks_per_wii_group == 1 ?
                                      exception_lists_per_chunk * VolumeWii::BLOCKS_PER_GROUP :
@@ -1356,7 +1599,7 @@ WIARVZFileReader<RVZ>::ProcessAndCompress(CompressThreadState* state, CompressPa
       return ReuseID{partition_entry.partition_key, size, encrypted, value};
     };
 
-    const u8* parameters_data_end = parameters.data.data() + parameters.data.size();
+    const u8* parameters_data_end = parameters->data.data() + parameters->data.size();
     for (u64 i = 0; i < chunks; ++i)
     {
       const u64 block_index = i * blocks_per_chunk;
@@ -1365,9 +1608,9 @@ WIARVZFileReader<RVZ>::ProcessAndCompress(CompressThreadState* state, CompressPa
       std::optional<ReuseID>& reuse_id = entry.reuse_id;
 
       // Set this chunk as reusable if the encrypted data is AllSame
-      const u8* data = parameters.data.data() + block_index * VolumeWii::BLOCK_TOTAL_SIZE;
+      const u8* data = parameters->data.data() + block_index * VolumeWii::BLOCK_TOTAL_SIZE;
       if (AllSame(data, std::min(parameters_data_end, data + in_data_per_chunk)))
-        reuse_id = create_reuse_id(parameters.data.front(), true, i * blocks_per_chunk);
+        reuse_id = create_reuse_id(parameters->data.front(), true, i * blocks_per_chunk);
 
       TryReuse(reusable_groups, reusable_groups_mutex, &entry);
       if (!entry.reused_group && reuse_id)
@@ -1399,8 +1642,8 @@ WIARVZFileReader<RVZ>::ProcessAndCompress(CompressThreadState* state, CompressPa
           if (j < blocks_in_this_group)
           {
             const u64 offset_of_block = offset_of_group + j * VolumeWii::BLOCK_TOTAL_SIZE;
-            VolumeWii::DecryptBlockData(parameters.data.data() + offset_of_block,
-                                        state->decryption_buffer[j].data(), aes_context.get());
+            VolumeWii::DecryptBlockData(parameters->data.data() + offset_of_block,
+                                        state->decryption_buffer[j].data(), aes_context);
           }
           else
           {
@@ -1424,8 +1667,8 @@ WIARVZFileReader<RVZ>::ProcessAndCompress(CompressThreadState* state, CompressPa
           const u64 hash_offset_of_block = block_index_in_chunk * VolumeWii::BLOCK_HEADER_SIZE;
 
           VolumeWii::HashBlock hashes;
-          VolumeWii::DecryptBlockHashes(parameters.data.data() + offset_of_block, &hashes,
-                                        aes_context.get());
+          VolumeWii::DecryptBlockHashes(parameters->data.data() + offset_of_block, &hashes,
+                                        aes_context);
 
           const auto compare_hash = [&](size_t offset_in_block) {
             ASSERT(offset_in_block + Common::SHA1::DIGEST_LEN <= VolumeWii::BLOCK_HEADER_SIZE);
@@ -1477,7 +1720,7 @@ WIARVZFileReader<RVZ>::ProcessAndCompress(CompressThreadState* state, CompressPa
 
           const u64 bytes_per_chunk = std::min(out_data_per_chunk, VolumeWii::GROUP_DATA_SIZE);
           const u64 total_size = blocks_in_this_group * VolumeWii::BLOCK_DATA_SIZE;
-          const u64 data_offset = parameters.data_offset + write_offset_of_group;
+          const u64 data_offset = parameters->data_offset + write_offset_of_group;
 
           RVZPack(state->decryption_buffer[0].data(), output_entries.data() + first_chunk,
                   bytes_per_chunk, chunks, total_size, data_offset, groups > 1, allow_junk_reuse,
@@ -1642,7 +1885,8 @@ WIARVZFileReader<RVZ>::ProcessAndCompress(CompressThreadState* state, CompressPa
     }
   }
 
-  return OutputParameters{std::move(output_entries), parameters.bytes_read, parameters.group_index};
+  return OutputParameters{std::move(output_entries), parameters->bytes_read,
+                          parameters->group_index};
 }
 
 template <bool RVZ>
@@ -1742,7 +1986,8 @@ template <bool RVZ>
 ConversionResultCode
 WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volume,
                                File::IOFile* outfile, WIARVZCompressionType compression_type,
-                               int compression_level, int chunk_size, CompressCB callback)
+                               int compression_level, int chunk_size, CompressCB callback,
+                               u64 memory_limit)
 {
   ASSERT(infile->GetDataSizeType() == DataSizeType::Accurate);
   ASSERT(chunk_size > 0);
@@ -1822,6 +2067,11 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
     return ConversionResultCode::Success;
   };
 
+  // Input buffers are handed back once a compression thread is done with them,
+  // so that reading the input doesn't need a new allocation for every group
+  std::vector<std::vector<u8>> free_buffers;
+  std::mutex free_buffers_mutex;
+
   const auto process_and_compress = [&](CompressThreadState* state, CompressParameters parameters) {
     const DataEntry& data_entry = *parameters.data_entry;
     const FileSystem* file_system = data_entry.is_partition ?
@@ -1830,10 +2080,18 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 
     const bool compression = compression_type != WIARVZCompressionType::None;
 
-    return ProcessAndCompress(state, std::move(parameters), partition_entries, data_entries,
-                              file_system, &reusable_groups, &reusable_groups_mutex,
-                              chunks_per_wii_group, exception_lists_per_chunk,
-                              compressed_exception_lists, compression);
+    ConversionResult<OutputParameters> result = ProcessAndCompress(
+        state, &parameters, partition_entries, data_entries, file_system, &reusable_groups,
+        &reusable_groups_mutex, chunks_per_wii_group, exception_lists_per_chunk,
+        compressed_exception_lists, compression);
+
+    if (parameters.data.capacity() != 0)
+    {
+      std::lock_guard lk(free_buffers_mutex);
+      free_buffers.push_back(std::move(parameters.data));
+    }
+
+    return result;
   };
 
   const auto output = [&](OutputParameters parameters) {
@@ -1849,7 +2107,18 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   };
 
   MultithreadedCompressor<CompressThreadState, CompressParameters, OutputParameters> mt_compressor(
-      set_up_compress_thread_state, process_and_compress, output);
+      set_up_compress_thread_state, process_and_compress, output,
+      GetCompressThreadCount(compression_type, compression_level, chunk_size, memory_limit));
+
+  struct ReadRequest
+  {
+    const DataEntry* data_entry;
+    u64 offset;
+    u64 size;
+    u64 data_offset_in_partition;
+    size_t group_index;
+  };
+  std::vector<ReadRequest> read_requests;
 
   for (const DataEntry& data_entry : data_entries)
   {
@@ -1901,23 +2170,15 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 
     while (groups_processed < last_group)
     {
-      const ConversionResultCode status = mt_compressor.GetStatus();
-      if (status != ConversionResultCode::Success)
-        return status;
-
       u64 bytes_to_read = chunk_size;
       if (data_entry.is_partition)
         bytes_to_read = std::max<u64>(bytes_to_read, VolumeWii::GROUP_TOTAL_SIZE);
       bytes_to_read = std::min<u64>(bytes_to_read, data_offset + data_size - bytes_read);
 
-      buffer.resize(bytes_to_read);
-      if (!infile->Read(bytes_read, bytes_to_read, buffer.data()))
-        return ConversionResultCode::ReadFailed;
+      read_requests.push_back(ReadRequest{&data_entry, bytes_read, bytes_to_read,
+                                          data_offset_in_partition, groups_processed});
       bytes_read += bytes_to_read;
 
-      mt_compressor.CompressAndWrite(CompressParameters{
-          buffer, &data_entry, data_offset_in_partition, bytes_read, groups_processed});
-
       data_offset += bytes_to_read;
       data_size -= bytes_to_read;
 
@@ -1940,6 +2201,87 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   ASSERT(groups_processed == total_groups);
   ASSERT(bytes_read == iso_size);
 
+  struct ReadResult
+  {
+    std::vector<u8> data;
+    bool success = false;
+  };
+  std::deque<ReadResult> read_results;
+  std::mutex read_results_mutex;
+  std::condition_variable read_results_cv;
+  bool stop_reading = false;
+
+  // The input is read on a separate thread, so that reading the next groups overlaps with
+  // waiting for a compression thread to become available
+  std::thread read_thread([&] {
+    for (const ReadRequest& request : read_requests)
+    {
+      {
+        std::unique_lock lk(read_results_mutex);
+        read_results_cv.wait(
+            lk, [&] { return stop_reading || read_results.size() < READ_AHEAD_GROUPS; });
+        if (stop_reading)
+          return;
+      }
+
+      std::vector<u8> data;
+      {
+        std::lock_guard lk(free_buffers_mutex);
+        if (!free_buffers.empty())
+        {
+          data = std::move(free_buffers.back());
+          free_buffers.pop_back();
+        }
+      }
+
+      data.resize(request.size);
+      const bool success = infile->Read(request.offset, request.size, data.data());
+
+      {
+        std::lock_guard lk(read_results_mutex);
+        read_results.push_back(ReadResult{std::move(data), success});
+      }
+      read_results_cv.notify_all();
+
+      if (!success)
+        return;
+    }
+  });
+
+  Common::ScopeGuard read_thread_guard([&] {
+    {
+      std::lock_guard lk(read_results_mutex);
+      stop_reading = true;
+    }
+    read_results_cv.notify_all();
+    read_thread.join();
+  });
+
+  for (const ReadRequest& request : read_requests)
+  {
+    const ConversionResultCode status = mt_compressor.GetStatus();
+    if (status != ConversionResultCode::Success)
+      return status;
+
+    ReadResult read_result;
+    {
+      std::unique_lock lk(read_results_mutex);
+      read_results_cv.wait(lk, [&] { return !read_results.empty(); });
+      read_result = std::move(read_results.front());
+      read_results.pop_front();
+    }
+    read_results_cv.notify_all();
+
+    if (!read_result.success)
+      return ConversionResultCode::ReadFailed;
+
+    mt_compressor.CompressAndWrite(CompressParameters{
+        std::move(read_result.data), request.data_entry, request.data_offset_in_partition,
+        request.offset + request.size, request.group_index});
+  }
+
+  read_thread_guard.Exit();
+
   mt_compressor.Shutdown();
 
   const ConversionResultCode status = mt_compressor.GetStatus();
@@ -2041,7 +2383,7 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
-                       int chunk_size, CompressCB callback)
+                       int chunk_size, CompressCB callback, u64 memory_limit)
 {
   File::IOFile outfile(outfile_path, "wb");
   if (!outfile)
@@ -2059,7 +2401,7 @@ bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
   const auto convert = rvz ? RVZFileReader::Convert : WIAFileReader::Convert;
   const ConversionResultCode result =
       convert(infile, infile_volume.get(), &outfile, compression_type, compression_level,
-              chunk_size, callback);
+              chunk_size, callback, memory_limit);
 
   if (result == ConversionResultCode::ReadFailed)
     PanicAlertFmtT("Failed to read from the input file \"{0}\".", infile_path);
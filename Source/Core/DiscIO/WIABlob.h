@@ -10,8 +10,10 @@
 #include <mutex>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/AES.h"
 #include "Common/Crypto/SHA1.h"
 #include "Common/IOFile.h"
 #include "Common/Swap.h"
@@ -69,7 +71,8 @@ public:
 
   static ConversionResultCode Convert(BlobReader* infile, const VolumeDisc* infile_volume,
                                       File::IOFile* outfile, WIARVZCompressionType compression_type,
-                                      int compression_level, int chunk_size, CompressCB callback);
+                                      int compression_level, int chunk_size, CompressCB callback,
+                                      u64 memory_limit);
 
 private:
   using WiiKey = std::array<u8, 16>;
@@ -194,6 +197,13 @@ private:
 
     bool Read(u64 offset, u64 size, u8* out_ptr);
 
+    // Ensures that everything before the given offset of the decompressed data is available
+    bool DecompressUntil(u64 end_offset);
+
+    bool IsFullyDecompressed() const;
+    // This can only be called once IsFullyDecompressed returns true
+    std::vector<u8> GetDecompressedData() const;
+
     // This can only be called once at least one byte of data has been read
     void GetHashExceptions(std::vector<HashExceptionEntry>* exception_list,
                            u64 exception_list_index, u16 additional_offset) const;
@@ -240,6 +250,12 @@ private:
   Chunk& ReadCompressedData(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
                             WIARVZCompressionType compression_type, u32 exception_lists = 0,
                             u32 rvz_packed_size = 0, u64 data_offset = 0);
+  Chunk CreateChunk(File::IOFile* file, u64 offset_in_file, u64 compressed_size,
+                    u64 decompressed_size, WIARVZCompressionType compression_type,
+                    u32 exception_lists, u32 rvz_packed_size, u64 data_offset) const;
+  void DecompressGroupsInParallel(u64 offset, u64 size, u64 chunk_size, u64 data_offset,
+                                  u64 data_size, u32 group_index, u32 number_of_groups,
+                                  u32 exception_lists);
 
   static bool ApplyHashExceptions(const std::vector<HashExceptionEntry>& exception_list,
                                   VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]);
@@ -279,6 +295,10 @@ private:
 
     std::unique_ptr<Compressor> compressor;
 
+    // Kept around for as long as consecutive groups belong to the same partition
+    std::unique_ptr<Common::AES::Context> aes_context;
+    WiiKey aes_context_key{};
+
     std::vector<WiiBlockData> decryption_buffer =
         std::vector<WiiBlockData>(VolumeWii::BLOCKS_PER_GROUP);
 
@@ -343,10 +363,13 @@ private:
   static void SetUpCompressor(std::unique_ptr<Compressor>* compressor,
                               WIARVZCompressionType compression_type, int compression_level,
                               WIAHeader2* header_2);
+  static unsigned int GetCompressThreadCount(WIARVZCompressionType compression_type,
+                                             int compression_level, int chunk_size,
+                                             u64 memory_limit);
   static bool TryReuse(std::map<ReuseID, GroupEntry>* reusable_groups,
                        std::mutex* reusable_groups_mutex, OutputParametersEntry* entry);
   static ConversionResult<OutputParameters>
-  ProcessAndCompress(CompressThreadState* state, CompressParameters parameters,
+  ProcessAndCompress(CompressThreadState* state, CompressParameters* parameters,
                      const std::vector<PartitionEntry>& partition_entries,
                      const std::vector<DataEntry>& data_entries, const FileSystem* file_system,
                      std::map<ReuseID, GroupEntry>* reusable_groups,
@@ -368,6 +391,16 @@ private:
   std::string m_path;
   Chunk m_cached_chunk;
   u64 m_cached_chunk_offset = std::numeric_limits<u64>::max();
+
+  // When a read spans multiple compressed groups, they are decompressed in parallel ahead of
+  // time and kept here (keyed by offset in file) until ReadCompressedData picks them up.
+  // Each of the parallel decompressions reads using its own file handle.
+  static constexpr size_t MAX_PARALLEL_GROUPS = 8;
+  std::map<u64, Chunk> m_decompressed_chunks;
+  std::vector<std::unique_ptr<File::IOFile>> m_parallel_files;
+
+  // Fully decompressed groups are also put in the shared ChunkCache, keyed by offset in file.
+  u64 m_chunk_cache_source_id;
   WiiEncryptionCache m_encryption_cache;
 
   std::vector<HashExceptionEntry> m_exception_list;
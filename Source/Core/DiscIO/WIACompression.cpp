@@ -533,6 +533,11 @@ size_t PurgeCompressor::GetSize() const
   return m_bytes_written;
 }
 
+size_t PurgeCompressor::GetMemoryUsage() const
+{
+  return m_buffer.capacity();
+}
+
 Bzip2Compressor::Bzip2Compressor(int compression_level) : m_compression_level(compression_level)
 {
 }
@@ -612,6 +617,13 @@ size_t Bzip2Compressor::GetSize() const
   return static_cast<size_t>(reinterpret_cast<u8*>(m_stream.next_out) - m_buffer.data());
 }
 
+size_t Bzip2Compressor::GetMemoryUsage() const
+{
+  // bzip2 allocates 400 KiB plus eight times the block size, and the block size is
+  // 100 kB times the compression level
+  return m_buffer.capacity() + 400 * 1024 + static_cast<size_t>(m_compression_level) * 800000;
+}
+
 LZMACompressor::LZMACompressor(bool lzma2, int compression_level, u8 compressor_data_out[7],
                                u8* compressor_data_size_out)
 {
@@ -733,6 +745,11 @@ size_t LZMACompressor::GetSize() const
   return static_cast<size_t>(m_stream.next_out - m_buffer.data());
 }
 
+size_t LZMACompressor::GetMemoryUsage() const
+{
+  return m_buffer.capacity() + static_cast<size_t>(lzma_memusage(&m_stream));
+}
+
 ZstdCompressor::ZstdCompressor(int compression_level)
 {
   m_stream = ZSTD_createCStream();
@@ -802,6 +819,11 @@ bool ZstdCompressor::End()
   }
 }
 
+size_t ZstdCompressor::GetMemoryUsage() const
+{
+  return m_buffer.capacity() + (m_stream ? ZSTD_sizeof_CStream(m_stream) : 0);
+}
+
 void ZstdCompressor::ExpandBuffer(size_t bytes_to_add)
 {
   m_buffer.resize(m_buffer.size() + bytes_to_add);
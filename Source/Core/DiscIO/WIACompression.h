@@ -158,6 +158,10 @@ public:
 
   virtual const u8* GetData() const = 0;
   virtual size_t GetSize() const = 0;
+
+  // Approximately how much memory the compressor uses while compressing.
+  // Only accurate once some data has been compressed.
+  virtual size_t GetMemoryUsage() const = 0;
 };
 
 class PurgeCompressor final : public Compressor
@@ -173,6 +177,7 @@ public:
 
   const u8* GetData() const override;
   size_t GetSize() const override;
+  size_t GetMemoryUsage() const override;
 
 private:
   std::vector<u8> m_buffer;
@@ -192,6 +197,7 @@ public:
 
   const u8* GetData() const override;
   size_t GetSize() const override;
+  size_t GetMemoryUsage() const override;
 
 private:
   void ExpandBuffer(size_t bytes_to_add);
@@ -214,6 +220,7 @@ public:
 
   const u8* GetData() const override;
   size_t GetSize() const override;
+  size_t GetMemoryUsage() const override;
 
 private:
   void ExpandBuffer(size_t bytes_to_add);
@@ -237,6 +244,7 @@ public:
 
   const u8* GetData() const override { return m_buffer.data(); }
   size_t GetSize() const override { return m_out_buffer.pos; }
+  size_t GetMemoryUsage() const override;
 
 private:
   void ExpandBuffer(size_t bytes_to_add);
@@ -24,6 +24,9 @@ static const u64 WII_SECTOR_SIZE = 0x8000;
 static const u64 WII_SECTOR_COUNT = 143432 * 2;
 static const u64 WII_DISC_HEADER_SIZE = 256;
 
+// The number of Wii sectors that SectorReader reads into its cache at once
+static const int CHUNK_BLOCKS = 4;
+
 WbfsFileReader::WbfsFileReader(File::IOFile file, const std::string& path)
     : m_size(0), m_good(false)
 {
@@ -42,6 +45,9 @@ WbfsFileReader::WbfsFileReader(File::IOFile file, const std::string& path)
   m_files[0].file.ReadBytes(m_wlba_table.data(), m_blocks_per_disc * sizeof(u16));
   for (size_t i = 0; i < m_blocks_per_disc; i++)
     m_wlba_table[i] = Common::swap16(m_wlba_table[i]);
+
+  SetSectorSize(static_cast<int>(WII_SECTOR_SIZE));
+  SetChunkSize(CHUNK_BLOCKS);
 }
 
 WbfsFileReader::~WbfsFileReader()
@@ -122,20 +128,47 @@ bool WbfsFileReader::ReadHeader()
   return m_header.disc_table[0] != 0;
 }
 
-bool WbfsFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
+bool WbfsFileReader::GetBlock(u64 block_num, u8* out_ptr)
 {
+  return ReadMultipleAlignedBlocks(block_num, 1, out_ptr);
+}
+
+bool WbfsFileReader::ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr)
+{
+  u64 offset = block_num * WII_SECTOR_SIZE;
+  u64 nbytes = num_blocks * WII_SECTOR_SIZE;
   if (offset + nbytes > GetDataSize())
     return false;
 
   while (nbytes)
   {
+    u64 file_offset;
     u64 read_size;
-    File::IOFile& data_file = SeekToCluster(offset, &read_size);
-    if (read_size == 0)
+    FileEntry* file_entry = GetFileForOffset(offset, &file_offset, &read_size);
+    if (!file_entry || read_size == 0)
       return false;
     read_size = std::min(read_size, nbytes);
 
-    if (!data_file.ReadBytes(out_ptr, read_size))
+    // Merge the following clusters into this read for as long as they directly follow
+    // the previous one in the same file, which is the common case for WBFS images
+    while (read_size < nbytes)
+    {
+      u64 next_file_offset;
+      u64 next_available;
+      const FileEntry* next_file_entry =
+          GetFileForOffset(offset + read_size, &next_file_offset, &next_available);
+      if (next_file_entry != file_entry || next_file_offset != file_offset + read_size ||
+          next_available == 0)
+      {
+        break;
+      }
+
+      read_size += std::min(next_available, nbytes - read_size);
+    }
+
+    File::IOFile& data_file = file_entry->file;
+    if (!data_file.Seek(file_offset, File::SeekOrigin::Begin) ||
+        !data_file.ReadBytes(out_ptr, read_size))
     {
       data_file.ClearError();
       return false;
@@ -149,7 +182,8 @@ bool WbfsFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   return true;
 }
 
-File::IOFile& WbfsFileReader::SeekToCluster(u64 offset, u64* available)
+WbfsFileReader::FileEntry* WbfsFileReader::GetFileForOffset(u64 offset, u64* file_offset,
+                                                            u64* available)
 {
   u64 base_cluster = (offset >> m_header.wbfs_sector_shift);
   if (base_cluster < m_blocks_per_disc)
@@ -162,24 +196,21 @@ File::IOFile& WbfsFileReader::SeekToCluster(u64 offset, u64* available)
     {
       if (final_address < (file_entry.base_address + file_entry.size))
       {
-        file_entry.file.Seek(final_address - file_entry.base_address, File::SeekOrigin::Begin);
-        if (available)
-        {
-          u64 till_end_of_file = file_entry.size - (final_address - file_entry.base_address);
-          u64 till_end_of_sector = m_wbfs_sector_size - cluster_offset;
-          *available = std::min(till_end_of_file, till_end_of_sector);
-        }
-
-        return file_entry.file;
+        *file_offset = final_address - file_entry.base_address;
+
+        u64 till_end_of_file = file_entry.size - *file_offset;
+        u64 till_end_of_sector = m_wbfs_sector_size - cluster_offset;
+        *available = std::min(till_end_of_file, till_end_of_sector);
+
+        return &file_entry;
       }
     }
   }
 
   ERROR_LOG_FMT(DISCIO, "Read beyond end of disc");
-  if (available)
-    *available = 0;
-  m_files[0].file.Seek(0, File::SeekOrigin::Begin);
-  return m_files[0].file;
+  *file_offset = 0;
+  *available = 0;
+  return nullptr;
 }
 
 std::unique_ptr<WbfsFileReader> WbfsFileReader::Create(File::IOFile file, const std::string& path)
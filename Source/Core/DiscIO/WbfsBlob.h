@@ -15,7 +15,9 @@ namespace DiscIO
 {
 static constexpr u32 WBFS_MAGIC = 0x53464257;  // "WBFS" (byteswapped to little endian)
 
-class WbfsFileReader : public BlobReader
+// Reads are split at WBFS cluster boundaries, but clusters that are stored next to each other
+// are read with a single host read. Small reads are served from SectorReader's cache.
+class WbfsFileReader : public SectorReader
 {
 public:
   ~WbfsFileReader();
@@ -34,7 +36,9 @@ public:
   std::string GetCompressionMethod() const override { return {}; }
   std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
 
-  bool Read(u64 offset, u64 nbytes, u8* out_ptr) override;
+protected:
+  bool GetBlock(u64 block_num, u8* out_ptr) override;
+  bool ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr) override;
 
 private:
   WbfsFileReader(File::IOFile file, const std::string& path = "");
@@ -43,7 +47,6 @@ private:
   bool AddFileToList(File::IOFile file);
   bool ReadHeader();
 
-  File::IOFile& SeekToCluster(u64 offset, u64* available);
   bool IsGood() { return m_good; }
   struct FileEntry
   {
@@ -57,6 +60,11 @@ private:
     u64 size;
   };
 
+  // Returns the file that stores the given disc offset and sets file_offset to the matching
+  // offset in that file, and available to how many bytes can be read before the end of
+  // the cluster or file. Returns nullptr if the offset is beyond the end of the disc.
+  FileEntry* GetFileForOffset(u64 offset, u64* file_offset, u64* available);
+
   std::vector<FileEntry> m_files;
 
   u64 m_size;
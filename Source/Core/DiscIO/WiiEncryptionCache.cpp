@@ -5,8 +5,10 @@
 
 #include <array>
 #include <cstring>
+#include <future>
 #include <limits>
 #include <memory>
+#include <utility>
 
 #include "Common/Align.h"
 #include "Common/CommonTypes.h"
@@ -21,48 +23,133 @@ WiiEncryptionCache::WiiEncryptionCache(BlobReader* blob) : m_blob(blob)
 
 WiiEncryptionCache::~WiiEncryptionCache() = default;
 
-const std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>*
-WiiEncryptionCache::EncryptGroup(u64 offset, u64 partition_data_offset,
-                                 u64 partition_data_decrypted_size, const Key& key,
-                                 const HashExceptionCallback& hash_exception_callback)
+WiiEncryptionCache::CachedGroup* WiiEncryptionCache::FindCachedGroup(u64 group_offset_on_disc)
 {
+  for (CachedGroup& group : m_cache)
+  {
+    if (group.data && group.offset == group_offset_on_disc)
+      return &group;
+  }
+
+  return nullptr;
+}
+
+WiiEncryptionCache::CachedGroup* WiiEncryptionCache::GetLeastRecentlyUsedGroup()
+{
+  CachedGroup* result = &m_cache[0];
+  for (CachedGroup& group : m_cache)
+  {
+    if (group.last_used < result->last_used)
+      result = &group;
+  }
+
   // Only allocate memory if this function actually ends up getting called
-  if (!m_cache)
+  if (!result->data)
+    result->data = std::make_unique<Group>();
+
+  return result;
+}
+
+bool WiiEncryptionCache::TakeReadAheadResult(u64 group_offset_on_disc, CachedGroup* destination)
+{
+  if (!m_read_ahead_future.valid() || m_read_ahead_offset != group_offset_on_disc)
+    return false;
+
+  if (!m_read_ahead_future.get())
+    return false;
+
+  std::swap(destination->data, m_read_ahead_data);
+  return true;
+}
+
+void WiiEncryptionCache::StartReadAhead(u64 offset, u64 partition_data_offset,
+                                        u64 partition_data_decrypted_size, const Key& key)
+{
+  const u64 group_offset_in_partition =
+      offset / VolumeWii::GROUP_TOTAL_SIZE * VolumeWii::GROUP_DATA_SIZE;
+  const u64 group_offset_on_disc = partition_data_offset + offset;
+
+  if (group_offset_in_partition >= partition_data_decrypted_size ||
+      m_read_ahead_offset == group_offset_on_disc || FindCachedGroup(group_offset_on_disc))
   {
-    m_cache = std::make_unique<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>>();
-    m_cached_offset = std::numeric_limits<u64>::max();
+    return;
   }
 
+  // A previous read-ahead that didn't get used must finish before its buffers can be reused
+  if (m_read_ahead_future.valid())
+    m_read_ahead_future.wait();
+
+  if (!m_read_ahead_blob)
+  {
+    m_read_ahead_blob = m_blob->CopyReader();
+    if (!m_read_ahead_blob)
+      return;
+  }
+  if (!m_read_ahead_data)
+    m_read_ahead_data = std::make_unique<Group>();
+
+  m_read_ahead_offset = group_offset_on_disc;
+  m_read_ahead_future = std::async(
+      std::launch::async, [blob = m_read_ahead_blob.get(), out = m_read_ahead_data.get(),
+                           group_offset_in_partition, partition_data_offset,
+                           partition_data_decrypted_size, key] {
+        return VolumeWii::EncryptGroup(group_offset_in_partition, partition_data_offset,
+                                       partition_data_decrypted_size, key, blob, out);
+      });
+}
+
+const std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>*
+WiiEncryptionCache::EncryptGroup(u64 offset, u64 partition_data_offset,
+                                 u64 partition_data_decrypted_size, const Key& key,
+                                 const HashExceptionCallback& hash_exception_callback)
+{
   ASSERT(offset % VolumeWii::GROUP_TOTAL_SIZE == 0);
   const u64 group_offset_in_partition =
       offset / VolumeWii::GROUP_TOTAL_SIZE * VolumeWii::GROUP_DATA_SIZE;
   const u64 group_offset_on_disc = partition_data_offset + offset;
 
-  if (m_cached_offset != group_offset_on_disc)
+  CachedGroup* group = FindCachedGroup(group_offset_on_disc);
+  if (!group)
   {
-    std::function<void(VolumeWii::HashBlock * hash_blocks)> hash_exception_callback_2;
+    group = GetLeastRecentlyUsedGroup();
+    group->offset = std::numeric_limits<u64>::max();
 
-    if (hash_exception_callback)
+    // The read-ahead doesn't call hash_exception_callback, so it can only be used without one
+    if (hash_exception_callback || !TakeReadAheadResult(group_offset_on_disc, group))
     {
-      hash_exception_callback_2 =
-          [offset, &hash_exception_callback](
-              VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]) {
-            return hash_exception_callback(hash_blocks, offset);
-          };
+      std::function<void(VolumeWii::HashBlock * hash_blocks)> hash_exception_callback_2;
+
+      if (hash_exception_callback)
+      {
+        hash_exception_callback_2 =
+            [offset, &hash_exception_callback](
+                VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]) {
+              return hash_exception_callback(hash_blocks, offset);
+            };
+      }
+
+      if (!VolumeWii::EncryptGroup(group_offset_in_partition, partition_data_offset,
+                                   partition_data_decrypted_size, key, m_blob, group->data.get(),
+                                   hash_exception_callback_2))
+      {
+        return nullptr;
+      }
     }
 
-    if (!VolumeWii::EncryptGroup(group_offset_in_partition, partition_data_offset,
-                                 partition_data_decrypted_size, key, m_blob, m_cache.get(),
-                                 hash_exception_callback_2))
-    {
-      m_cached_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
-      return nullptr;
-    }
+    group->offset = group_offset_on_disc;
+  }
 
-    m_cached_offset = group_offset_on_disc;
+  group->last_used = ++m_use_counter;
+
+  if (!hash_exception_callback &&
+      group_offset_on_disc == m_last_offset + VolumeWii::GROUP_TOTAL_SIZE)
+  {
+    StartReadAhead(offset + VolumeWii::GROUP_TOTAL_SIZE, partition_data_offset,
+                   partition_data_decrypted_size, key);
   }
+  m_last_offset = group_offset_on_disc;
 
-  return m_cache.get();
+  return group->data.get();
 }
 
 bool WiiEncryptionCache::EncryptGroups(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset,
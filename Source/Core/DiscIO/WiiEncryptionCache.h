@@ -4,6 +4,8 @@
 #pragma once
 
 #include <array>
+#include <functional>
+#include <future>
 #include <limits>
 #include <memory>
 
@@ -37,6 +39,8 @@ public:
   // If the returned pointer is nullptr, reading from the blob failed.
   // If the returned pointer is not nullptr, it is guaranteed to be valid until
   // the next call of this function or the destruction of this object.
+  // When groups are requested in order, the next group is encrypted in the background
+  // using a copy of the blob, unless hash_exception_callback is set.
   const std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>*
   EncryptGroup(u64 offset, u64 partition_data_offset, u64 partition_data_decrypted_size,
                const Key& key, const HashExceptionCallback& hash_exception_callback = {});
@@ -48,9 +52,34 @@ public:
                      const HashExceptionCallback& hash_exception_callback = {});
 
 private:
+  using Group = std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>;
+
+  static constexpr size_t CACHED_GROUPS = 4;
+
+  struct CachedGroup
+  {
+    std::unique_ptr<Group> data;
+    u64 offset = std::numeric_limits<u64>::max();
+    u64 last_used = 0;
+  };
+
+  CachedGroup* FindCachedGroup(u64 group_offset_on_disc);
+  CachedGroup* GetLeastRecentlyUsedGroup();
+  bool TakeReadAheadResult(u64 group_offset_on_disc, CachedGroup* destination);
+  void StartReadAhead(u64 offset, u64 partition_data_offset, u64 partition_data_decrypted_size,
+                      const Key& key);
+
   BlobReader* m_blob;
-  std::unique_ptr<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>> m_cache;
-  u64 m_cached_offset = 0;
+  std::array<CachedGroup, CACHED_GROUPS> m_cache;
+  u64 m_use_counter = 0;
+  u64 m_last_offset = std::numeric_limits<u64>::max() - VolumeWii::GROUP_TOTAL_SIZE;
+
+  // Only created once sequential access is detected. The future must be declared after the
+  // objects it uses, so that it gets destroyed (and thereby waited for) first.
+  std::unique_ptr<BlobReader> m_read_ahead_blob;
+  std::unique_ptr<Group> m_read_ahead_data;
+  u64 m_read_ahead_offset = std::numeric_limits<u64>::max();
+  std::future<bool> m_read_ahead_future;
 };
 
 }  // namespace DiscIO
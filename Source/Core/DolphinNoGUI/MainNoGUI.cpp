@@ -7,23 +7,29 @@
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <optional>
 #include <signal.h>
 #include <string>
 #include <vector>
 
+#include <fmt/format.h>
+
 #ifndef _WIN32
 #include <unistd.h>
 #else
 #include <Windows.h>
 #endif
 
+#include "Common/Config/Config.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/Host.h"
+#include "Core/Movie.h"
 #include "Core/System.h"
 
 #include "UICommon/CommandLineParse.h"
@@ -170,6 +176,10 @@ std::unique_ptr<GBAHostInterface> Host_CreateGBAHost(std::weak_ptr<HW::GBA::Core
 
 static std::unique_ptr<Platform> GetPlatform(const optparse::Values& options)
 {
+  // Movies are verified without any window or video output
+  if (options.is_set("verify"))
+    return Platform::CreateHeadlessPlatform();
+
   std::string platform_name = static_cast<const char*>(options.get("platform"));
 
 #if HAVE_X11
@@ -197,6 +207,22 @@ static std::unique_ptr<Platform> GetPlatform(const optparse::Values& options)
   return nullptr;
 }
 
+static int ReportMovieVerification(const std::string& movie_path,
+                                   const Movie::PlaybackVerification& result)
+{
+  const bool success = result.reached_end && !result.first_mismatch_frame;
+
+  std::string status = success ? "OK" : result.first_mismatch_frame ? "DESYNC" : "INCOMPLETE";
+  status += fmt::format(" ({}/{} frames, {}/{} RAM hashes checked", result.frames_played,
+                        result.total_frames, result.checked_ram_hashes, result.total_ram_hashes);
+  if (result.first_mismatch_frame)
+    status += fmt::format(", first mismatch on frame {}", *result.first_mismatch_frame);
+  status += ')';
+
+  fmt::print("{}: {}\n", movie_path, status);
+  return success ? 0 : 1;
+}
+
 #ifdef _WIN32
 #define main app_main
 #endif
@@ -228,6 +254,11 @@ int main(int argc, char* argv[])
             "macos"
 #endif
       });
+  parser->add_option("--verify")
+      .action("store_true")
+      .help("Play the movie given with --movie as fast as possible without video or audio "
+            "output, check it against the RAM hashes stored in it, and exit with a non-zero "
+            "status if it doesn't stay in sync");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
@@ -274,6 +305,17 @@ int main(int argc, char* argv[])
     return 0;
   }
 
+  std::string movie_path;
+  if (options.is_set("movie"))
+    movie_path = static_cast<const char*>(options.get("movie"));
+
+  const bool verify_movie = options.is_set("verify");
+  if (verify_movie && (movie_path.empty() || !game_specified))
+  {
+    fprintf(stderr, "Verifying a movie requires a movie and a game to launch.\n");
+    return 1;
+  }
+
   std::string user_directory;
   if (options.is_set("user"))
     user_directory = static_cast<const char*>(options.get("user"));
@@ -302,6 +344,31 @@ int main(int argc, char* argv[])
     return 1;
   }
 
+  if (verify_movie)
+  {
+    Config::SetCurrent(Config::MAIN_GFX_BACKEND, "Null");
+    Config::SetCurrent(Config::MAIN_AUDIO_BACKEND, BACKEND_NULLSOUND);
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+    Config::SetCurrent(Config::MAIN_MOVIE_PAUSE_MOVIE, false);
+    Config::SetCurrent(Config::MAIN_MOVIE_STOP_AT_END, true);
+  }
+
+  auto& movie = Core::System::GetInstance().GetMovie();
+  if (!movie_path.empty() && boot)
+  {
+    movie.SetReadOnly(true);
+
+    std::optional<std::string> movie_save_state_path;
+    if (!movie.PlayInput(movie_path, &movie_save_state_path))
+    {
+      fprintf(stderr, "Could not play the specified movie\n");
+      return 1;
+    }
+
+    boot->boot_session_data.SetSavestateData(std::move(movie_save_state_path),
+                                             DeleteSavestateAfterBoot::No);
+  }
+
   Core::AddOnStateChangedCallback([](Core::State state) {
     if (state == Core::State::Uninitialized)
       s_platform->Stop();
@@ -338,6 +405,9 @@ int main(int argc, char* argv[])
   Core::Shutdown(Core::System::GetInstance());
   s_platform.reset();
 
+  if (verify_movie)
+    return ReportMovieVerification(movie_path, movie.GetPlaybackVerification());
+
   return 0;
 }
 
@@ -12,6 +12,7 @@
 #include <QDropEvent>
 #include <QFileInfo>
 #include <QIcon>
+#include <QInputDialog>
 #include <QMimeData>
 #include <QStackedWidget>
 #include <QStyleHints>
@@ -20,7 +21,9 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <future>
+#include <limits>
 #include <optional>
 #include <variant>
 
@@ -583,6 +586,7 @@ void MainWindow::ConnectMenuBar()
   connect(m_menu_bar, &MenuBar::StartRecording, this, &MainWindow::OnStartRecording);
   connect(m_menu_bar, &MenuBar::StopRecording, this, &MainWindow::OnStopRecording);
   connect(m_menu_bar, &MenuBar::ExportRecording, this, &MainWindow::OnExportRecording);
+  connect(m_menu_bar, &MenuBar::SeekRecording, this, &MainWindow::OnSeekRecording);
   connect(m_menu_bar, &MenuBar::ShowTASInput, this, &MainWindow::ShowTASInput);
 
   // View
@@ -630,6 +634,7 @@ void MainWindow::ConnectHotkeys()
           &MainWindow::StateLoadLastSavedAt);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateLoadUndo, this, &MainWindow::StateLoadUndo);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveUndo, this, &MainWindow::StateSaveUndo);
+  connect(m_hotkey_scheduler, &HotkeyScheduler::StateRewind, this, &MainWindow::StateRewind);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveOldest, this,
           &MainWindow::StateSaveOldest);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveFile, this, &MainWindow::StateSave);
@@ -787,7 +792,7 @@ QStringList MainWindow::PromptFileNames()
   QStringList paths = DolphinFileDialog::getOpenFileNames(
       this, tr("Select a File"),
       settings.value(QStringLiteral("mainwindow/lastdir"), QString{}).toString(),
-      QStringLiteral("%1 (*.elf *.dol *.gcm *.iso *.tgc *.wbfs *.ciso *.gcz *.wia *.rvz "
+      QStringLiteral("%1 (*.elf *.dol *.gcm *.iso *.tgc *.wbfs *.ciso *.gcz *.wia *.rvz *.dcs "
                      "hif_000000.nfs *.wad *.dff *.m3u *.json);;%2 (*)")
           .arg(tr("All GC/Wii files"))
           .arg(tr("All Files")));
@@ -1472,6 +1477,11 @@ void MainWindow::StateSaveUndo()
   State::UndoSaveState(m_system);
 }
 
+void MainWindow::StateRewind()
+{
+  State::Rewind(m_system);
+}
+
 void MainWindow::StateSaveOldest()
 {
   State::SaveFirstSaved(m_system);
@@ -1911,7 +1921,30 @@ void MainWindow::OnExportRecording()
   QString dtm_file = DolphinFileDialog::getSaveFileName(
       this, tr("Save Recording File As"), QString(), tr("Dolphin TAS Movies (*.dtm)"));
   if (!dtm_file.isEmpty())
-    m_system.GetMovie().SaveRecording(dtm_file.toStdString());
+  {
+    auto& movie = m_system.GetMovie();
+    movie.SaveRecording(dtm_file.toStdString());
+    movie.SaveCheckpoints(dtm_file.toStdString());
+  }
+}
+
+void MainWindow::OnSeekRecording()
+{
+  auto& movie = m_system.GetMovie();
+  if (!movie.IsPlayingInput())
+  {
+    ModalMessageBox::information(this, tr("Seek to Frame"),
+                                 tr("Seeking is only possible while playing back a recording."));
+    return;
+  }
+
+  bool ok = false;
+  const int frame = QInputDialog::getInt(
+      this, tr("Seek to Frame"), tr("Frame:"), static_cast<int>(movie.GetCurrentFrame()), 0,
+      static_cast<int>(std::min<u64>(movie.GetTotalFrames(), std::numeric_limits<int>::max())), 1,
+      &ok);
+  if (ok)
+    movie.SeekToFrame(static_cast<u64>(frame));
 }
 
 void MainWindow::OnActivateChat()
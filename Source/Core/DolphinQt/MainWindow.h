@@ -113,6 +113,7 @@ private:
   void StateLoadLastSavedAt(int slot);
   void StateLoadUndo();
   void StateSaveUndo();
+  void StateRewind();
   void StateSaveOldest();
   void SetStateSlot(int slot);
   void IncrementSelectedStateSlot();
@@ -200,6 +201,7 @@ private:
   void OnStartRecording();
   void OnStopRecording();
   void OnExportRecording();
+  void OnSeekRecording();
   void OnActivateChat();
   void OnRequestGolfControl();
   void ShowTASInput();
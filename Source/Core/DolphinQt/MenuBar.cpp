@@ -139,6 +139,7 @@ void MenuBar::OnEmulationStateChanged(Core::State state)
   {
     m_recording_stop->setEnabled(false);
     m_recording_export->setEnabled(false);
+    m_recording_seek->setEnabled(false);
   }
   const bool can_start_from_boot = m_game_selected && state == Core::State::Uninitialized;
   const bool can_start_from_savestate =
@@ -800,11 +801,14 @@ void MenuBar::AddMovieMenu()
                                            [this] { emit StopRecording(); });
   m_recording_export =
       movie_menu->addAction(tr("Export Recording..."), this, [this] { emit ExportRecording(); });
+  m_recording_seek =
+      movie_menu->addAction(tr("Seek to Frame..."), this, [this] { emit SeekRecording(); });
 
   m_recording_start->setEnabled(false);
   m_recording_play->setEnabled(false);
   m_recording_stop->setEnabled(false);
   m_recording_export->setEnabled(false);
+  m_recording_seek->setEnabled(false);
 
   m_recording_read_only = movie_menu->addAction(tr("&Read-Only Mode"));
   m_recording_read_only->setCheckable(true);
@@ -1297,6 +1301,7 @@ void MenuBar::OnRecordingStatusChanged(bool recording)
   m_recording_start->setEnabled(!recording && (can_start_from_boot || can_start_from_savestate));
   m_recording_stop->setEnabled(recording);
   m_recording_export->setEnabled(recording);
+  m_recording_seek->setEnabled(recording);
 }
 
 void MenuBar::OnReadOnlyModeChanged(bool read_only)
@@ -53,6 +53,8 @@ static std::optional<DiscIO::BlobType> ParseFormatString(const std::string& form
     return DiscIO::BlobType::WIA;
   else if (format_str == "rvz")
     return DiscIO::BlobType::RVZ;
+  else if (format_str == "dcs")
+    return DiscIO::BlobType::CHUNK_STORE;
   return std::nullopt;
 }
 
@@ -85,7 +87,15 @@ int ConvertCommand(const std::vector<std::string>& args)
       .type("string")
       .action("store")
       .help("Container format to use. Default is RVZ. [%choices]")
-      .choices({"iso", "gcz", "wia", "rvz"});
+      .choices({"iso", "gcz", "wia", "rvz", "dcs"});
+
+  parser.add_option("-k", "--chunk_store")
+      .type("string")
+      .action("store")
+      .help("Directory of the shared chunk store when converting to DCS. Relative paths are "
+            "relative to the output file. Default is 'chunks'.")
+      .metavar("DIR")
+      .set_default("");
 
   parser.add_option("-s", "--scrub")
       .action("store_true")
@@ -108,7 +118,13 @@ int ConvertCommand(const std::vector<std::string>& args)
       .type("int")
       .action("store")
       .help("Level of compression for the selected method. Ignored if 'none'. Suggested value for "
-            "zstd: 5");
+            "zstd: 5. Used for DCS, where it defaults to 5.");
+
+  parser.add_option("-m", "--memory_limit")
+      .type("int")
+      .action("store")
+      .help("Approximate amount of memory in MiB that WIA/RVZ conversion may use. Fewer "
+            "compression threads are used if needed. Default is no limit.");
 
   const optparse::Values& options = parser.parse_args(args);
 
@@ -296,6 +312,40 @@ int ConvertCommand(const std::vector<std::string>& args)
     }
   }
 
+  // --memory_limit
+  u64 memory_limit = 0;
+  if (options.is_set("memory_limit"))
+  {
+    const int memory_limit_mib = static_cast<int>(options.get("memory_limit"));
+    if (memory_limit_mib <= 0)
+    {
+      fmt::print(std::cerr, "Error: Memory limit must be a positive number of MiB\n");
+      return EXIT_FAILURE;
+    }
+    memory_limit = static_cast<u64>(memory_limit_mib) * 0x100000;
+  }
+
+  if (format == DiscIO::BlobType::CHUNK_STORE)
+  {
+    if (blob_reader->GetDataSizeType() != DiscIO::DataSizeType::Accurate)
+    {
+      fmt::print(std::cerr, "Error: The size of the input's data is not known exactly. Convert it "
+                            "to ISO, WIA or RVZ first.\n");
+      return EXIT_FAILURE;
+    }
+
+    if (!compression_level_o.has_value())
+      compression_level_o = 5;
+
+    const std::pair<int, int> range =
+        DiscIO::GetAllowedCompressionLevels(DiscIO::WIARVZCompressionType::Zstd, false);
+    if (compression_level_o.value() < range.first || compression_level_o.value() > range.second)
+    {
+      fmt::print(std::cerr, "Error: Compression level not in acceptable range\n");
+      return EXIT_FAILURE;
+    }
+  }
+
   // Perform the conversion
   const auto NOOP_STATUS_CALLBACK = [](const std::string& text, float percent) { return true; };
 
@@ -331,7 +381,15 @@ int ConvertCommand(const std::vector<std::string>& args)
     success = DiscIO::ConvertToWIAOrRVZ(blob_reader.get(), input_file_path, output_file_path,
                                         format == DiscIO::BlobType::RVZ, compression_o.value(),
                                         compression_level_o.value(), block_size_o.value(),
-                                        NOOP_STATUS_CALLBACK);
+                                        NOOP_STATUS_CALLBACK, memory_limit);
+    break;
+  }
+
+  case DiscIO::BlobType::CHUNK_STORE:
+  {
+    success = DiscIO::ConvertToChunkStore(blob_reader.get(), input_file_path, output_file_path,
+                                          options["chunk_store"], compression_level_o.value(),
+                                          NOOP_STATUS_CALLBACK);
     break;
   }
 
@@ -64,7 +64,8 @@ static bool VolumeSupported(const DiscIO::Volume& disc_volume)
 }
 
 static void ExtractDirectory(const DiscIO::Volume& disc_volume, const DiscIO::Partition& partition,
-                             const std::string& path, const std::string& out, bool quiet)
+                             const std::string& path, const std::string& out, bool quiet,
+                             unsigned int num_threads)
 {
   const DiscIO::FileSystem* filesystem = disc_volume.GetFileSystem(partition);
   if (!filesystem)
@@ -81,7 +82,8 @@ static void ExtractDirectory(const DiscIO::Volume& disc_volume, const DiscIO::Pa
         if (!quiet)
           fmt::println(std::cerr, "Extracting: {} | {}%", current, static_cast<int>(progress));
         return false;
-      });
+      },
+      num_threads);
 }
 
 static bool ExtractSystemData(const DiscIO::Volume& disc_volume, const DiscIO::Partition& partition,
@@ -91,9 +93,9 @@ static bool ExtractSystemData(const DiscIO::Volume& disc_volume, const DiscIO::P
 }
 
 static void ExtractPartition(const DiscIO::Volume& disc_volume, const DiscIO::Partition& partition,
-                             const std::string& out, bool quiet)
+                             const std::string& out, bool quiet, unsigned int num_threads)
 {
-  ExtractDirectory(disc_volume, partition, "", out + "/files", quiet);
+  ExtractDirectory(disc_volume, partition, "", out + "/files", quiet, num_threads);
   ExtractSystemData(disc_volume, partition, out);
 }
 
@@ -177,14 +179,15 @@ static bool ListVolume(const DiscIO::Volume& disc_volume, const std::string& pat
 
 static bool HandleExtractPartition(const std::string& output, const std::string& single_file_path,
                                    const std::string& partition_name, DiscIO::Volume& disc_volume,
-                                   const DiscIO::Partition& partition, bool quiet, bool single)
+                                   const DiscIO::Partition& partition, bool quiet, bool single,
+                                   unsigned int num_threads)
 {
   std::string file;
   file.append(output).append("/");
   file.append(partition_name).append("/");
   if (!single)
   {
-    ExtractPartition(disc_volume, partition, file, quiet);
+    ExtractPartition(disc_volume, partition, file, quiet, num_threads);
     return true;
   }
 
@@ -195,7 +198,7 @@ static bool HandleExtractPartition(const std::string& output, const std::string&
     if (file_info->IsDirectory())
     {
       file = PathToString(StringToPath(file).remove_filename());
-      ExtractDirectory(disc_volume, partition, single_file_path, file, quiet);
+      ExtractDirectory(disc_volume, partition, single_file_path, file, quiet, num_threads);
     }
     else
     {
@@ -241,12 +244,29 @@ int Extract(const std::vector<std::string>& args)
   parser.add_option("-g", "--gameonly")
       .action("store_true")
       .help("Only extracts the DATA partition.");
+  parser.add_option("-j", "--threads")
+      .type("int")
+      .action("store")
+      .help("Number of threads used for extracting files. Defaults to the number of CPU threads.")
+      .metavar("THREADS");
 
   const optparse::Values& options = parser.parse_args(args);
 
   const bool quiet = options.is_set("quiet");
   const bool gameonly = options.is_set("gameonly");
 
+  unsigned int num_threads = 0;
+  if (options.is_set("threads"))
+  {
+    const int threads = static_cast<int>(options.get("threads"));
+    if (threads < 1)
+    {
+      fmt::println(std::cerr, "Error: The number of threads must be at least 1");
+      return EXIT_FAILURE;
+    }
+    num_threads = static_cast<unsigned int>(threads);
+  }
+
   if (!options.is_set("input"))
   {
     fmt::println(std::cerr, "Error: No input image set");
@@ -335,7 +355,8 @@ int Extract(const std::vector<std::string>& args)
     }
 
     extracted_one = HandleExtractPartition(output_folder_path, single_file_path, "", *disc_volume,
-                                           DiscIO::PARTITION_NONE, quiet, options.is_set("single"));
+                                           DiscIO::PARTITION_NONE, quiet, options.is_set("single"),
+                                           num_threads);
   }
   else
   {
@@ -353,7 +374,7 @@ int Extract(const std::vector<std::string>& args)
 
         extracted_one |=
             HandleExtractPartition(output_folder_path, single_file_path, partition_name,
-                                   *disc_volume, p, quiet, options.is_set("single"));
+                                   *disc_volume, p, quiet, options.is_set("single"), num_threads);
       }
     }
   }
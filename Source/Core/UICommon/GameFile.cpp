@@ -104,6 +104,8 @@ GameFile::GameFile() = default;
 GameFile::GameFile(std::string path) : m_file_path(std::move(path))
 {
   m_file_name = PathToFileName(m_file_path);
+  m_size_on_disk = File::GetSize(m_file_path);
+  m_modification_time = File::GetLastWriteTime(m_file_path).value_or(0);
 
   {
     std::unique_ptr<DiscIO::Volume> volume(DiscIO::CreateVolume(m_file_path));
@@ -187,6 +189,12 @@ GameFile::GameFile(std::string path) : m_file_path(std::move(path))
 
 GameFile::~GameFile() = default;
 
+bool GameFile::FileChangedOnDisk() const
+{
+  return File::GetSize(m_file_path) != m_size_on_disk ||
+         File::GetLastWriteTime(m_file_path).value_or(0) != m_modification_time;
+}
+
 bool GameFile::IsValid() const
 {
   if (!m_valid)
@@ -300,6 +308,8 @@ void GameFile::DoState(PointerWrap& p)
   p.Do(m_valid);
   p.Do(m_file_path);
   p.Do(m_file_name);
+  p.Do(m_size_on_disk);
+  p.Do(m_modification_time);
 
   p.Do(m_file_size);
   p.Do(m_volume_size);
@@ -57,6 +57,9 @@ public:
   ~GameFile();
 
   bool IsValid() const;
+  // Returns true if the size or modification time of the file on disk
+  // differs from when this GameFile was created
+  bool FileChangedOnDisk() const;
   const std::string& GetFilePath() const { return m_file_path; }
   const std::string& GetFileName() const { return m_file_name; }
   const std::string& GetName(const Core::TitleDatabase& title_database) const;
@@ -144,6 +147,8 @@ private:
   bool m_valid{};
   std::string m_file_path;
   std::string m_file_name;
+  u64 m_size_on_disk{};
+  s64 m_modification_time{};
 
   u64 m_file_size{};
   u64 m_volume_size{};
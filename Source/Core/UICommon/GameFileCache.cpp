@@ -4,21 +4,29 @@
 #include "UICommon/GameFileCache.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstddef>
+#include <filesystem>
 #include <functional>
+#include <future>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "Common/ChunkFile.h"
+#include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/StringUtil.h"
 
 #include "DiscIO/DirectoryBlob.h"
 
@@ -26,17 +34,236 @@
 
 namespace UICommon
 {
-static constexpr u32 CACHE_REVISION = 25;  // Last changed in PR 12702
+static constexpr u32 CACHE_REVISION = 27;  // Last changed for GameFile::m_modification_time
+static constexpr u32 DIRECTORY_INDEX_REVISION = 1;
+
+static constexpr char DIRECTORY_INDEX_FILENAME[] = "gamedirs.cache";
+
+namespace
+{
+// What a directory contained the last time it was listed. Adding, removing or renaming an entry
+// updates the modification time of its parent directory, so as long as that time hasn't changed,
+// the directory doesn't need to be listed again.
+struct IndexedDirectory
+{
+  s64 modification_time = 0;
+  std::vector<std::string> game_paths;
+  std::vector<std::string> subdirectories;
+
+  bool operator==(const IndexedDirectory&) const = default;
+};
+
+using DirectoryIndex = std::map<std::string, IndexedDirectory>;
+}  // namespace
+
+static std::string GetDirectoryIndexPath()
+{
+  return File::GetUserPath(D_CACHE_IDX) + DIRECTORY_INDEX_FILENAME;
+}
+
+static void DoDirectoryIndex(PointerWrap& p, DirectoryIndex* index)
+{
+  u32 revision = DIRECTORY_INDEX_REVISION;
+  p.Do(revision);
+  if (p.IsReadMode() && revision != DIRECTORY_INDEX_REVISION)
+  {
+    p.SetMeasureMode();
+    return;
+  }
+
+  u32 size = static_cast<u32>(index->size());
+  p.Do(size);
+  if (p.IsReadMode())
+  {
+    for (u32 i = 0; i < size && p.IsReadMode(); ++i)
+    {
+      std::string path;
+      IndexedDirectory directory;
+      p.Do(path);
+      p.Do(directory.modification_time);
+      p.Do(directory.game_paths);
+      p.Do(directory.subdirectories);
+      index->emplace(std::move(path), std::move(directory));
+    }
+  }
+  else
+  {
+    for (auto& [path, directory] : *index)
+    {
+      std::string path_copy = path;
+      p.Do(path_copy);
+      p.Do(directory.modification_time);
+      p.Do(directory.game_paths);
+      p.Do(directory.subdirectories);
+    }
+  }
+}
+
+static DirectoryIndex LoadDirectoryIndex()
+{
+  DirectoryIndex index;
+
+  File::IOFile f(GetDirectoryIndexPath(), "rb");
+  std::vector<u8> buffer(f ? f.GetSize() : 0);
+  if (buffer.empty() || !f.ReadBytes(buffer.data(), buffer.size()))
+    return index;
+
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+  DoDirectoryIndex(p, &index);
+  if (!p.IsReadMode())
+    index.clear();
+
+  return index;
+}
+
+static void SaveDirectoryIndex(DirectoryIndex* index)
+{
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  DoDirectoryIndex(p_measure, index);
+  const size_t buffer_size = reinterpret_cast<size_t>(ptr);
+
+  std::vector<u8> buffer(buffer_size);
+  ptr = buffer.data();
+  PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
+  DoDirectoryIndex(p, index);
+
+  File::IOFile f(GetDirectoryIndexPath(), "wb");
+  if (!f || !f.WriteBytes(buffer.data(), buffer.size()))
+  {
+    f.Close();
+    File::Delete(GetDirectoryIndexPath());
+  }
+}
+
+static bool IsGameExtension(const std::filesystem::path& path,
+                            const std::vector<std::string>& extensions)
+{
+  std::string extension = PathToString(path.extension());
+  Common::ToLower(&extension);
+  return std::ranges::find(extensions, extension) != extensions.end();
+}
+
+// Lists a directory, or takes the listing from the index if the directory hasn't been modified.
+// Returns false if the directory couldn't be accessed.
+static bool ScanGameDirectory(const std::string& directory,
+                              const std::vector<std::string>& extensions,
+                              const DirectoryIndex& old_index, DirectoryIndex* new_index)
+{
+  if (new_index->contains(directory))
+    return true;
+
+  const std::filesystem::path directory_path = StringToPath(directory);
+  const std::optional<s64> modification_time = File::GetLastWriteTime(directory);
+  if (!modification_time)
+    return false;
+
+  const auto it = old_index.find(directory);
+  if (it != old_index.end() && it->second.modification_time == *modification_time)
+  {
+    new_index->emplace(directory, it->second);
+    return true;
+  }
+
+  IndexedDirectory result;
+  result.modification_time = *modification_time;
+
+  std::error_code error;
+  for (auto entry_it = std::filesystem::directory_iterator(directory_path, error);
+       entry_it != std::filesystem::directory_iterator(); entry_it.increment(error))
+  {
+    const std::filesystem::directory_entry& entry = *entry_it;
+    if (entry.is_directory())
+    {
+      // Like DoFileSearch, don't follow symlinks to directories
+      if (!entry.is_symlink())
+        result.subdirectories.emplace_back(PathToString(entry.path()));
+    }
+    else if (IsGameExtension(entry.path(), extensions))
+    {
+      result.game_paths.emplace_back(PathToString(entry.path()));
+    }
+  }
+  if (error)
+    return false;
+
+  new_index->emplace(directory, std::move(result));
+  return true;
+}
 
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan)
 {
   static const std::vector<std::string> search_extensions = {
       ".gcm", ".tgc", ".iso", ".ciso", ".gcz", ".wbfs", ".wia",
-      ".rvz", ".nfs", ".wad", ".dol",  ".elf", ".json"};
+      ".rvz", ".dcs", ".nfs", ".wad",  ".dol", ".elf",  ".json"};
+
+  static std::mutex index_mutex;
+  std::lock_guard lk(index_mutex);
+
+  const DirectoryIndex old_index = LoadDirectoryIndex();
+  DirectoryIndex new_index;
+
+  std::vector<std::string> result;
+  std::vector<std::string> directories_to_fall_back_on;
+
+  for (const std::string& root : directories_to_scan)
+  {
+    // Directories that std::filesystem can't access (e.g. Android content URIs) are searched
+    // with DoFileSearch, without using the index
+    if (!ScanGameDirectory(root, search_extensions, old_index, &new_index))
+    {
+      directories_to_fall_back_on.push_back(root);
+      continue;
+    }
+
+    std::vector<std::string> pending{root};
+    while (!pending.empty())
+    {
+      const std::string directory = std::move(pending.back());
+      pending.pop_back();
+
+      const auto it = new_index.find(directory);
+      if (it == new_index.end())
+        continue;
+
+      result.insert(result.end(), it->second.game_paths.begin(), it->second.game_paths.end());
+      if (!recursive_scan)
+        continue;
+
+      for (const std::string& subdirectory : it->second.subdirectories)
+      {
+        if (!new_index.contains(subdirectory) &&
+            ScanGameDirectory(subdirectory, search_extensions, old_index, &new_index))
+        {
+          pending.push_back(subdirectory);
+        }
+      }
+    }
+  }
+
+  if (new_index != old_index)
+    SaveDirectoryIndex(&new_index);
+
+  if (!directories_to_fall_back_on.empty())
+  {
+    std::vector<std::string> partial_result =
+        Common::DoFileSearch(directories_to_fall_back_on, search_extensions, recursive_scan);
+    result.insert(result.end(), std::make_move_iterator(partial_result.begin()),
+                  std::make_move_iterator(partial_result.end()));
+  }
+
+  // Same post-processing as DoFileSearch
+  std::ranges::sort(result);
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  if constexpr (std::filesystem::path::preferred_separator != DIR_SEP_CHR)
+  {
+    for (std::string& path : result)
+      std::ranges::replace(path, '\\', DIR_SEP_CHR);
+  }
 
-  // TODO: We could process paths iteratively as they are found
-  return Common::DoFileSearch(directories_to_scan, search_extensions, recursive_scan);
+  return result;
 }
 
 GameFileCache::GameFileCache() : m_path(File::GetUserPath(D_CACHE_IDX) + "gamelist.cache")
@@ -57,7 +284,10 @@ size_t GameFileCache::GetSize() const
 void GameFileCache::Clear(DeleteOnDisk delete_on_disk)
 {
   if (delete_on_disk != DeleteOnDisk::No)
+  {
     File::Delete(m_path);
+    File::Delete(GetDirectoryIndexPath());
+  }
 
   m_cached_files.clear();
 }
@@ -68,7 +298,13 @@ std::shared_ptr<const GameFile> GameFileCache::AddOrGet(const std::string& path,
   auto it = std::find_if(
       m_cached_files.begin(), m_cached_files.end(),
       [&path](const std::shared_ptr<GameFile>& file) { return file->GetFilePath() == path; });
-  const bool found = it != m_cached_files.cend();
+  bool found = it != m_cached_files.cend();
+  if (found && (*it)->FileChangedOnDisk())
+  {
+    *it = std::move(m_cached_files.back());
+    m_cached_files.pop_back();
+    found = false;
+  }
   if (!found)
   {
     std::shared_ptr<UICommon::GameFile> game = std::make_shared<GameFile>(path);
@@ -129,24 +365,90 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
     m_cached_files.erase(it, m_cached_files.end());
   }
 
-  // Now that the previous loop has run, game_paths only contains paths that
-  // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const std::string& path : game_paths)
+  // Now that the previous loop has run, game_paths only contains paths that aren't in
+  // m_cached_files. Those have to be opened, and the files in m_cached_files have to be checked
+  // for changes on disk. Both mostly consist of waiting for I/O, so they're done on several
+  // threads. The callbacks are still called on this thread, as soon as each result is ready.
+  const std::vector<std::string> new_paths(game_paths.begin(), game_paths.end());
+  const size_t num_cached = m_cached_files.size();
+  const size_t num_items = num_cached + new_paths.size();
+
+  std::mutex results_mutex;
+  std::condition_variable results_changed;
+  std::vector<std::pair<size_t, std::shared_ptr<GameFile>>> results;
+  size_t workers_running = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u),
+                                            num_items);
+  std::atomic<size_t> next_item = 0;
+
+  // Workers only access m_cached_files[i] for the items they have claimed,
+  // and this thread only writes to it after the worker has reported its result
+  const auto worker = [&] {
+    for (size_t i = next_item++; i < num_items && !processing_halted; i = next_item++)
+    {
+      std::shared_ptr<GameFile> file;
+      if (i >= num_cached)
+        file = std::make_shared<GameFile>(new_paths[i - num_cached]);
+      else if (m_cached_files[i]->FileChangedOnDisk())
+        file = std::make_shared<GameFile>(m_cached_files[i]->GetFilePath());
+
+      std::lock_guard lk(results_mutex);
+      results.emplace_back(i, std::move(file));
+      results_changed.notify_one();
+    }
+
+    std::lock_guard lk(results_mutex);
+    --workers_running;
+    results_changed.notify_one();
+  };
+
+  std::vector<std::future<void>> workers;
+  for (size_t i = 0; i < workers_running; ++i)
+    workers.push_back(std::async(std::launch::async, worker));
+
+  std::vector<std::shared_ptr<GameFile>> added_files;
+  std::vector<std::pair<size_t, std::shared_ptr<GameFile>>> ready_results;
+  while (true)
   {
-    if (processing_halted)
-      break;
+    {
+      std::unique_lock lk(results_mutex);
+      results_changed.wait(lk, [&] { return !results.empty() || workers_running == 0; });
+      if (results.empty())
+        break;
+      std::swap(ready_results, results);
+    }
 
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
+    for (auto& [i, file] : ready_results)
     {
-      if (game_added_to_cache)
-        game_added_to_cache(file);
+      if (!file)
+        continue;  // A cached file which hasn't changed
+
+      if (i < num_cached)
+      {
+        if (game_removed_from_cache)
+          game_removed_from_cache(m_cached_files[i]->GetFilePath());
+
+        cache_changed = true;
+        m_cached_files[i] = nullptr;
+      }
 
-      cache_changed = true;
-      m_cached_files.push_back(std::move(file));
+      if (file->IsValid())
+      {
+        if (game_added_to_cache)
+          game_added_to_cache(file);
+
+        cache_changed = true;
+        added_files.push_back(std::move(file));
+      }
     }
+    ready_results.clear();
   }
 
+  workers.clear();
+
+  std::erase(m_cached_files, nullptr);
+  m_cached_files.insert(m_cached_files.end(), std::make_move_iterator(added_files.begin()),
+                        std::make_move_iterator(added_files.end()));
+
   return cache_changed;
 }
 
@@ -3,7 +3,12 @@
 
 #include "VideoCommon/AsyncShaderCompiler.h"
 
+#include <algorithm>
+#include <string>
 #include <thread>
+#include <utility>
+
+#include <fmt/format.h>
 
 #include "Common/Assert.h"
 #include "Common/Logging/Log.h"
@@ -30,17 +35,104 @@ void AsyncShaderCompiler::QueueWorkItem(WorkItemPtr item, u32 priority)
   // If no worker threads are available, compile synchronously.
   if (!HasWorkerThreads())
   {
-    item->Compile();
-    m_completed_work.push_back(std::move(item));
+    if (item->Compile())
+      m_completed_work.push_back(std::move(item));
   }
   else
   {
     std::lock_guard<std::mutex> guard(m_pending_work_lock);
-    m_pending_work.emplace(priority, std::move(item));
+    m_pending_work.emplace(priority, PendingWorkItem{std::move(item), Clock::now()});
     m_worker_thread_wake.notify_one();
   }
 }
 
+void AsyncShaderCompiler::SetBackgroundPriority(u32 background_priority)
+{
+  std::lock_guard<std::mutex> guard(m_pending_work_lock);
+  m_background_priority = background_priority;
+  m_worker_thread_wake.notify_all();
+}
+
+AsyncShaderCompiler::LatencyHistogram AsyncShaderCompiler::GetLatencyHistogram(bool background,
+                                                                               bool reset)
+{
+  std::lock_guard<std::mutex> guard(m_pending_work_lock);
+  LatencyHistogram& histogram = background ? m_background_latency : m_urgent_latency;
+  const LatencyHistogram result = histogram;
+  if (reset)
+    histogram = {};
+  return result;
+}
+
+u32 AsyncShaderCompiler::LatencyHistogram::GetPercentileUpperBound(u32 percent) const
+{
+  if (count == 0)
+    return 0;
+
+  const u64 target = (count * percent + 99) / 100;
+  u64 seen = 0;
+  for (size_t i = 0; i < NUM_BUCKETS - 1; i++)
+  {
+    seen += buckets[i];
+    if (seen >= target)
+      return 1u << i;
+  }
+  return 1u << (NUM_BUCKETS - 1);
+}
+
+bool AsyncShaderCompiler::CanStartBackgroundWork()
+{
+  // Keep one worker free for urgent work, unless there's only a single worker.
+  const size_t num_workers = m_num_worker_threads.load();
+  const size_t max_background_workers = num_workers > 1 ? num_workers - 1 : 1;
+  UpdateBackgroundWorkerLimit(max_background_workers);
+  return m_busy_background_workers < m_background_worker_limit;
+}
+
+void AsyncShaderCompiler::UpdateBackgroundWorkerLimit(size_t max_background_workers)
+{
+  constexpr auto SAMPLE_INTERVAL = std::chrono::milliseconds(250);
+
+  size_t limit = std::min(m_background_worker_limit, max_background_workers);
+  const Clock::time_point now = Clock::now();
+  if (now - m_last_cpu_sample_time >= SAMPLE_INTERVAL)
+  {
+    m_last_cpu_sample_time = now;
+    const std::optional<Common::SystemCPUTimes> times = Common::GetSystemCPUTimes();
+    const std::optional<Common::SystemCPUTimes> last_times =
+        std::exchange(m_last_cpu_times, times);
+    if (times && last_times && times->total > last_times->total)
+    {
+      const double idle_cores = static_cast<double>(times->idle - last_times->idle) /
+                                (times->total - last_times->total) *
+                                std::thread::hardware_concurrency();
+
+      // Take on one more background worker while a core is idle, and give one up while the host
+      // is saturated, so that background compiles don't take time away from emulation.
+      if (idle_cores >= 1.0)
+        limit++;
+      else if (idle_cores < 0.5)
+        limit--;
+    }
+  }
+
+  // At least one worker always runs background work, so that it makes progress.
+  m_background_worker_limit = std::clamp<size_t>(limit, 1, max_background_workers);
+}
+
+void AsyncShaderCompiler::RecordLatency(bool background, Clock::duration latency)
+{
+  LatencyHistogram& histogram = background ? m_background_latency : m_urgent_latency;
+  const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(latency).count();
+
+  size_t bucket = 0;
+  while (bucket < LatencyHistogram::NUM_BUCKETS - 1 && ms >= (1LL << bucket))
+    bucket++;
+
+  histogram.buckets[bucket]++;
+  histogram.count++;
+}
+
 void AsyncShaderCompiler::RetrieveWorkItems()
 {
   std::deque<WorkItemPtr> completed_work;
@@ -141,6 +233,7 @@ bool AsyncShaderCompiler::StartWorkerThreads(u32 num_worker_threads)
     }
 
     m_worker_threads.push_back(std::move(thr));
+    m_num_worker_threads.store(m_worker_threads.size());
   }
 
   return HasWorkerThreads();
@@ -176,7 +269,23 @@ void AsyncShaderCompiler::StopWorkerThreads()
   for (std::thread& thr : m_worker_threads)
     thr.join();
   m_worker_threads.clear();
+  m_num_worker_threads.store(0);
   m_exit_flag.Clear();
+  m_background_worker_limit = std::numeric_limits<size_t>::max();
+  m_last_cpu_times.reset();
+
+  for (const bool background : {false, true})
+  {
+    const LatencyHistogram histogram = GetLatencyHistogram(background);
+    if (histogram.count == 0)
+      continue;
+
+    std::string buckets;
+    for (size_t i = 0; i < histogram.buckets.size(); i++)
+      buckets += fmt::format(" <{}ms:{}", 1u << i, histogram.buckets[i]);
+    INFO_LOG_FMT(VIDEO, "Shader compiler {} work latency ({} items):{}",
+                 background ? "background" : "urgent", histogram.count, buckets);
+  }
 }
 
 bool AsyncShaderCompiler::WorkerThreadInitMainThread(void** param)
@@ -223,9 +332,17 @@ void AsyncShaderCompiler::WorkerThreadRun()
 
     while (!m_pending_work.empty() && !m_exit_flag.IsSet())
     {
-      m_busy_workers++;
+      // The first item is always the most urgent one, so if it's background work, everything is.
       auto iter = m_pending_work.begin();
-      WorkItemPtr item(std::move(iter->second));
+      const bool background = iter->first >= m_background_priority;
+      if (background && !CanStartBackgroundWork())
+        break;
+
+      m_busy_workers++;
+      if (background)
+        m_busy_background_workers++;
+      WorkItemPtr item(std::move(iter->second.item));
+      const Clock::time_point queue_time = iter->second.queue_time;
       m_pending_work.erase(iter);
       pending_lock.unlock();
 
@@ -237,6 +354,13 @@ void AsyncShaderCompiler::WorkerThreadRun()
 
       pending_lock.lock();
       m_busy_workers--;
+      RecordLatency(background, Clock::now() - queue_time);
+      if (background)
+      {
+        // Another worker may be waiting for a background slot to become available.
+        m_busy_background_workers--;
+        m_worker_thread_wake.notify_one();
+      }
     }
   }
 }
@@ -3,13 +3,17 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -17,6 +21,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
+#include "Common/Thread.h"
 
 namespace VideoCommon
 {
@@ -33,6 +38,20 @@ public:
 
   using WorkItemPtr = std::unique_ptr<WorkItem>;
 
+  // Time from queueing to completion of work items, bucketed by powers of two.
+  // Bucket i counts items which completed in less than 2^i milliseconds, with the last bucket
+  // also counting everything slower than that.
+  struct LatencyHistogram
+  {
+    static constexpr size_t NUM_BUCKETS = 12;
+
+    std::array<u64, NUM_BUCKETS> buckets{};
+    u64 count = 0;
+
+    // Returns the upper bound in milliseconds of the bucket containing the given percentile.
+    u32 GetPercentileUpperBound(u32 percent) const;
+  };
+
   AsyncShaderCompiler();
   virtual ~AsyncShaderCompiler();
 
@@ -49,6 +68,15 @@ public:
   bool HasPendingWork();
   bool HasCompletedWork();
 
+  // Work items with a priority value of at least background_priority are background work.
+  // When more than one worker thread is running, background work is never allowed to occupy all
+  // of them, so that newly queued urgent work can start immediately. Within that limit, the number
+  // of workers running background work follows the number of idle cores on the host.
+  void SetBackgroundPriority(u32 background_priority);
+
+  // Returns the latency histogram for urgent or background work items, and optionally resets it.
+  LatencyHistogram GetLatencyHistogram(bool background, bool reset = false);
+
   // Calls progress_callback periodically, with completed_items, and total_items.
   // Returns false if interrupted.
   bool WaitUntilCompletion(const std::function<void(size_t, size_t)>& progress_callback);
@@ -65,22 +93,44 @@ protected:
   virtual void WorkerThreadExit(void* param);
 
 private:
+  using Clock = std::chrono::steady_clock;
+
+  struct PendingWorkItem
+  {
+    WorkItemPtr item;
+    Clock::time_point queue_time;
+  };
+
   void WorkerThreadEntryPoint(void* param);
   void WorkerThreadRun();
+  bool CanStartBackgroundWork();
+  void UpdateBackgroundWorkerLimit(size_t max_background_workers);
+  void RecordLatency(bool background, Clock::duration latency);
 
   Common::Flag m_exit_flag;
   Common::Event m_init_event;
 
   std::vector<std::thread> m_worker_threads;
+  std::atomic_size_t m_num_worker_threads{0};
   std::atomic_bool m_worker_thread_start_result{false};
 
   // A multimap is used to store the work items. We can't use a priority_queue here, because
   // there's no way to obtain a non-const reference, which we need for the unique_ptr.
-  std::multimap<u32, WorkItemPtr> m_pending_work;
+  // Items with the same priority are kept in the order they were queued.
+  std::multimap<u32, PendingWorkItem> m_pending_work;
   std::mutex m_pending_work_lock;
   std::condition_variable m_worker_thread_wake;
   std::atomic_size_t m_busy_workers{0};
 
+  // Protected by m_pending_work_lock.
+  u32 m_background_priority = std::numeric_limits<u32>::max();
+  size_t m_busy_background_workers = 0;
+  size_t m_background_worker_limit = std::numeric_limits<size_t>::max();
+  Clock::time_point m_last_cpu_sample_time;
+  std::optional<Common::SystemCPUTimes> m_last_cpu_times;
+  LatencyHistogram m_urgent_latency;
+  LatencyHistogram m_background_latency;
+
   std::deque<WorkItemPtr> m_completed_work;
   std::mutex m_completed_work_lock;
 };
@@ -3,6 +3,8 @@
 
 #include "VideoCommon/ShaderCache.h"
 
+#include <limits>
+
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
@@ -67,12 +69,14 @@ void ShaderCache::InitializeShaderCache()
     QueueUberShaderPipelines();
 
   // Compile all known UIDs.
+  SetBackgroundCompilePriority();
   CompileMissingPipelines();
   if (g_ActiveConfig.bWaitForShadersBeforeStarting)
     WaitForAsyncCompiler();
 
   // Switch to the runtime shader compiler thread configuration.
   m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads());
+  m_async_shader_compiler->SetBackgroundPriority(COMPILE_PRIORITY_UBERSHADER_PIPELINE);
 }
 
 void ShaderCache::Reload()
@@ -93,15 +97,41 @@ void ShaderCache::Reload()
   // We don't need to explicitly recompile the individual ubershaders here, as the pipelines
   // UIDs are still be in the map. Therefore, when these are rebuilt, the shaders will also
   // be recompiled.
+  SetBackgroundCompilePriority();
   CompileMissingPipelines();
   if (g_ActiveConfig.bWaitForShadersBeforeStarting)
     WaitForAsyncCompiler();
   m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads());
+  m_async_shader_compiler->SetBackgroundPriority(COMPILE_PRIORITY_UBERSHADER_PIPELINE);
+}
+
+void ShaderCache::SetBackgroundCompilePriority()
+{
+  // While the user is waiting for the precompile, all workers should be working on it. Otherwise,
+  // keep a worker free for on-demand pipelines, so they don't wait behind the precompile.
+  if (g_ActiveConfig.bWaitForShadersBeforeStarting)
+    m_async_shader_compiler->SetBackgroundPriority(std::numeric_limits<u32>::max());
+  else
+    m_async_shader_compiler->SetBackgroundPriority(COMPILE_PRIORITY_UBERSHADER_PIPELINE);
 }
 
 void ShaderCache::RetrieveAsyncShaders()
 {
   m_async_shader_compiler->RetrieveWorkItems();
+
+  if (g_ActiveConfig.bOverlayStats)
+  {
+    for (const bool background : {false, true})
+    {
+      const AsyncShaderCompiler::LatencyHistogram histogram =
+          m_async_shader_compiler->GetLatencyHistogram(background);
+      g_stats.shader_compile_latency[background] = {
+          .count = histogram.count,
+          .median_ms = histogram.GetPercentileUpperBound(50),
+          .p90_ms = histogram.GetPercentileUpperBound(90),
+      };
+    }
+  }
 }
 
 void ShaderCache::Shutdown()
@@ -138,8 +168,15 @@ std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const
     // .second is the pending flag, i.e. compiling in the background.
     if (!it->second.second)
       return it->second.first.get();
-    else
-      return {};
+
+    // Still compiling. If it's queued as background work, e.g. from the UID cache, bump it ahead.
+    auto pending_it = m_gx_pipeline_pending_compiles.find(uid);
+    if (pending_it != m_gx_pipeline_pending_compiles.end() &&
+        pending_it->second.priority > COMPILE_PRIORITY_ONDEMAND_PIPELINE)
+    {
+      QueuePipelineCompile(uid, COMPILE_PRIORITY_ONDEMAND_PIPELINE);
+    }
+    return {};
   }
 
   AppendGXPipelineUID(uid);
@@ -275,6 +312,66 @@ void ShaderCache::ClearShaderCache(T& cache)
   cache.shader_map.clear();
 }
 
+template <ShaderStage stage, typename K, typename T, typename S>
+void ShaderCache::LoadShaderSourceCache(T& cache, S& source_cache, APIType api_type,
+                                        const char* type)
+{
+  class CacheReader : public Common::LinearDiskCacheReader<K, char>
+  {
+  public:
+    CacheReader(T& cache_) : cache(cache_) {}
+    void Read(const K& key, const char* value, u32 value_size) override
+    {
+      auto shader = g_gfx->CreateShaderFromSource(stage, std::string_view(value, value_size));
+      if (shader)
+      {
+        auto& entry = cache.shader_map[key];
+        entry.shader = std::move(shader);
+        entry.pending = false;
+
+        if constexpr (stage == ShaderStage::Vertex)
+        {
+          INCSTAT(g_stats.num_vertex_shaders_created);
+          INCSTAT(g_stats.num_vertex_shaders_alive);
+        }
+        else
+        {
+          INCSTAT(g_stats.num_pixel_shaders_created);
+          INCSTAT(g_stats.num_pixel_shaders_alive);
+        }
+      }
+    }
+
+  private:
+    T& cache;
+  };
+
+  std::lock_guard guard(source_cache.lock);
+  std::string filename = GetDiskShaderCacheFileName(api_type, type, true, true);
+  CacheReader reader(cache);
+  u32 count = source_cache.disk_cache.OpenAndRead(filename, reader);
+  INFO_LOG_FMT(VIDEO, "Loaded {} cached shader sources from {}", count, filename);
+}
+
+template <typename S>
+void ShaderCache::ClearShaderSourceCache(S& source_cache)
+{
+  std::lock_guard guard(source_cache.lock);
+  source_cache.disk_cache.Sync();
+  source_cache.disk_cache.Close();
+}
+
+template <typename S, typename K>
+void ShaderCache::AppendShaderSource(S& source_cache, const K& uid, std::string_view source)
+{
+  // Backends that support shader binaries cache the compiled shader instead.
+  if (!g_ActiveConfig.bShaderCache || g_ActiveConfig.backend_info.bSupportsShaderBinaries)
+    return;
+
+  std::lock_guard guard(source_cache.lock);
+  source_cache.disk_cache.Append(uid, source.data(), static_cast<u32>(source.size()));
+}
+
 template <typename KeyType, typename DiskKeyType, typename T>
 void ShaderCache::LoadPipelineCache(T& cache, Common::LinearDiskCache<DiskKeyType, u8>& disk_cache,
                                     APIType api_type, const char* type, bool include_gameid)
@@ -370,6 +467,14 @@ void ShaderCache::LoadCaches()
     LoadShaderCache<ShaderStage::Pixel, PixelShaderUid>(m_ps_cache, m_api_type, "specialized-ps",
                                                         true);
   }
+  else
+  {
+    // Without binaries, the best we can do is create the shaders from their saved source.
+    LoadShaderSourceCache<ShaderStage::Vertex, VertexShaderUid>(
+        m_vs_cache, m_vs_source_cache, m_api_type, "specialized-vs-source");
+    LoadShaderSourceCache<ShaderStage::Pixel, PixelShaderUid>(
+        m_ps_cache, m_ps_source_cache, m_api_type, "specialized-ps-source");
+  }
 
   if (g_ActiveConfig.backend_info.bSupportsPipelineCacheData)
   {
@@ -384,6 +489,7 @@ void ShaderCache::LoadCaches()
 void ShaderCache::ClearCaches()
 {
   ClearPipelineCache(m_gx_pipeline_cache, m_gx_pipeline_disk_cache);
+  m_gx_pipeline_pending_compiles.clear();
   ClearShaderCache(m_vs_cache);
   ClearShaderCache(m_gs_cache);
   ClearShaderCache(m_ps_cache);
@@ -391,6 +497,8 @@ void ShaderCache::ClearCaches()
   ClearPipelineCache(m_gx_uber_pipeline_cache, m_gx_uber_pipeline_disk_cache);
   ClearShaderCache(m_uber_vs_cache);
   ClearShaderCache(m_uber_ps_cache);
+  ClearShaderSourceCache(m_vs_source_cache);
+  ClearShaderSourceCache(m_ps_source_cache);
 
   m_screen_quad_vertex_shader.reset();
   m_texture_copy_vertex_shader.reset();
@@ -430,10 +538,11 @@ void ShaderCache::CompileMissingPipelines()
   }
 }
 
-std::unique_ptr<AbstractShader> ShaderCache::CompileVertexShader(const VertexShaderUid& uid) const
+std::unique_ptr<AbstractShader> ShaderCache::CompileVertexShader(const VertexShaderUid& uid)
 {
   const ShaderCode source_code =
       GenerateVertexShaderCode(m_api_type, m_host_config, uid.GetUidData());
+  AppendShaderSource(m_vs_source_cache, uid, source_code.GetBuffer());
   return g_gfx->CreateShaderFromSource(ShaderStage::Vertex, source_code.GetBuffer());
 }
 
@@ -446,10 +555,11 @@ ShaderCache::CompileVertexUberShader(const UberShader::VertexShaderUid& uid) con
                                        fmt::to_string(*uid.GetUidData()));
 }
 
-std::unique_ptr<AbstractShader> ShaderCache::CompilePixelShader(const PixelShaderUid& uid) const
+std::unique_ptr<AbstractShader> ShaderCache::CompilePixelShader(const PixelShaderUid& uid)
 {
   const ShaderCode source_code =
       GeneratePixelShaderCode(m_api_type, m_host_config, uid.GetUidData(), {});
+  AppendShaderSource(m_ps_source_cache, uid, source_code.GetBuffer());
   return g_gfx->CreateShaderFromSource(ShaderStage::Pixel, source_code.GetBuffer());
 }
 
@@ -467,6 +577,7 @@ const AbstractShader* ShaderCache::InsertVertexShader(const VertexShaderUid& uid
 {
   auto& entry = m_vs_cache.shader_map[uid];
   entry.pending = false;
+  entry.pending_compile = {};
 
   if (shader && !entry.shader)
   {
@@ -511,6 +622,7 @@ const AbstractShader* ShaderCache::InsertPixelShader(const PixelShaderUid& uid,
 {
   auto& entry = m_ps_cache.shader_map[uid];
   entry.pending = false;
+  entry.pending_compile = {};
 
   if (shader && !entry.shader)
   {
@@ -874,6 +986,7 @@ const AbstractPipeline* ShaderCache::InsertGXPipeline(const GXPipelineUid& confi
 {
   auto& entry = m_gx_pipeline_cache[config];
   entry.second = false;
+  m_gx_pipeline_pending_compiles.erase(config);
   if (!entry.first && pipeline)
   {
     entry.first = std::move(pipeline);
@@ -1027,18 +1140,42 @@ void ShaderCache::AppendGXPipelineUID(const GXPipelineUid& config)
   }
 }
 
+std::shared_ptr<std::atomic_bool> ShaderCache::QueuePendingCompile(PendingCompile& pending,
+                                                                  u32 priority)
+{
+  if (!pending.claimed)
+    pending.claimed = std::make_shared<std::atomic_bool>(false);
+  pending.priority = priority;
+  return pending.claimed;
+}
+
+// Returns true if the shader needs to be queued at the specified priority, either because it
+// hasn't been queued yet, or because it's still waiting behind less urgent work.
+template <typename T>
+static bool ShouldQueueShaderCompile(const T& shader_map, const typename T::const_iterator& iter,
+                                     u32 priority)
+{
+  return iter == shader_map.end() ||
+         (iter->second.pending && iter->second.pending_compile.priority > priority);
+}
+
 void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority)
 {
   class VertexShaderWorkItem final : public AsyncShaderCompiler::WorkItem
   {
   public:
-    VertexShaderWorkItem(ShaderCache* shader_cache_, const VertexShaderUid& uid_)
-        : shader_cache(shader_cache_), uid(uid_)
+    VertexShaderWorkItem(ShaderCache* shader_cache_, const VertexShaderUid& uid_,
+                         std::shared_ptr<std::atomic_bool> claimed_)
+        : shader_cache(shader_cache_), uid(uid_), claimed(std::move(claimed_))
     {
     }
 
     bool Compile() override
     {
+      // Skip if another work item for this shader got there first.
+      if (claimed->exchange(true))
+        return false;
+
       shader = shader_cache->CompileVertexShader(uid);
       return true;
     }
@@ -1049,10 +1186,13 @@ void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 prior
     ShaderCache* shader_cache;
     std::unique_ptr<AbstractShader> shader;
     VertexShaderUid uid;
+    std::shared_ptr<std::atomic_bool> claimed;
   };
 
-  m_vs_cache.shader_map[uid].pending = true;
-  auto wi = m_async_shader_compiler->CreateWorkItem<VertexShaderWorkItem>(this, uid);
+  auto& entry = m_vs_cache.shader_map[uid];
+  entry.pending = true;
+  auto wi = m_async_shader_compiler->CreateWorkItem<VertexShaderWorkItem>(
+      this, uid, QueuePendingCompile(entry.pending_compile, priority));
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
 }
 
@@ -1090,13 +1230,17 @@ void ShaderCache::QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priorit
   class PixelShaderWorkItem final : public AsyncShaderCompiler::WorkItem
   {
   public:
-    PixelShaderWorkItem(ShaderCache* shader_cache_, const PixelShaderUid& uid_)
-        : shader_cache(shader_cache_), uid(uid_)
+    PixelShaderWorkItem(ShaderCache* shader_cache_, const PixelShaderUid& uid_,
+                        std::shared_ptr<std::atomic_bool> claimed_)
+        : shader_cache(shader_cache_), uid(uid_), claimed(std::move(claimed_))
     {
     }
 
     bool Compile() override
     {
+      if (claimed->exchange(true))
+        return false;
+
       shader = shader_cache->CompilePixelShader(uid);
       return true;
     }
@@ -1107,10 +1251,13 @@ void ShaderCache::QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priorit
     ShaderCache* shader_cache;
     std::unique_ptr<AbstractShader> shader;
     PixelShaderUid uid;
+    std::shared_ptr<std::atomic_bool> claimed;
   };
 
-  m_ps_cache.shader_map[uid].pending = true;
-  auto wi = m_async_shader_compiler->CreateWorkItem<PixelShaderWorkItem>(this, uid);
+  auto& entry = m_ps_cache.shader_map[uid];
+  entry.pending = true;
+  auto wi = m_async_shader_compiler->CreateWorkItem<PixelShaderWorkItem>(
+      this, uid, QueuePendingCompile(entry.pending_compile, priority));
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
 }
 
@@ -1148,8 +1295,9 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
   class PipelineWorkItem final : public AsyncShaderCompiler::WorkItem
   {
   public:
-    PipelineWorkItem(ShaderCache* shader_cache_, const GXPipelineUid& uid_, u32 priority_)
-        : shader_cache(shader_cache_), uid(uid_), priority(priority_)
+    PipelineWorkItem(ShaderCache* shader_cache_, const GXPipelineUid& uid_, u32 priority_,
+                     std::shared_ptr<std::atomic_bool> claimed_)
+        : shader_cache(shader_cache_), uid(uid_), priority(priority_), claimed(std::move(claimed_))
     {
       // Check if all the stages required for this pipeline have been compiled.
       // If not, this work item becomes a no-op, and re-queues the pipeline for the next frame.
@@ -1165,7 +1313,7 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
 
       auto vs_it = shader_cache->m_vs_cache.shader_map.find(actual_uid.vs_uid);
       stages_ready &= vs_it != shader_cache->m_vs_cache.shader_map.end() && !vs_it->second.pending;
-      if (vs_it == shader_cache->m_vs_cache.shader_map.end())
+      if (ShouldQueueShaderCompile(shader_cache->m_vs_cache.shader_map, vs_it, priority))
         shader_cache->QueueVertexShaderCompile(actual_uid.vs_uid, priority);
 
       PixelShaderUid ps_uid = actual_uid.ps_uid;
@@ -1173,7 +1321,7 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
 
       auto ps_it = shader_cache->m_ps_cache.shader_map.find(ps_uid);
       stages_ready &= ps_it != shader_cache->m_ps_cache.shader_map.end() && !ps_it->second.pending;
-      if (ps_it == shader_cache->m_ps_cache.shader_map.end())
+      if (ShouldQueueShaderCompile(shader_cache->m_ps_cache.shader_map, ps_it, priority))
         shader_cache->QueuePixelShaderCompile(ps_uid, priority);
 
       return stages_ready;
@@ -1182,7 +1330,12 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
     bool Compile() override
     {
       if (config)
+      {
+        if (claimed->exchange(true))
+          return false;
+
         pipeline = g_gfx->CreatePipeline(*config);
+      }
       return true;
     }
 
@@ -1196,7 +1349,7 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
       {
         // Re-queue for next frame.
         auto wi = shader_cache->m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(
-            shader_cache, uid, priority);
+            shader_cache, uid, priority, claimed);
         shader_cache->m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
       }
     }
@@ -1206,11 +1359,13 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
     std::unique_ptr<AbstractPipeline> pipeline;
     GXPipelineUid uid;
     u32 priority;
+    std::shared_ptr<std::atomic_bool> claimed;
     std::optional<AbstractPipelineConfig> config;
     bool stages_ready;
   };
 
-  auto wi = m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(this, uid, priority);
+  auto wi = m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(
+      this, uid, priority, QueuePendingCompile(m_gx_pipeline_pending_compiles[uid], priority));
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
   m_gx_pipeline_cache[uid].second = true;
 }
@@ -4,12 +4,15 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstring>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 
@@ -124,13 +127,14 @@ private:
   void ClosePipelineUIDCache();
   void CompileMissingPipelines();
   void QueueUberShaderPipelines();
+  void SetBackgroundCompilePriority();
   bool CompileSharedPipelines();
 
   // GX shader compiler methods
-  std::unique_ptr<AbstractShader> CompileVertexShader(const VertexShaderUid& uid) const;
+  std::unique_ptr<AbstractShader> CompileVertexShader(const VertexShaderUid& uid);
   std::unique_ptr<AbstractShader>
   CompileVertexUberShader(const UberShader::VertexShaderUid& uid) const;
-  std::unique_ptr<AbstractShader> CompilePixelShader(const PixelShaderUid& uid) const;
+  std::unique_ptr<AbstractShader> CompilePixelShader(const PixelShaderUid& uid);
   std::unique_ptr<AbstractShader>
   CompilePixelUberShader(const UberShader::PixelShaderUid& uid) const;
   const AbstractShader* InsertVertexShader(const VertexShaderUid& uid,
@@ -175,6 +179,12 @@ private:
   void LoadShaderCache(T& cache, APIType api_type, const char* type, bool include_gameid);
   template <typename T>
   void ClearShaderCache(T& cache);
+  template <ShaderStage stage, typename K, typename T, typename S>
+  void LoadShaderSourceCache(T& cache, S& source_cache, APIType api_type, const char* type);
+  template <typename S>
+  void ClearShaderSourceCache(S& source_cache);
+  template <typename S, typename K>
+  void AppendShaderSource(S& source_cache, const K& uid, std::string_view source);
   template <typename KeyType, typename DiskKeyType, typename T>
   void LoadPipelineCache(T& cache, Common::LinearDiskCache<DiskKeyType, u8>& disk_cache,
                          APIType api_type, const char* type, bool include_gameid);
@@ -192,6 +202,18 @@ private:
     COMPILE_PRIORITY_SHADERCACHE_PIPELINE = 300
   };
 
+  // Bookkeeping for a queued compile. If something more urgent needs the same shader or pipeline
+  // while it's still waiting behind background work, it is queued again at the higher priority.
+  // All work items for the same compile share the claimed flag, and only the first to start does
+  // the actual work.
+  struct PendingCompile
+  {
+    u32 priority = 0;
+    std::shared_ptr<std::atomic_bool> claimed;
+  };
+  static std::shared_ptr<std::atomic_bool> QueuePendingCompile(PendingCompile& pending,
+                                                               u32 priority);
+
   // Configuration bits.
   APIType m_api_type;
   ShaderHostConfig m_host_config = {};
@@ -214,6 +236,7 @@ private:
     {
       std::unique_ptr<AbstractShader> shader;
       bool pending = false;
+      PendingCompile pending_compile;
     };
     std::map<Uid, Shader> shader_map;
     Common::LinearDiskCache<Uid, u8> disk_cache;
@@ -224,10 +247,23 @@ private:
   ShaderModuleCache<UberShader::VertexShaderUid> m_uber_vs_cache;
   ShaderModuleCache<UberShader::PixelShaderUid> m_uber_ps_cache;
 
+  // Generated source of specialized shaders, for backends that can't cache shader binaries. It is
+  // only appended to while running. At boot, the shaders are created from it without going
+  // through ShaderGen.
+  template <typename Uid>
+  struct ShaderSourceCache
+  {
+    Common::LinearDiskCache<Uid, char> disk_cache;
+    std::mutex lock;
+  };
+  ShaderSourceCache<VertexShaderUid> m_vs_source_cache;
+  ShaderSourceCache<PixelShaderUid> m_ps_source_cache;
+
   // GX Pipeline Caches - .first - pipeline, .second - pending
   std::map<GXPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>> m_gx_pipeline_cache;
   std::map<GXUberPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>>
       m_gx_uber_pipeline_cache;
+  std::map<GXPipelineUid, PendingCompile> m_gx_pipeline_pending_compiles;
   File::IOFile m_gx_pipeline_uid_cache_file;
   Common::LinearDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache;
   Common::LinearDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache;
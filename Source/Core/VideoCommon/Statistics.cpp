@@ -3,6 +3,7 @@
 
 #include "VideoCommon/Statistics.h"
 
+#include <cinttypes>
 #include <cstring>
 #include <utility>
 
@@ -114,6 +115,13 @@ void Statistics::Display() const
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
   draw_statistic("Draw dones:", "%d", this_frame.num_draw_done);
   draw_statistic("Tokens:", "%d/%d", this_frame.num_token, this_frame.num_token_int);
+  for (const bool background : {false, true})
+  {
+    const ShaderCompileLatency& latency = shader_compile_latency[background];
+    draw_statistic(background ? "Background compiles" : "On-demand compiles",
+                   "%" PRIu64 " (p50 <%ums, p90 <%ums)", latency.count, latency.median_ms,
+                   latency.p90_ms);
+  }
 
   ImGui::Columns(1);
 
@@ -6,6 +6,7 @@
 #include <array>
 #include <vector>
 
+#include "Common/CommonTypes.h"
 #include "VideoCommon/BPFunctions.h"
 
 struct Statistics
@@ -21,6 +22,16 @@ struct Statistics
 
   int num_vertex_loaders = 0;
 
+  // Time from queueing to completion of asynchronous shader compiles. The percentiles are upper
+  // bounds in milliseconds. Index 0 is for on-demand work, index 1 for background work.
+  struct ShaderCompileLatency
+  {
+    u64 count = 0;
+    u32 median_ms = 0;
+    u32 p90_ms = 0;
+  };
+  std::array<ShaderCompileLatency, 2> shader_compile_latency{};
+
   std::array<float, 6> proj{};
   std::array<float, 16> gproj{};
   std::array<float, 16> g2proj{};
@@ -0,0 +1,105 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+
+namespace
+{
+struct TestState
+{
+  std::vector<u32> values;
+  std::string name;
+  std::map<u32, std::string> map;
+  std::set<u16> set;
+
+  void DoState(PointerWrap& p)
+  {
+    p.Do(values);
+    p.Do(name);
+    p.Do(map);
+    p.Do(set);
+    p.DoMarker("TestState");
+  }
+};
+
+TestState MakeState()
+{
+  TestState state;
+  for (u32 i = 0; i < 1000; ++i)
+    state.values.push_back(i * 3);
+  state.name = "test state";
+  for (u32 i = 0; i < 100; ++i)
+    state.map.emplace(i * 5, std::string(i % 7, 'a'));
+  for (u16 i = 0; i < 100; ++i)
+    state.set.insert(i * 11);
+  return state;
+}
+
+size_t Measure(TestState& state)
+{
+  u8* ptr = nullptr;
+  PointerWrap p(&ptr, 0, PointerWrap::Mode::Measure);
+  state.DoState(p);
+  return reinterpret_cast<size_t>(ptr);
+}
+}  // namespace
+
+TEST(ChunkFile, RoundTrip)
+{
+  TestState state = MakeState();
+  std::vector<u8> buffer(Measure(state));
+  u8* ptr = buffer.data();
+  PointerWrap p_write(&ptr, buffer.size(), PointerWrap::Mode::Write);
+  state.DoState(p_write);
+  ASSERT_TRUE(p_write.IsWriteMode());
+  EXPECT_EQ(ptr, buffer.data() + buffer.size());
+
+  TestState loaded;
+  loaded.map.emplace(1, "stale");
+  ptr = buffer.data();
+  PointerWrap p_read(&ptr, buffer.size(), PointerWrap::Mode::Read);
+  loaded.DoState(p_read);
+  ASSERT_TRUE(p_read.IsReadMode());
+
+  EXPECT_EQ(loaded.values, state.values);
+  EXPECT_EQ(loaded.name, state.name);
+  EXPECT_EQ(loaded.map, state.map);
+  EXPECT_EQ(loaded.set, state.set);
+}
+
+// State::SaveStateToBuffer relies on this to save in a single pass most of the time
+TEST(ChunkFile, WriteIntoTooSmallBufferMeasures)
+{
+  TestState state = MakeState();
+  const size_t size = Measure(state);
+
+  std::vector<u8> buffer(size / 2);
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Write);
+  state.DoState(p);
+
+  EXPECT_TRUE(p.IsMeasureMode());
+  EXPECT_EQ(static_cast<size_t>(ptr - buffer.data()), size);
+}
+
+TEST(ChunkFile, WriteIntoLargerBuffer)
+{
+  TestState state = MakeState();
+  const size_t size = Measure(state);
+
+  std::vector<u8> buffer(size + size / 16);
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Write);
+  state.DoState(p);
+
+  EXPECT_TRUE(p.IsWriteMode());
+  EXPECT_EQ(static_cast<size_t>(ptr - buffer.data()), size);
+}
@@ -0,0 +1,66 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/MPSCQueue.h"
+
+TEST(MPSCQueue, Simple)
+{
+  Common::MPSCQueue<u32> q;
+  EXPECT_TRUE(q.Empty());
+
+  // Test the FIFO order.
+  for (u32 i = 0; i < 1000; ++i)
+    q.Push(i);
+  EXPECT_FALSE(q.Empty());
+
+  u32 expected = 0;
+  q.PopAll([&](u32 v) { EXPECT_EQ(expected++, v); });
+  EXPECT_EQ(1000u, expected);
+  EXPECT_TRUE(q.Empty());
+
+  q.PopAll([](u32) { FAIL(); });
+
+  for (u32 i = 0; i < 1000; ++i)
+    q.Push(i);
+  q.Clear();
+  EXPECT_TRUE(q.Empty());
+}
+
+TEST(MPSCQueue, MultiThreaded)
+{
+  constexpr u32 NUM_PRODUCERS = 4;
+  constexpr u32 NUM_ELEMENTS = 100000;
+
+  Common::MPSCQueue<u32> q;
+
+  std::vector<std::thread> producers;
+  for (u32 producer = 0; producer < NUM_PRODUCERS; ++producer)
+  {
+    producers.emplace_back([&q, producer] {
+      for (u32 i = 0; i < NUM_ELEMENTS; ++i)
+        q.Push(producer * NUM_ELEMENTS + i);
+    });
+  }
+
+  // Elements from each producer must arrive in the order that producer pushed them
+  std::vector<u32> next(NUM_PRODUCERS, 0);
+  u32 received = 0;
+  while (received < NUM_PRODUCERS * NUM_ELEMENTS)
+  {
+    q.PopAll([&](u32 v) {
+      const u32 producer = v / NUM_ELEMENTS;
+      EXPECT_EQ(next[producer]++, v % NUM_ELEMENTS);
+      ++received;
+    });
+  }
+
+  for (std::thread& producer : producers)
+    producer.join();
+
+  EXPECT_TRUE(q.Empty());
+}
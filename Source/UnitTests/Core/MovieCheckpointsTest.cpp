@@ -0,0 +1,165 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Core/MovieCheckpoints.h"
+
+namespace
+{
+std::vector<u8> MakeState(u64 frame)
+{
+  std::vector<u8> state(0x10000 + frame * 0x100);
+  for (size_t i = 0; i < state.size(); ++i)
+    state[i] = static_cast<u8>(i * 31 + frame);
+  return state;
+}
+}  // namespace
+
+class MovieCheckpointsTest : public testing::Test
+{
+protected:
+  MovieCheckpointsTest()
+      : m_directory(File::CreateTempDir()), m_path(m_directory + "/movie.dtm.idx")
+  {
+  }
+
+  ~MovieCheckpointsTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_directory.empty())
+      FAIL();
+  }
+
+  const std::string m_directory;
+  const std::string m_path;
+};
+
+TEST_F(MovieCheckpointsTest, FindsLatestCheckpointAtOrBeforeFrame)
+{
+  Movie::CheckpointFile file;
+  ASSERT_TRUE(file.Create(m_path));
+
+  for (u64 frame = 100; frame <= 500; frame += 100)
+    ASSERT_TRUE(file.Add(frame, MakeState(frame)));
+
+  EXPECT_FALSE(file.FindLatestAtOrBefore(99));
+
+  const auto checkpoint = file.FindLatestAtOrBefore(350);
+  ASSERT_TRUE(checkpoint);
+  EXPECT_EQ(checkpoint->frame, 300u);
+
+  std::vector<u8> state;
+  ASSERT_TRUE(file.Load(*checkpoint, &state));
+  EXPECT_EQ(state, MakeState(300));
+
+  EXPECT_EQ(file.FindLatestAtOrBefore(500)->frame, 500u);
+  EXPECT_EQ(file.FindLatestAtOrBefore(100000)->frame, 500u);
+}
+
+TEST_F(MovieCheckpointsTest, OnlyAppendsNewerFrames)
+{
+  Movie::CheckpointFile file;
+  ASSERT_TRUE(file.Create(m_path));
+
+  ASSERT_TRUE(file.Add(200, MakeState(200)));
+  EXPECT_FALSE(file.Add(200, MakeState(201)));
+  EXPECT_FALSE(file.Add(100, MakeState(100)));
+  EXPECT_EQ(file.GetCount(), 1u);
+  EXPECT_EQ(file.GetLastFrame(), 200u);
+}
+
+TEST_F(MovieCheckpointsTest, ReopensExistingFile)
+{
+  {
+    Movie::CheckpointFile file;
+    ASSERT_TRUE(file.Create(m_path));
+    for (u64 frame = 60; frame <= 300; frame += 60)
+      ASSERT_TRUE(file.Add(frame, MakeState(frame)));
+  }
+
+  Movie::CheckpointFile file;
+  ASSERT_TRUE(file.Open(m_path, false));
+  EXPECT_EQ(file.GetCount(), 5u);
+
+  std::vector<u8> state;
+  ASSERT_TRUE(file.Load(*file.FindLatestAtOrBefore(200), &state));
+  EXPECT_EQ(state, MakeState(180));
+
+  ASSERT_TRUE(file.Add(360, MakeState(360)));
+  ASSERT_TRUE(file.Load(*file.FindLatestAtOrBefore(360), &state));
+  EXPECT_EQ(state, MakeState(360));
+}
+
+TEST_F(MovieCheckpointsTest, DropsIncompleteCheckpoint)
+{
+  {
+    Movie::CheckpointFile file;
+    ASSERT_TRUE(file.Create(m_path));
+    ASSERT_TRUE(file.Add(10, MakeState(10)));
+    ASSERT_TRUE(file.Add(20, MakeState(20)));
+  }
+
+  // Simulate a crash in the middle of writing the second checkpoint
+  {
+    File::IOFile raw(m_path, "r+b");
+    ASSERT_TRUE(raw.Resize(raw.GetSize() - 10));
+  }
+
+  Movie::CheckpointFile file;
+  ASSERT_TRUE(file.Open(m_path, false));
+  EXPECT_EQ(file.GetCount(), 1u);
+  EXPECT_EQ(file.GetLastFrame(), 10u);
+
+  ASSERT_TRUE(file.Add(30, MakeState(30)));
+  std::vector<u8> state;
+  ASSERT_TRUE(file.Load(*file.FindLatestAtOrBefore(30), &state));
+  EXPECT_EQ(state, MakeState(30));
+}
+
+TEST_F(MovieCheckpointsTest, DiscardAfter)
+{
+  Movie::CheckpointFile file;
+  ASSERT_TRUE(file.Create(m_path));
+  for (u64 frame = 1; frame <= 5; ++frame)
+    ASSERT_TRUE(file.Add(frame, MakeState(frame)));
+
+  file.DiscardAfter(2);
+  EXPECT_EQ(file.GetLastFrame(), 2u);
+
+  // Frames after the discarded ones can be recorded again
+  ASSERT_TRUE(file.Add(3, MakeState(33)));
+  file.Close();
+
+  ASSERT_TRUE(file.Open(m_path, false));
+  EXPECT_EQ(file.GetCount(), 3u);
+  std::vector<u8> state;
+  ASSERT_TRUE(file.Load(*file.FindLatestAtOrBefore(4), &state));
+  EXPECT_EQ(state, MakeState(33));
+}
+
+TEST_F(MovieCheckpointsTest, RejectsOtherFiles)
+{
+  {
+    File::IOFile raw(m_path, "wb");
+    ASSERT_TRUE(raw.WriteString("not a checkpoint file"));
+  }
+
+  Movie::CheckpointFile file;
+  EXPECT_FALSE(file.Open(m_path, false));
+  EXPECT_FALSE(file.IsOpen());
+
+  ASSERT_TRUE(file.Open(m_path, true));
+  EXPECT_EQ(file.GetCount(), 0u);
+}
@@ -0,0 +1,153 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/HW/Wiimote.h"
+#include "Core/HW/WiimoteEmu/WiimoteEmu.h"
+#include "Core/Movie.h"
+#include "Core/MovieCheckpoints.h"
+#include "Core/System.h"
+#include "InputCommon/InputConfig.h"
+#include "UICommon/UICommon.h"
+
+namespace
+{
+constexpr u64 MOVIE_ID = 0x0123456789abcdef;
+constexpr u64 CHECKPOINT_FRAME = 120;
+
+std::vector<u8> MakeState()
+{
+  std::vector<u8> state(0x8000);
+  for (size_t i = 0; i < state.size(); ++i)
+    state[i] = static_cast<u8>(i * 7);
+  return state;
+}
+
+std::optional<Movie::DTMHeader> ReadHeader(const std::string& path)
+{
+  Movie::DTMHeader header;
+  File::IOFile file(path, "rb");
+  if (!file.ReadArray(&header, 1))
+    return std::nullopt;
+  return header;
+}
+}  // namespace
+
+class MovieTest : public testing::Test
+{
+protected:
+  MovieTest() : m_directory(File::CreateTempDir()) {}
+
+  ~MovieTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    ASSERT_FALSE(m_directory.empty());
+
+    UICommon::SetUserDirectory(m_directory);
+    Config::Init();
+    SConfig::Init();
+    Config::SetCurrent(Config::MAIN_MOVIE_CHECKPOINT_INTERVAL, 60);
+
+    // Starting playback resets the emulated Wii Remotes
+    InputConfig* wiimote_config = Wiimote::GetConfig();
+    for (int i = 0; i < MAX_BBMOTES; ++i)
+      wiimote_config->CreateController<WiimoteEmu::Wiimote>(i);
+  }
+
+  void TearDown() override
+  {
+    Core::System::GetInstance().GetMovie().Shutdown();
+    Wiimote::GetConfig()->ClearControllers();
+    SConfig::Shutdown();
+    Config::Shutdown();
+  }
+
+  std::string GetPath(const std::string& name) const { return m_directory + "/" + name; }
+
+  // A movie of 300 frames that was recorded with a GameCube controller in port 1, along with a
+  // checkpoint file that has one checkpoint
+  void WriteMovie(const std::string& path) const
+  {
+    Movie::DTMHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.filetype = {'D', 'T', 'M', 0x1A};
+    header.controllers = 1;
+    header.frameCount = 300;
+    header.inputCount = 300;
+    header.uniqueID = MOVIE_ID;
+    header.bSaveConfig = true;
+
+    const std::vector<u8> input(300 * 8);
+    File::IOFile file(path, "wb");
+    ASSERT_TRUE(file.WriteArray(&header, 1));
+    ASSERT_TRUE(file.WriteBytes(input.data(), input.size()));
+
+    Movie::CheckpointFile checkpoints;
+    ASSERT_TRUE(checkpoints.Create(path + ".idx", MOVIE_ID));
+    ASSERT_TRUE(checkpoints.Add(CHECKPOINT_FRAME, MakeState()));
+  }
+
+  static void ExpectCheckpoint(const std::string& movie_path)
+  {
+    Movie::CheckpointFile checkpoints;
+    ASSERT_TRUE(checkpoints.Open(movie_path + ".idx", MOVIE_ID, false));
+    ASSERT_EQ(checkpoints.GetCount(), 1u);
+
+    const auto checkpoint = checkpoints.FindLatestAtOrBefore(200);
+    ASSERT_TRUE(checkpoint);
+    EXPECT_EQ(checkpoint->frame, CHECKPOINT_FRAME);
+
+    std::vector<u8> state;
+    ASSERT_TRUE(checkpoints.Load(*checkpoint, &state));
+    EXPECT_EQ(state, MakeState());
+  }
+
+  const std::string m_directory;
+};
+
+TEST_F(MovieTest, SavedRecordingKeepsItsCheckpoints)
+{
+  auto& movie = Core::System::GetInstance().GetMovie();
+  const std::string movie_path = GetPath("movie.dtm");
+  const std::string exported_path = GetPath("exported.dtm");
+  WriteMovie(movie_path);
+
+  // Export the movie while it's being played back, like the Export Recording menu item does
+  ASSERT_TRUE(movie.PlayInput(movie_path, nullptr));
+  movie.SaveRecording(exported_path);
+  movie.SaveCheckpoints(exported_path);
+  movie.EndPlayInput(false);
+
+  const std::optional<Movie::DTMHeader> header = ReadHeader(exported_path);
+  ASSERT_TRUE(header);
+  EXPECT_EQ(header->uniqueID, MOVIE_ID);
+  ExpectCheckpoint(exported_path);
+
+  // Playing back the exported movie must match it with its checkpoints instead of replacing them
+  // with an empty checkpoint file
+  ASSERT_TRUE(movie.PlayInput(exported_path, nullptr));
+  movie.EndPlayInput(false);
+  ExpectCheckpoint(exported_path);
+
+  // The same goes for the original movie
+  ASSERT_TRUE(movie.PlayInput(movie_path, nullptr));
+  movie.EndPlayInput(false);
+  ExpectCheckpoint(movie_path);
+}
@@ -0,0 +1,234 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+#include "UICommon/UICommon.h"
+
+namespace
+{
+// A 64 KiB page table, which is the smallest size
+constexpr u32 PAGE_TABLE_ADDRESS = 0x00100000;
+
+constexpr u32 SEGMENT_A = 0x4;
+constexpr u32 SEGMENT_B = 0x5;
+constexpr u32 VSID_A = 0x123;
+constexpr u32 VSID_B = 0x456;
+
+// Pages that use the same set of the emulated data TLB
+constexpr u32 PAGE_1 = 0x40001000;
+constexpr u32 PAGE_2 = 0x40041000;
+constexpr u32 PAGE_3 = 0x40081000;
+// A page that uses another set
+constexpr u32 PAGE_4 = 0x40002000;
+// A page in another segment
+constexpr u32 PAGE_5 = 0x50003000;
+}  // namespace
+
+class MMUTest : public testing::Test
+{
+protected:
+  MMUTest()
+      : m_system(Core::System::GetInstance()), m_memory(m_system.GetMemory()),
+        m_mmu(m_system.GetMMU()), m_ppc_state(m_system.GetPPCState())
+  {
+  }
+
+  void SetUp() override
+  {
+    m_profile_path = File::CreateTempDir();
+    ASSERT_FALSE(m_profile_path.empty());
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    Config::SetCurrent(Config::MAIN_MMU, true);
+    m_system.Initialize();
+    m_memory.Init();
+
+    if (!m_memory.InitFastmemArena() || !m_memory.CanMapLogicalPages())
+      GTEST_SKIP() << "Single pages can't be mapped into the fastmem arena on this host.";
+
+    m_ppc_state.spr[SPR_SDR] = PAGE_TABLE_ADDRESS;
+    m_mmu.SDRUpdated();
+    m_ppc_state.SetSR(SEGMENT_A, VSID_A);
+    m_ppc_state.SetSR(SEGMENT_B, VSID_B);
+    m_ppc_state.msr.DR = 1;
+    m_mmu.DBATUpdated();
+    InvalidateTLB();
+  }
+
+  void TearDown() override
+  {
+    InvalidateTLB();
+    m_ppc_state.msr.DR = 0;
+    m_ppc_state.SetSR(SEGMENT_A, 0);
+    m_ppc_state.SetSR(SEGMENT_B, 0);
+    m_ppc_state.spr[SPR_SDR] = 0;
+    m_mmu.SDRUpdated();
+    m_memory.ShutdownFastmemArena();
+    m_memory.Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+  // Invalidates every TLB entry the way system software does, with one tlbie per TLB set
+  void InvalidateTLB()
+  {
+    for (u32 i = 0; i <= PowerPC::HW_PAGE_INDEX_MASK; ++i)
+      m_mmu.InvalidateTLBEntry(i << PowerPC::HW_PAGE_INDEX_SHIFT);
+  }
+
+  // Adds a page table entry that maps the given page to physical memory. The physical page is
+  // filled with a value that identifies it.
+  void MapPage(u32 effective_address, u32 physical_address, bool changed)
+  {
+    const u32 vsid = m_ppc_state.sr[effective_address >> 28] & 0xffffff;
+    const u32 page_index = (effective_address >> PowerPC::HW_PAGE_INDEX_SHIFT) & 0xffff;
+
+    UPTE_Lo pte1;
+    pte1.VSID = vsid;
+    pte1.API = page_index >> 10;
+    pte1.V = 1;
+
+    UPTE_Hi pte2;
+    pte2.RPN = physical_address >> PowerPC::HW_PAGE_INDEX_SHIFT;
+    pte2.R = 1;
+    pte2.C = changed;
+    pte2.PP = 2;
+
+    // Use the first free entry in the primary PTEG
+    u32 pte_address = PAGE_TABLE_ADDRESS | (((vsid ^ page_index) & 0x3ff) << 6);
+    while (UPTE_Lo{m_memory.Read_U32(pte_address)}.V)
+      pte_address += 8;
+    m_memory.Write_U32(pte1.Hex, pte_address);
+    m_memory.Write_U32(pte2.Hex, pte_address + 4);
+
+    for (u32 offset = 0; offset < PowerPC::HW_PAGE_SIZE; offset += 4)
+      m_memory.Write_U32(physical_address | offset, physical_address | offset);
+  }
+
+  bool IsInFastmemTLB(u32 effective_address) const
+  {
+    const size_t set_index =
+        (effective_address >> PowerPC::HW_PAGE_INDEX_SHIFT) & (PowerPC::FASTMEM_TLB_SETS - 1);
+    const auto& set = m_ppc_state.fastmem_tlb[set_index];
+    return std::ranges::find(set, effective_address | PowerPC::HW_PAGE_MASK) != set.end();
+  }
+
+  // Checks that a page in the fastmem TLB is mapped to the right physical page in the logical
+  // fastmem region, which is what JIT code accesses
+  void ExpectMapped(u32 effective_address, u32 physical_address) const
+  {
+    ASSERT_TRUE(IsInFastmemTLB(effective_address));
+
+    u32 value;
+    std::memcpy(&value, m_memory.GetLogicalBase() + effective_address + 0x10, sizeof(value));
+    EXPECT_EQ(Common::swap32(value), physical_address | 0x10);
+  }
+
+  Core::System& m_system;
+  Memory::MemoryManager& m_memory;
+  PowerPC::MMU& m_mmu;
+  PowerPC::PowerPCState& m_ppc_state;
+  std::string m_profile_path;
+};
+
+TEST_F(MMUTest, Fill)
+{
+  MapPage(PAGE_1, 0x00200000, true);
+  MapPage(PAGE_4, 0x00201000, false);
+
+  EXPECT_EQ(m_mmu.Read_U32(PAGE_1 + 0x10), 0x00200010u);
+  ExpectMapped(PAGE_1, 0x00200000);
+
+  // Fast accesses can't set the C bit, so pages are only added once it's set
+  EXPECT_EQ(m_mmu.Read_U32(PAGE_4 + 0x10), 0x00201010u);
+  EXPECT_FALSE(IsInFastmemTLB(PAGE_4));
+
+  m_mmu.Write_U32(0x00201010, PAGE_4 + 0x10);
+  ExpectMapped(PAGE_4, 0x00201000);
+}
+
+TEST_F(MMUTest, DBATUpdatedInvalidates)
+{
+  MapPage(PAGE_1, 0x00200000, true);
+  m_mmu.Read_U32(PAGE_1);
+  ASSERT_TRUE(IsInFastmemTLB(PAGE_1));
+
+  m_mmu.DBATUpdated();
+  EXPECT_FALSE(IsInFastmemTLB(PAGE_1));
+
+  // The page is still in the emulated TLB, and is added again on the next access
+  EXPECT_EQ(m_mmu.Read_U32(PAGE_1 + 0x10), 0x00200010u);
+  ExpectMapped(PAGE_1, 0x00200000);
+}
+
+TEST_F(MMUTest, SRUpdatedInvalidatesSegment)
+{
+  MapPage(PAGE_1, 0x00200000, true);
+  MapPage(PAGE_5, 0x00201000, true);
+  m_mmu.Read_U32(PAGE_1);
+  m_mmu.Read_U32(PAGE_5);
+  ASSERT_TRUE(IsInFastmemTLB(PAGE_1));
+  ASSERT_TRUE(IsInFastmemTLB(PAGE_5));
+
+  m_mmu.SRUpdated(SEGMENT_A);
+  EXPECT_FALSE(IsInFastmemTLB(PAGE_1));
+  ExpectMapped(PAGE_5, 0x00201000);
+}
+
+TEST_F(MMUTest, TlbieInvalidatesTLBSet)
+{
+  MapPage(PAGE_1, 0x00200000, true);
+  MapPage(PAGE_2, 0x00201000, true);
+  MapPage(PAGE_4, 0x00202000, true);
+  m_mmu.Read_U32(PAGE_1);
+  m_mmu.Read_U32(PAGE_2);
+  m_mmu.Read_U32(PAGE_4);
+  ASSERT_TRUE(IsInFastmemTLB(PAGE_1));
+  ASSERT_TRUE(IsInFastmemTLB(PAGE_2));
+  ASSERT_TRUE(IsInFastmemTLB(PAGE_4));
+
+  // tlbie invalidates both ways of the set, whatever the upper bits of the address are
+  m_mmu.InvalidateTLBEntry(PAGE_3);
+  EXPECT_FALSE(IsInFastmemTLB(PAGE_1));
+  EXPECT_FALSE(IsInFastmemTLB(PAGE_2));
+  ExpectMapped(PAGE_4, 0x00202000);
+}
+
+TEST_F(MMUTest, DataTLBEvictionInvalidates)
+{
+  MapPage(PAGE_1, 0x00200000, true);
+  MapPage(PAGE_2, 0x00201000, true);
+  MapPage(PAGE_3, 0x00202000, true);
+  m_mmu.Read_U32(PAGE_1);
+  m_mmu.Read_U32(PAGE_2);
+
+  // The emulated data TLB is 2-way, so this replaces the least recently used page, PAGE_1
+  EXPECT_EQ(m_mmu.Read_U32(PAGE_3 + 0x10), 0x00202010u);
+  EXPECT_FALSE(IsInFastmemTLB(PAGE_1));
+  ExpectMapped(PAGE_2, 0x00201000);
+  ExpectMapped(PAGE_3, 0x00202000);
+
+  // Which in turn replaces PAGE_2
+  EXPECT_EQ(m_mmu.Read_U32(PAGE_1 + 0x10), 0x00200010u);
+  ExpectMapped(PAGE_1, 0x00200000);
+  EXPECT_FALSE(IsInFastmemTLB(PAGE_2));
+  ExpectMapped(PAGE_3, 0x00202000);
+}
@@ -0,0 +1,183 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/ConfigManager.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/PPCAnalyst.h"
+#include "Core/System.h"
+#include "UICommon/UICommon.h"
+
+namespace
+{
+constexpr u32 LOOP_ADDRESS = 0x00003000;
+
+constexpr u32 D(u32 opcd, u32 d, u32 a, s16 imm)
+{
+  return (opcd << 26) | (d << 21) | (a << 16) | static_cast<u16>(imm);
+}
+
+constexpr u32 X(u32 opcd, u32 d, u32 a, u32 b, u32 xo, bool rc = false)
+{
+  return (opcd << 26) | (d << 21) | (a << 16) | (b << 11) | (xo << 1) | rc;
+}
+
+constexpr u32 LWZ(u32 rd, u32 ra, s16 d)
+{
+  return D(32, rd, ra, d);
+}
+constexpr u32 STW(u32 rs, u32 ra, s16 d)
+{
+  return D(36, rs, ra, d);
+}
+constexpr u32 LFS(u32 frd, u32 ra, s16 d)
+{
+  return D(48, frd, ra, d);
+}
+constexpr u32 ADDI(u32 rd, u32 ra, s16 simm)
+{
+  return D(14, rd, ra, simm);
+}
+constexpr u32 CMPWI(u32 crf, u32 ra, s16 simm)
+{
+  return D(11, crf << 2, ra, simm);
+}
+constexpr u32 ADD(u32 rd, u32 ra, u32 rb)
+{
+  return X(31, rd, ra, rb, 266);
+}
+constexpr u32 ADDO(u32 rd, u32 ra, u32 rb)
+{
+  return X(31, rd, ra, rb, 512 | 266);
+}
+constexpr u32 FCMPU(u32 crf, u32 fra, u32 frb)
+{
+  return X(63, crf << 2, fra, frb, 0);
+}
+constexpr u32 FADDS(u32 frd, u32 fra, u32 frb, bool rc = false)
+{
+  return X(59, frd, fra, frb, 21, rc);
+}
+constexpr u32 PS_MR_RC(u32 frd, u32 frb)
+{
+  return X(4, frd, 0, frb, 72, true);
+}
+constexpr u32 BLR = 0x4e800020;
+
+// Branches back to the start of a loop that has `length` instructions, including the branch, if the
+// given CR bit is set or clear
+constexpr u32 BC(bool if_set, u32 cr_bit, size_t length)
+{
+  const u32 bo = if_set ? 0b01100 : 0b00100;
+  const s16 bd = static_cast<s16>(-4 * static_cast<s32>(length - 1));
+  return D(16, bo, cr_bit, bd);
+}
+constexpr u32 CR0_EQ = 2;
+constexpr u32 CR1_EQ = 6;
+}  // namespace
+
+class PPCAnalystTest : public testing::Test
+{
+protected:
+  PPCAnalystTest() : m_system(Core::System::GetInstance()) {}
+
+  void SetUp() override
+  {
+    m_profile_path = File::CreateTempDir();
+    ASSERT_FALSE(m_profile_path.empty());
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    m_system.GetMemory().Init();
+  }
+
+  void TearDown() override
+  {
+    m_system.GetMemory().Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+
+  // Analyzes a block that consists of the given loop followed by a blr, and returns whether the
+  // branch at the end of the loop was detected as an idle loop
+  bool IsIdleLoop(std::initializer_list<u32> loop)
+  {
+    auto& memory = m_system.GetMemory();
+    u32 address = LOOP_ADDRESS;
+    for (const u32 inst : loop)
+    {
+      memory.Write_U32(inst, address);
+      address += 4;
+    }
+    memory.Write_U32(BLR, address);
+
+    PPCAnalyst::PPCAnalyzer analyzer;
+    analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CONDITIONAL_CONTINUE);
+
+    PPCAnalyst::BlockStats stats{};
+    PPCAnalyst::BlockRegStats gpa{};
+    PPCAnalyst::BlockRegStats fpa{};
+    PPCAnalyst::CodeBlock block;
+    block.m_stats = &stats;
+    block.m_gpa = &gpa;
+    block.m_fpa = &fpa;
+    PPCAnalyst::CodeBuffer buffer(32);
+
+    analyzer.Analyze(LOOP_ADDRESS, &block, &buffer, buffer.size());
+    EXPECT_EQ(block.m_num_instructions, loop.size() + 1);
+    if (block.m_num_instructions <= loop.size())
+      return false;
+
+    const PPCAnalyst::CodeOp& branch = buffer[loop.size() - 1];
+    EXPECT_EQ(branch.branchTo, LOOP_ADDRESS);
+    return branch.branchIsIdleLoop;
+  }
+
+private:
+  Core::System& m_system;
+  std::string m_profile_path;
+};
+
+TEST_F(PPCAnalystTest, PollingLoops)
+{
+  // Waits for a word in memory to become nonzero
+  EXPECT_TRUE(IsIdleLoop({LWZ(3, 4, 0), CMPWI(0, 3, 0), BC(true, CR0_EQ, 3)}));
+
+  // Computes something from the loaded value without reading its own results from the last
+  // iteration
+  EXPECT_TRUE(IsIdleLoop({LWZ(3, 4, 0), ADD(5, 3, 6), CMPWI(0, 5, 0), BC(true, CR0_EQ, 4)}));
+
+  // Waits for a float in memory to change. fcmpu is flagged as reading the FPRF, but it overwrites
+  // it, so this doesn't count as depending on the previous iteration.
+  EXPECT_TRUE(IsIdleLoop({LFS(1, 3, 0), FCMPU(0, 1, 2), BC(true, CR0_EQ, 3)}));
+
+  // The record form copies the FPSCR bits that the instruction itself just set into CR1
+  EXPECT_TRUE(IsIdleLoop({LFS(1, 3, 0), FADDS(3, 1, 2, true), BC(true, CR1_EQ, 3)}));
+
+  // Reads the FPSCR after the loop has written to it
+  EXPECT_TRUE(IsIdleLoop({LFS(1, 3, 0), FADDS(3, 1, 2), PS_MR_RC(5, 6), BC(true, CR1_EQ, 4)}));
+}
+
+TEST_F(PPCAnalystTest, LoopsThatChangeState)
+{
+  // Writes to memory
+  EXPECT_FALSE(IsIdleLoop({LWZ(3, 4, 0), STW(3, 4, 4), CMPWI(0, 3, 0), BC(true, CR0_EQ, 4)}));
+
+  // Increments a counter
+  EXPECT_FALSE(IsIdleLoop({ADDI(3, 3, 1), CMPWI(0, 3, 100), BC(false, CR0_EQ, 3)}));
+
+  // An overflow would set XER[SO], which is sticky and changes CR0 in the next iteration
+  EXPECT_FALSE(IsIdleLoop({LWZ(3, 4, 0), ADDO(5, 3, 6), CMPWI(0, 5, 0), BC(true, CR0_EQ, 4)}));
+
+  // Copies the FPSCR bits from the previous iteration into CR1 before fadds changes them
+  EXPECT_FALSE(IsIdleLoop({PS_MR_RC(5, 6), LFS(1, 3, 0), FADDS(3, 1, 2), BC(true, CR1_EQ, 4)}));
+}
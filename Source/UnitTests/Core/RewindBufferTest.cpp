@@ -0,0 +1,140 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/RewindBuffer.h"
+
+namespace
+{
+constexpr size_t STATE_SIZE = 0x40000;
+
+// Returns a state that only differs from the previous one in a few pages
+std::vector<u8> MakeState(u64 frame)
+{
+  std::vector<u8> state(STATE_SIZE);
+  std::mt19937 rng(1234);
+  std::generate(state.begin(), state.end(), [&] { return static_cast<u8>(rng()); });
+
+  for (size_t i = 0; i < 4; ++i)
+  {
+    const size_t offset = ((frame * 7 + i * 13) % (STATE_SIZE / State::RewindBuffer::PAGE_SIZE)) *
+                          State::RewindBuffer::PAGE_SIZE;
+    std::fill_n(state.begin() + offset, 0x100, static_cast<u8>(frame));
+  }
+
+  return state;
+}
+}  // namespace
+
+TEST(RewindBuffer, RestoresEveryEntry)
+{
+  State::RewindBuffer buffer(0x10000000, 4);
+
+  for (u64 frame = 0; frame < 10; ++frame)
+    buffer.Add(MakeState(frame), frame);
+  ASSERT_EQ(buffer.GetSize(), 10u);
+
+  for (size_t steps_back = 0; steps_back < 10; ++steps_back)
+  {
+    std::vector<u8> state;
+    u64 frame;
+    ASSERT_TRUE(buffer.Restore(steps_back, &state, &frame));
+    EXPECT_EQ(frame, 9 - steps_back);
+    EXPECT_EQ(state, MakeState(frame));
+  }
+
+  std::vector<u8> state;
+  EXPECT_FALSE(buffer.Restore(10, &state));
+}
+
+TEST(RewindBuffer, DeltasAreSmallerThanKeyframes)
+{
+  State::RewindBuffer one_keyframe(0x10000000, 2);
+  one_keyframe.Add(MakeState(0), 0);
+  const size_t keyframe_usage = one_keyframe.GetMemoryUsage();
+  one_keyframe.Add(MakeState(1), 1);
+  const size_t delta_usage = one_keyframe.GetMemoryUsage() - keyframe_usage;
+
+  // The random contents of the states can't be compressed, so only storing
+  // the changed pages is what makes the difference here
+  EXPECT_LT(delta_usage * 8, keyframe_usage);
+}
+
+TEST(RewindBuffer, HandlesSizeChanges)
+{
+  State::RewindBuffer buffer(0x10000000);
+
+  std::vector<u8> small_state = MakeState(0);
+  small_state.resize(STATE_SIZE / 2 + 123);
+  std::vector<u8> large_state = MakeState(1);
+  large_state.resize(STATE_SIZE + 0x1234, 0x55);
+
+  buffer.Add(MakeState(0), 0);
+  buffer.Add(small_state, 1);
+  buffer.Add(large_state, 2);
+
+  std::vector<u8> state;
+  ASSERT_TRUE(buffer.Restore(0, &state));
+  EXPECT_EQ(state, large_state);
+  ASSERT_TRUE(buffer.Restore(1, &state));
+  EXPECT_EQ(state, small_state);
+  ASSERT_TRUE(buffer.Restore(2, &state));
+  EXPECT_EQ(state, MakeState(0));
+}
+
+TEST(RewindBuffer, DiscardNewerThan)
+{
+  State::RewindBuffer buffer(0x10000000, 4);
+
+  for (u64 frame = 0; frame < 10; ++frame)
+    buffer.Add(MakeState(frame), frame);
+
+  // Drops the newest keyframe, so new entries must be based on an older one
+  buffer.DiscardNewerThan(3);
+  ASSERT_EQ(buffer.GetSize(), 7u);
+
+  buffer.Add(MakeState(100), 100);
+
+  std::vector<u8> state;
+  u64 frame;
+  ASSERT_TRUE(buffer.Restore(0, &state, &frame));
+  EXPECT_EQ(frame, 100u);
+  EXPECT_EQ(state, MakeState(100));
+  ASSERT_TRUE(buffer.Restore(1, &state, &frame));
+  EXPECT_EQ(frame, 6u);
+  EXPECT_EQ(state, MakeState(6));
+
+  buffer.DiscardNewerThan(buffer.GetSize());
+  EXPECT_TRUE(buffer.IsEmpty());
+}
+
+TEST(RewindBuffer, EvictsOldestEntries)
+{
+  State::RewindBuffer buffer(STATE_SIZE * 5, 4);
+
+  for (u64 frame = 0; frame < 40; ++frame)
+  {
+    buffer.Add(MakeState(frame), frame);
+    // Only the newest keyframe group may exceed the budget
+    if (buffer.GetSize() > 4)
+    {
+      EXPECT_LE(buffer.GetMemoryUsage(), STATE_SIZE * 5);
+    }
+  }
+
+  ASSERT_FALSE(buffer.IsEmpty());
+  ASSERT_LT(buffer.GetSize(), 40u);
+
+  const size_t oldest = buffer.GetSize() - 1;
+  std::vector<u8> state;
+  u64 frame;
+  ASSERT_TRUE(buffer.Restore(oldest, &state, &frame));
+  EXPECT_EQ(frame, 39 - oldest);
+  EXPECT_EQ(state, MakeState(frame));
+}
@@ -0,0 +1,144 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Timer.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/WIABlob.h"
+
+// Checks that GCZ, RVZ, split and plain images return the same data, and prints how fast each of
+// them can be read with sequential and random access patterns.
+class BlobReadBenchmarkTest : public testing::Test
+{
+protected:
+  static constexpr u64 IMAGE_SIZE = 0x2000000;
+  static constexpr u64 SEQUENTIAL_READ_SIZE = 0x100000;
+  static constexpr u64 RANDOM_READ_SIZE = 0x8000;
+  static constexpr size_t RANDOM_READ_COUNT = 2000;
+
+  static void SetUpTestSuite()
+  {
+    s_directory = File::CreateTempDir();
+    if (s_directory.empty())
+      return;
+
+    // Alternate between incompressible and highly compressible regions,
+    // roughly like the data on a real disc
+    s_data.resize(IMAGE_SIZE);
+    std::mt19937 rng(1234);
+    for (u64 offset = 0; offset < IMAGE_SIZE; offset += 0x10000)
+    {
+      if ((offset / 0x10000) % 3 == 0)
+        std::generate_n(s_data.begin() + offset, 0x10000, [&] { return static_cast<u8>(rng()); });
+      else
+        std::fill_n(s_data.begin() + offset, 0x10000, static_cast<u8>(offset >> 16));
+    }
+
+    const auto callback = [](const std::string&, float) { return true; };
+
+    File::IOFile iso(GetPath("iso"), "wb");
+    iso.WriteBytes(s_data.data(), s_data.size());
+    iso.Close();
+
+    // Split sizes that aren't multiples of the sector size, to also cover reads across files
+    const u64 split_points[] = {0, 0xC01234, 0x1A00800, IMAGE_SIZE};
+    for (size_t i = 0; i + 1 < std::size(split_points); ++i)
+    {
+      File::IOFile part(GetPath(fmt::format("part{}.iso", i)), "wb");
+      part.WriteBytes(s_data.data() + split_points[i], split_points[i + 1] - split_points[i]);
+    }
+
+    std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(GetPath("iso"));
+    if (!reader)
+      return;
+
+    DiscIO::ConvertToGCZ(reader.get(), GetPath("iso"), GetPath("gcz"), 0, 0x8000, callback);
+    DiscIO::ConvertToWIAOrRVZ(reader.get(), GetPath("iso"), GetPath("rvz"), true,
+                              DiscIO::WIARVZCompressionType::Zstd, 5, 0x20000, callback);
+  }
+
+  static void TearDownTestSuite()
+  {
+    if (!s_directory.empty())
+      File::DeleteDirRecursively(s_directory);
+    s_data = {};
+  }
+
+  static std::string GetPath(const std::string& extension)
+  {
+    return fmt::format("{}/image.{}", s_directory, extension);
+  }
+
+  static void Benchmark(const std::string& extension, DiscIO::BlobType expected_type)
+  {
+    ASSERT_FALSE(s_directory.empty());
+
+    std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(GetPath(extension));
+    ASSERT_NE(reader, nullptr);
+    ASSERT_EQ(reader->GetBlobType(), expected_type);
+    ASSERT_EQ(reader->GetDataSize(), IMAGE_SIZE);
+
+    std::vector<u8> buffer(SEQUENTIAL_READ_SIZE);
+
+    u64 start_time = Common::Timer::NowUs();
+    for (u64 offset = 0; offset < IMAGE_SIZE; offset += SEQUENTIAL_READ_SIZE)
+    {
+      ASSERT_TRUE(reader->Read(offset, SEQUENTIAL_READ_SIZE, buffer.data()));
+      ASSERT_TRUE(std::equal(buffer.begin(), buffer.end(), s_data.begin() + offset));
+    }
+    const u64 sequential_us = std::max<u64>(Common::Timer::NowUs() - start_time, 1);
+
+    std::mt19937 rng(5678);
+    std::uniform_int_distribution<u64> distribution(0, IMAGE_SIZE - RANDOM_READ_SIZE);
+
+    start_time = Common::Timer::NowUs();
+    for (size_t i = 0; i < RANDOM_READ_COUNT; ++i)
+    {
+      const u64 offset = distribution(rng);
+      ASSERT_TRUE(reader->Read(offset, RANDOM_READ_SIZE, buffer.data()));
+      ASSERT_TRUE(std::equal(buffer.begin(), buffer.begin() + RANDOM_READ_SIZE,
+                             s_data.begin() + offset));
+    }
+    const u64 random_us = std::max<u64>(Common::Timer::NowUs() - start_time, 1);
+
+    fmt::print("{}: sequential {:.1f} MiB/s, random {:.1f} MiB/s\n", extension,
+               static_cast<double>(IMAGE_SIZE) / sequential_us * 1000000 / 0x100000,
+               static_cast<double>(RANDOM_READ_SIZE * RANDOM_READ_COUNT) / random_us * 1000000 /
+                   0x100000);
+  }
+
+  static inline std::string s_directory;
+  static inline std::vector<u8> s_data;
+};
+
+TEST_F(BlobReadBenchmarkTest, ISO)
+{
+  Benchmark("iso", DiscIO::BlobType::PLAIN);
+}
+
+TEST_F(BlobReadBenchmarkTest, SplitISO)
+{
+  Benchmark("part0.iso", DiscIO::BlobType::SPLIT_PLAIN);
+}
+
+TEST_F(BlobReadBenchmarkTest, GCZ)
+{
+  Benchmark("gcz", DiscIO::BlobType::GCZ);
+}
+
+TEST_F(BlobReadBenchmarkTest, RVZ)
+{
+  Benchmark("rvz", DiscIO::BlobType::RVZ);
+}
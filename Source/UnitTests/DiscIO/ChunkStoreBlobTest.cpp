@@ -0,0 +1,383 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Swap.h"
+#include "Core/IOS/ES/Formats.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/ChunkStoreBlob.h"
+#include "DiscIO/LaggedFibonacciGenerator.h"
+#include "DiscIO/VolumeWii.h"
+
+namespace
+{
+// Serves decrypted partition data to VolumeWii::EncryptGroup
+class DecryptedPartitionReader final : public DiscIO::BlobReader
+{
+public:
+  explicit DecryptedPartitionReader(const std::vector<u8>& data) : m_data(data) {}
+
+  DiscIO::BlobType GetBlobType() const override { return DiscIO::BlobType::PLAIN; }
+  std::unique_ptr<BlobReader> CopyReader() const override
+  {
+    return std::make_unique<DecryptedPartitionReader>(m_data);
+  }
+  u64 GetRawSize() const override { return m_data.size(); }
+  u64 GetDataSize() const override { return m_data.size(); }
+  DiscIO::DataSizeType GetDataSizeType() const override
+  {
+    return DiscIO::DataSizeType::Accurate;
+  }
+  u64 GetBlockSize() const override { return 0; }
+  bool HasFastRandomAccessInBlock() const override { return true; }
+  std::string GetCompressionMethod() const override { return {}; }
+  std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
+
+  bool Read(u64, u64, u8*) override { return false; }
+  bool SupportsReadWiiDecrypted(u64 offset, u64 size, u64) const override
+  {
+    return offset + size <= m_data.size();
+  }
+  bool ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset) override
+  {
+    if (!SupportsReadWiiDecrypted(offset, size, partition_data_offset))
+      return false;
+    std::copy_n(m_data.begin() + offset, size, out_ptr);
+    return true;
+  }
+
+private:
+  const std::vector<u8>& m_data;
+};
+}  // namespace
+
+class ChunkStoreBlobTest : public testing::Test
+{
+protected:
+  static constexpr u64 IMAGE_SIZE = 0x800000;
+
+  void SetUp() override
+  {
+    m_directory = File::CreateTempDir();
+    ASSERT_FALSE(m_directory.empty());
+  }
+
+  void TearDown() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  std::string GetPath(const std::string& name) const
+  {
+    return fmt::format("{}/{}", m_directory, name);
+  }
+
+  // Random data with runs of zeroes in between, and a second half that mostly repeats the first
+  // half at an offset that isn't aligned to anything, so that content-defined chunking has
+  // something to deduplicate
+  static std::vector<u8> MakeData(u32 seed)
+  {
+    std::vector<u8> data(IMAGE_SIZE);
+    std::mt19937 rng(seed);
+    std::generate(data.begin(), data.begin() + IMAGE_SIZE / 2,
+                  [&] { return static_cast<u8>(rng()); });
+    std::fill_n(data.begin() + 0x100000, 0x80000, u8(0));
+    std::copy_n(data.begin() + 0x1234, IMAGE_SIZE / 2 - 0x1234, data.begin() + IMAGE_SIZE / 2);
+    return data;
+  }
+
+  // Fills data with the junk data that Nintendo's mastering tools write between files. Each block
+  // gets a different seed, like on real discs.
+  static void FillWithJunk(std::vector<u8>* data, size_t offset, size_t size, std::mt19937* rng)
+  {
+    constexpr size_t BLOCK_SIZE = DiscIO::VolumeWii::BLOCK_TOTAL_SIZE;
+    DiscIO::LaggedFibonacciGenerator lfg;
+    for (size_t position = offset; position < offset + size;)
+    {
+      const size_t offset_in_block = position % BLOCK_SIZE;
+      const size_t bytes = std::min(BLOCK_SIZE - offset_in_block, offset + size - position);
+
+      DiscIO::ChunkStoreJunkSeed seed;
+      std::generate(seed.begin(), seed.end(), std::ref(*rng));
+      lfg.SetSeed(seed.data());
+      lfg.Forward(offset_in_block);
+      lfg.GetBytes(bytes, data->data() + position);
+
+      position += bytes;
+    }
+  }
+
+  // A Wii disc with one partition, whose encrypted data is made from the given decrypted data
+  // and is followed by some unencrypted data. A few hashes are changed so that they don't match
+  // the data. Only the title key in the ticket differs between discs.
+  static std::vector<u8> MakeWiiDisc(const std::vector<u8>& decrypted, u8 title_key_byte)
+  {
+    using DiscIO::VolumeWii;
+
+    constexpr u64 PARTITION_OFFSET = 0x50000;
+    constexpr u64 PARTITION_DATA_OFFSET = 0x20000;
+    constexpr u64 DATA_START = PARTITION_OFFSET + PARTITION_DATA_OFFSET;
+    const u64 blocks = decrypted.size() / VolumeWii::BLOCK_DATA_SIZE;
+    const u64 data_size = blocks * VolumeWii::BLOCK_TOTAL_SIZE;
+
+    std::vector<u8> disc(DATA_START + data_size + 0x12345);
+    const auto write_32 = [&disc](u64 offset, u32 value) {
+      const u32 swapped = Common::swap32(value);
+      std::memcpy(disc.data() + offset, &swapped, sizeof(swapped));
+    };
+
+    std::copy_n("RTSTZZ", 6, disc.begin());
+    write_32(0x18, 0x5D1C9EA3);
+    write_32(0x40000, 1);
+    write_32(0x40004, 0x40020 >> 2);
+    write_32(0x40020, PARTITION_OFFSET >> 2);
+    write_32(0x40024, 0);
+
+    std::vector<u8> ticket_bytes(sizeof(IOS::ES::Ticket));
+    const u32 signature_type = Common::swap32(0x10001);  // RSA-2048
+    std::memcpy(ticket_bytes.data(), &signature_type, sizeof(signature_type));
+    std::fill_n(ticket_bytes.begin() + offsetof(IOS::ES::Ticket, title_key), 16, title_key_byte);
+    std::copy(ticket_bytes.begin(), ticket_bytes.end(), disc.begin() + PARTITION_OFFSET);
+    write_32(PARTITION_OFFSET + 0x2b8, PARTITION_DATA_OFFSET >> 2);
+    write_32(PARTITION_OFFSET + 0x2bc, static_cast<u32>(data_size >> 2));
+
+    const auto key = IOS::ES::TicketReader(ticket_bytes).GetTitleKey();
+    DecryptedPartitionReader reader(decrypted);
+    std::array<u8, VolumeWii::GROUP_TOTAL_SIZE> group;
+    for (u64 i = 0; i * VolumeWii::BLOCKS_PER_GROUP < blocks; ++i)
+    {
+      const auto change_hashes = [i](VolumeWii::HashBlock* hash_blocks) {
+        if (i != 1)
+          return;
+        hash_blocks[5].h0[3].fill(0x12);
+        hash_blocks[63].padding_2.back() = 0x34;
+      };
+      EXPECT_TRUE(VolumeWii::EncryptGroup(i * VolumeWii::GROUP_DATA_SIZE, DATA_START,
+                                          decrypted.size(), key, &reader, &group, change_hashes));
+
+      const u64 offset = i * VolumeWii::GROUP_TOTAL_SIZE;
+      const u64 size = std::min<u64>(group.size(), data_size - offset);
+      std::copy_n(group.begin(), size, disc.begin() + DATA_START + offset);
+    }
+
+    std::mt19937 rng(1);
+    std::generate(disc.begin() + DATA_START + data_size, disc.end(),
+                  [&] { return static_cast<u8>(rng()); });
+
+    return disc;
+  }
+
+  static void WriteFile(const std::string& path, const std::vector<u8>& data)
+  {
+    File::IOFile file(path, "wb");
+    ASSERT_TRUE(file.WriteBytes(data.data(), data.size()));
+  }
+
+  static bool Convert(const std::string& in_path, const std::string& out_path)
+  {
+    std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(in_path);
+    if (!reader)
+      return false;
+
+    const auto callback = [](const std::string&, float) { return true; };
+    return DiscIO::ConvertToChunkStore(reader.get(), in_path, out_path, "", 5, callback);
+  }
+
+  static void ExpectData(DiscIO::BlobReader* reader, const std::vector<u8>& data)
+  {
+    ASSERT_EQ(reader->GetBlobType(), DiscIO::BlobType::CHUNK_STORE);
+    ASSERT_EQ(reader->GetDataSize(), data.size());
+
+    std::vector<u8> buffer(data.size());
+    ASSERT_TRUE(reader->Read(0, buffer.size(), buffer.data()));
+    EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), data.begin()));
+
+    // Unaligned reads that start and end in the middle of chunks
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<u64> distribution(0, data.size() - 0x9000);
+    for (int i = 0; i < 100; ++i)
+    {
+      const u64 offset = distribution(rng);
+      const u64 size = 1 + offset % 0x9000;
+      ASSERT_TRUE(reader->Read(offset, size, buffer.data()));
+      EXPECT_TRUE(std::equal(buffer.begin(), buffer.begin() + size, data.begin() + offset));
+    }
+
+    EXPECT_FALSE(reader->Read(data.size() - 1, 2, buffer.data()));
+  }
+
+  std::vector<std::string> GetStoreFiles() const
+  {
+    std::vector<std::string> files;
+    AddFiles(File::ScanDirectoryTree(GetPath(DiscIO::DEFAULT_CHUNK_STORE_PATH), true), &files);
+    std::ranges::sort(files);
+    return files;
+  }
+
+  static void AddFiles(const File::FSTEntry& entry, std::vector<std::string>* files)
+  {
+    for (const File::FSTEntry& child : entry.children)
+    {
+      if (child.isDirectory)
+        AddFiles(child, files);
+      else
+        files->push_back(child.physicalName);
+    }
+  }
+
+  std::string m_directory;
+};
+
+TEST_F(ChunkStoreBlobTest, RoundTrip)
+{
+  const std::vector<u8> data = MakeData(1234);
+  WriteFile(GetPath("image.iso"), data);
+  ASSERT_TRUE(Convert(GetPath("image.iso"), GetPath("image.dcs")));
+
+  std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(GetPath("image.dcs"));
+  ASSERT_NE(reader, nullptr);
+  ExpectData(reader.get(), data);
+
+  std::unique_ptr<DiscIO::BlobReader> copy = reader->CopyReader();
+  ASSERT_NE(copy, nullptr);
+  ExpectData(copy.get(), data);
+}
+
+TEST_F(ChunkStoreBlobTest, ReopenAndRead)
+{
+  const std::vector<u8> data = MakeData(1234);
+  WriteFile(GetPath("image.iso"), data);
+  ASSERT_TRUE(Convert(GetPath("image.iso"), GetPath("image.dcs")));
+  const std::vector<std::string> store_files = GetStoreFiles();
+  ASSERT_FALSE(store_files.empty());
+
+  // Converting the same data again only adds a manifest, since every chunk is already stored
+  ASSERT_TRUE(Convert(GetPath("image.iso"), GetPath("copy.dcs")));
+  EXPECT_EQ(GetStoreFiles(), store_files);
+
+  // Once the original image is gone, both manifests still read back the data from the store
+  ASSERT_TRUE(File::Delete(GetPath("image.iso")));
+  for (const char* name : {"image.dcs", "copy.dcs"})
+  {
+    std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(GetPath(name));
+    ASSERT_NE(reader, nullptr);
+    ExpectData(reader.get(), data);
+  }
+}
+
+TEST_F(ChunkStoreBlobTest, MissingChunk)
+{
+  const std::vector<u8> data = MakeData(5678);
+  WriteFile(GetPath("image.iso"), data);
+  ASSERT_TRUE(Convert(GetPath("image.iso"), GetPath("image.dcs")));
+
+  const std::vector<std::string> store_files = GetStoreFiles();
+  ASSERT_FALSE(store_files.empty());
+  for (const std::string& path : store_files)
+    ASSERT_TRUE(File::Delete(path));
+
+  std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(GetPath("image.dcs"));
+  ASSERT_NE(reader, nullptr);
+  std::vector<u8> buffer(data.size());
+  EXPECT_FALSE(reader->Read(0, buffer.size(), buffer.data()));
+}
+
+TEST_F(ChunkStoreBlobTest, JunkIsNotStored)
+{
+  // Junk everywhere except for the first MiB, including junk that starts partway into a block
+  // after the zeroes that follow a file
+  std::vector<u8> data = MakeData(1234);
+  std::mt19937 rng(99);
+  FillWithJunk(&data, 0x100000, 0x300000, &rng);
+  std::fill_n(data.begin() + 0x400000, 0x20, u8(0));
+  FillWithJunk(&data, 0x400020, IMAGE_SIZE - 0x400020, &rng);
+  WriteFile(GetPath("image.iso"), data);
+  ASSERT_TRUE(Convert(GetPath("image.iso"), GetPath("image.dcs")));
+
+  u64 stored_bytes = 0;
+  for (const std::string& path : GetStoreFiles())
+    stored_bytes += File::GetSize(path);
+  EXPECT_LT(stored_bytes, 0x110000u);
+
+  std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(GetPath("image.dcs"));
+  ASSERT_NE(reader, nullptr);
+  ExpectData(reader.get(), data);
+}
+
+TEST_F(ChunkStoreBlobTest, WiiPartition)
+{
+  using DiscIO::VolumeWii;
+
+  // Two and a half groups, with junk in the middle
+  std::vector<u8> decrypted((VolumeWii::BLOCKS_PER_GROUP * 5 / 2) * VolumeWii::BLOCK_DATA_SIZE);
+  std::mt19937 rng(5678);
+  std::generate(decrypted.begin(), decrypted.end(), [&] { return static_cast<u8>(rng()); });
+  FillWithJunk(&decrypted, 0x300000, 0x100000, &rng);
+
+  const std::vector<u8> data = MakeWiiDisc(decrypted, 1);
+  WriteFile(GetPath("image.iso"), data);
+  ASSERT_TRUE(Convert(GetPath("image.iso"), GetPath("image.dcs")));
+
+  std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(GetPath("image.dcs"));
+  ASSERT_NE(reader, nullptr);
+
+  // Reads from the partition are encrypted again, including the hashes that don't match
+  std::vector<u8> buffer(data.size());
+  ASSERT_TRUE(reader->Read(0, buffer.size(), buffer.data()));
+  EXPECT_TRUE(buffer == data);
+  ASSERT_TRUE(reader->Read(0x70000 + VolumeWii::GROUP_TOTAL_SIZE - 0x123, 0x8000, buffer.data()));
+  EXPECT_TRUE(std::equal(buffer.begin(), buffer.begin() + 0x8000,
+                         data.begin() + 0x70000 + VolumeWii::GROUP_TOTAL_SIZE - 0x123));
+
+  // The decrypted data can be read without encrypting it
+  ASSERT_TRUE(reader->SupportsReadWiiDecrypted(0, decrypted.size(), 0x70000));
+  ASSERT_TRUE(reader->ReadWiiDecrypted(0, decrypted.size(), buffer.data(), 0x70000));
+  EXPECT_TRUE(std::equal(decrypted.begin(), decrypted.end(), buffer.begin()));
+  EXPECT_FALSE(reader->SupportsReadWiiDecrypted(0, decrypted.size() + 1, 0x70000));
+}
+
+TEST_F(ChunkStoreBlobTest, WiiPartitionsWithDifferentKeys)
+{
+  using DiscIO::VolumeWii;
+
+  std::vector<u8> decrypted(VolumeWii::BLOCKS_PER_GROUP * 2 * VolumeWii::BLOCK_DATA_SIZE);
+  std::mt19937 rng(5678);
+  std::generate(decrypted.begin(), decrypted.end(), [&] { return static_cast<u8>(rng()); });
+  FillWithJunk(&decrypted, 0x200000, 0x100000, &rng);
+
+  WriteFile(GetPath("image.iso"), MakeWiiDisc(decrypted, 1));
+  ASSERT_TRUE(Convert(GetPath("image.iso"), GetPath("image.dcs")));
+  const std::vector<std::string> store_files = GetStoreFiles();
+
+  // The same partition data encrypted with another key, and with different junk, only adds the
+  // chunks around the ticket to the store
+  FillWithJunk(&decrypted, 0x200000, 0x100000, &rng);
+  const std::vector<u8> data = MakeWiiDisc(decrypted, 2);
+  WriteFile(GetPath("other.iso"), data);
+  ASSERT_TRUE(Convert(GetPath("other.iso"), GetPath("other.dcs")));
+  const std::vector<std::string> new_store_files = GetStoreFiles();
+  EXPECT_LE(new_store_files.size(), store_files.size() + 2);
+
+  std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(GetPath("other.dcs"));
+  ASSERT_NE(reader, nullptr);
+  std::vector<u8> buffer(data.size());
+  ASSERT_TRUE(reader->Read(0, buffer.size(), buffer.data()));
+  EXPECT_TRUE(buffer == data);
+}
@@ -0,0 +1,167 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/WIABlob.h"
+
+class WIABlobTest : public testing::Test
+{
+protected:
+  static constexpr u64 IMAGE_SIZE = 0x1000000;
+  static constexpr int CHUNK_SIZE = 0x20000;
+
+  void SetUp() override
+  {
+    m_directory = File::CreateTempDir();
+    ASSERT_FALSE(m_directory.empty());
+
+    // Compressible, but not so compressible that decompressing takes no time
+    m_data.resize(IMAGE_SIZE);
+    std::mt19937 rng(1234);
+    std::generate(m_data.begin(), m_data.end(), [&] { return static_cast<u8>(rng() % 16); });
+
+    {
+      File::IOFile file(GetPath("image.iso"), "wb");
+      ASSERT_TRUE(file.WriteBytes(m_data.data(), m_data.size()));
+    }
+
+    std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(GetPath("image.iso"));
+    ASSERT_NE(reader, nullptr);
+    File::IOFile outfile(GetPath("image.rvz"), "wb");
+    const auto callback = [](const std::string&, float) { return true; };
+    ASSERT_EQ(DiscIO::RVZFileReader::Convert(reader.get(), nullptr, &outfile,
+                                             DiscIO::WIARVZCompressionType::Zstd, 5, CHUNK_SIZE,
+                                             callback, 0),
+              DiscIO::ConversionResultCode::Success);
+  }
+
+  void TearDown() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  std::string GetPath(const std::string& name) const
+  {
+    return fmt::format("{}/{}", m_directory, name);
+  }
+
+  std::unique_ptr<DiscIO::BlobReader> OpenRVZ() const
+  {
+    std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(GetPath("image.rvz"));
+    if (reader)
+    {
+      EXPECT_EQ(reader->GetBlobType(), DiscIO::BlobType::RVZ);
+      EXPECT_EQ(reader->GetDataSize(), IMAGE_SIZE);
+    }
+    return reader;
+  }
+
+  void ExpectRead(DiscIO::BlobReader* reader, u64 offset, u64 size) const
+  {
+    std::vector<u8> buffer(size);
+    ASSERT_TRUE(reader->Read(offset, size, buffer.data()));
+    EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), m_data.begin() + offset))
+        << fmt::format("offset {:#x}, size {:#x}", offset, size);
+  }
+
+  std::string m_directory;
+  std::vector<u8> m_data;
+};
+
+TEST_F(WIABlobTest, MultiGroupReads)
+{
+  std::unique_ptr<DiscIO::BlobReader> reader = OpenRVZ();
+  ASSERT_NE(reader, nullptr);
+
+  // More groups than are decompressed in parallel at once
+  ExpectRead(reader.get(), 0, IMAGE_SIZE);
+
+  std::unique_ptr<DiscIO::BlobReader> copy = reader->CopyReader();
+  ASSERT_NE(copy, nullptr);
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<u64> distribution(0, IMAGE_SIZE - 6 * CHUNK_SIZE);
+  for (int i = 0; i < 50; ++i)
+  {
+    const u64 offset = distribution(rng);
+    const u64 size = 2 * CHUNK_SIZE + offset % (4 * CHUNK_SIZE);
+    ExpectRead(copy.get(), offset, size);
+  }
+}
+
+TEST_F(WIABlobTest, PartiallyDecompressedGroups)
+{
+  std::unique_ptr<DiscIO::BlobReader> reader = OpenRVZ();
+  ASSERT_NE(reader, nullptr);
+
+  // Starts and ends in the middle of groups, so the last group is only decompressed up to the end
+  // of the read
+  const u64 offset = 5 * CHUNK_SIZE + 0x1234;
+  const u64 size = 3 * CHUNK_SIZE + 0x800;
+  ExpectRead(reader.get(), offset, size);
+
+  // Continues decompressing the last group from where the previous read stopped
+  ExpectRead(reader.get(), offset + size, CHUNK_SIZE - 0x800 - 0x1234);
+
+  // Goes back to a group that was decompressed in parallel, then reads several groups again
+  ExpectRead(reader.get(), 6 * CHUNK_SIZE + 0x100, 0x100);
+  ExpectRead(reader.get(), 4 * CHUNK_SIZE - 0x10, 4 * CHUNK_SIZE);
+}
+
+TEST_F(WIABlobTest, CorruptGroup)
+{
+  // Every group is a zstd frame. Overwrite the middle of a frame near the end of the file, which
+  // belongs to one of the last groups.
+  std::vector<u8> file_data;
+  {
+    File::IOFile file(GetPath("image.rvz"), "rb");
+    file_data.resize(file.GetSize());
+    ASSERT_TRUE(file.ReadBytes(file_data.data(), file_data.size()));
+  }
+
+  constexpr std::array<u8, 4> ZSTD_MAGIC = {0x28, 0xb5, 0x2f, 0xfd};
+  std::vector<size_t> frame_offsets;
+  for (auto it = file_data.begin();
+       (it = std::search(it, file_data.end(), ZSTD_MAGIC.begin(), ZSTD_MAGIC.end())) !=
+       file_data.end();
+       ++it)
+  {
+    frame_offsets.push_back(it - file_data.begin());
+  }
+  ASSERT_GE(frame_offsets.size(), 4u);
+  const size_t corrupt_offset = (frame_offsets[frame_offsets.size() - 3] +
+                                 frame_offsets[frame_offsets.size() - 2]) /
+                                2;
+  std::fill_n(file_data.begin() + corrupt_offset, 0x100, u8(0xff));
+  {
+    File::IOFile file(GetPath("image.rvz"), "wb");
+    ASSERT_TRUE(file.WriteBytes(file_data.data(), file_data.size()));
+  }
+
+  std::unique_ptr<DiscIO::BlobReader> reader = OpenRVZ();
+  ASSERT_NE(reader, nullptr);
+
+  // The corrupt group is decompressed in parallel with its neighbours, fails, and is retried on
+  // its own, which fails again
+  std::vector<u8> buffer(8 * CHUNK_SIZE);
+  EXPECT_FALSE(reader->Read(IMAGE_SIZE - buffer.size(), buffer.size(), buffer.data()));
+
+  // The reader is still usable, both for groups that were decompressed along with the corrupt one
+  // and for groups elsewhere
+  ExpectRead(reader.get(), IMAGE_SIZE - 8 * CHUNK_SIZE, 2 * CHUNK_SIZE);
+  ExpectRead(reader.get(), 0, 8 * CHUNK_SIZE);
+}
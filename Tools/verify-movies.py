@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+
+# Plays back many DTM recordings with dolphin-emu-nogui --verify, several at a time, and prints
+# a summary of which ones stayed in sync. Each playback runs in its own process with its own
+# temporary user directory, so that memory cards and settings can't leak between them.
+#
+# Only recordings made with Movie/RAMHashInterval set contain RAM hashes. Recordings without them
+# are only checked for playing back to the end.
+#
+# Example:
+# $ python Tools/verify-movies.py --dolphin build/Binaries/dolphin-emu-nogui \
+#     --exec ~/games/GALE01.rvz --jobs 8 ~/movies/*.dtm
+
+from pathlib import Path
+import argparse
+import concurrent.futures
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+
+def verify(args, movie: Path):
+    with tempfile.TemporaryDirectory(prefix="dolphin-verify-") as user_dir:
+        if args.user:
+            shutil.copytree(args.user, user_dir, dirs_exist_ok=True)
+
+        command = [
+            args.dolphin,
+            "--verify",
+            "--user",
+            user_dir,
+            "--movie",
+            str(movie),
+            "--exec",
+            args.exec,
+        ]
+        try:
+            result = subprocess.run(
+                command,
+                stdout=subprocess.PIPE,
+                stderr=subprocess.STDOUT,
+                text=True,
+                timeout=args.timeout,
+            )
+        except subprocess.TimeoutExpired:
+            return movie, False, "TIMEOUT"
+
+    # The last line of the output is the result that --verify prints
+    prefix = f"{movie}: "
+    for line in reversed(result.stdout.splitlines()):
+        if line.startswith(prefix):
+            return movie, result.returncode == 0, line[len(prefix) :]
+
+    return movie, False, f"ERROR (exit code {result.returncode})"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Verify DTM recordings in parallel.")
+    parser.add_argument("movies", nargs="+", type=Path, help="DTM files to verify")
+    parser.add_argument("--dolphin", required=True, help="Path to dolphin-emu-nogui")
+    parser.add_argument("--exec", required=True, help="Game that the movies were recorded with")
+    parser.add_argument("--user", help="User directory to copy into each temporary one")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count(), help="Parallel playbacks")
+    parser.add_argument("--timeout", type=int, help="Seconds after which a playback fails")
+    args = parser.parse_args()
+
+    failures = 0
+    with concurrent.futures.ThreadPoolExecutor(max_workers=args.jobs) as executor:
+        futures = [executor.submit(verify, args, movie) for movie in args.movies]
+        for future in concurrent.futures.as_completed(futures):
+            movie, success, status = future.result()
+            if not success:
+                failures += 1
+            print(f"{'PASS' if success else 'FAIL'} {movie}: {status}", flush=True)
+
+    print(f"\n{len(args.movies) - failures} of {len(args.movies)} movies passed")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())